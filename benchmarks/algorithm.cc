@@ -0,0 +1,142 @@
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "stx/algorithm.h"
+
+using stx::Option, stx::Result, stx::Span, stx::Some, stx::None, stx::Ok,
+    stx::Err;
+
+enum class Error { Invalid };
+
+constexpr size_t kRows = 1'000'000;
+
+// `errors`: every row is `Ok`, or 50% random `Err`s
+std::vector<Result<int64_t, Error>> make_rows(bool errors) {
+  std::mt19937 generator{42};
+  std::vector<Result<int64_t, Error>> rows;
+  rows.reserve(kRows);
+  for (size_t i = 0; i < kRows; i++) {
+    if (errors && (generator() & 1)) {
+      rows.push_back(Err(Error::Invalid));
+    } else {
+      rows.push_back(Ok(static_cast<int64_t>(i)));
+    }
+  }
+  return rows;
+}
+
+std::vector<Option<int64_t>> make_samples() {
+  std::mt19937 generator{42};
+  std::vector<Option<int64_t>> samples;
+  samples.reserve(kRows);
+  for (size_t i = 0; i < kRows; i++) {
+    if (generator() & 1) {
+      samples.push_back(Some(static_cast<int64_t>(i)));
+    } else {
+      samples.push_back(None);
+    }
+  }
+  return samples;
+}
+
+void TryCollect_HandWritten(benchmark::State& state) noexcept {  // NOLINT
+  auto const rows = make_rows(false);
+  std::vector<int64_t> values(kRows);
+  for (auto _ : state) {
+    bool failed = false;
+    for (size_t i = 0; i < rows.size(); i++) {
+      if (rows[i].is_err()) {
+        failed = true;
+        break;
+      }
+      values[i] = rows[i].value();
+    }
+    benchmark::DoNotOptimize(failed);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kRows));
+}
+
+void TryCollect_Stx(benchmark::State& state) noexcept {  // NOLINT
+  auto const rows = make_rows(false);
+  std::vector<int64_t> values(kRows);
+  for (auto _ : state) {
+    auto collected = stx::try_collect(
+        Span<Result<int64_t, Error> const>(rows), Span<int64_t>(values));
+    benchmark::DoNotOptimize(collected);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kRows));
+}
+
+void Partition_HandWritten(benchmark::State& state) noexcept {  // NOLINT
+  auto const rows = make_rows(true);
+  std::vector<int64_t> values(kRows);
+  std::vector<Error> errors(kRows);
+  for (auto _ : state) {
+    size_t num_ok = 0;
+    size_t num_err = 0;
+    for (auto const& row : rows) {
+      if (row.is_ok()) {
+        values[num_ok++] = row.value();
+      } else {
+        errors[num_err++] = row.err_value();
+      }
+    }
+    benchmark::DoNotOptimize(num_ok);
+    benchmark::DoNotOptimize(num_err);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kRows));
+}
+
+void Partition_Stx(benchmark::State& state) noexcept {  // NOLINT
+  auto const rows = make_rows(true);
+  std::vector<int64_t> values(kRows);
+  std::vector<Error> errors(kRows);
+  for (auto _ : state) {
+    auto partitioned = stx::partition_results(
+        Span<Result<int64_t, Error> const>(rows), Span<int64_t>(values),
+        Span<Error>(errors));
+    benchmark::DoNotOptimize(partitioned);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kRows));
+}
+
+void Flatten_HandWritten(benchmark::State& state) noexcept {  // NOLINT
+  auto const samples = make_samples();
+  std::vector<int64_t> values(kRows);
+  for (auto _ : state) {
+    size_t count = 0;
+    for (auto const& sample : samples) {
+      if (sample.is_some()) values[count++] = sample.value();
+    }
+    benchmark::DoNotOptimize(count);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kRows));
+}
+
+void Flatten_Stx(benchmark::State& state) noexcept {  // NOLINT
+  auto const samples = make_samples();
+  std::vector<int64_t> values(kRows);
+  for (auto _ : state) {
+    auto present =
+        stx::flatten(Span<Option<int64_t> const>(samples),
+                     Span<int64_t>(values));
+    benchmark::DoNotOptimize(present);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kRows));
+}
+
+BENCHMARK(TryCollect_HandWritten)->Unit(benchmark::kMicrosecond);
+BENCHMARK(TryCollect_Stx)->Unit(benchmark::kMicrosecond);
+BENCHMARK(Partition_HandWritten)->Unit(benchmark::kMicrosecond);
+BENCHMARK(Partition_Stx)->Unit(benchmark::kMicrosecond);
+BENCHMARK(Flatten_HandWritten)->Unit(benchmark::kMicrosecond);
+BENCHMARK(Flatten_Stx)->Unit(benchmark::kMicrosecond);
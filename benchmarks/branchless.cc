@@ -0,0 +1,100 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "stx/option.h"
+#include "stx/result.h"
+
+using stx::Option, stx::Some, stx::None, stx::Result, stx::Ok, stx::Err;
+
+enum class Error { Invalid };
+
+constexpr size_t kElements = 4096;
+
+// `state.range(0)` percent of the elements hold a value, at random positions
+template <typename T, typename Make>
+std::vector<T> make_elements(benchmark::State& state, Make make) {
+  std::mt19937 generator{42};
+  std::uniform_int_distribution<int64_t> percent{0, 99};
+  std::vector<T> elements;
+  elements.reserve(kElements);
+  for (size_t i = 0; i < kElements; i++) {
+    elements.push_back(make(percent(generator) < state.range(0),
+                            static_cast<int64_t>(i)));
+  }
+  return elements;
+}
+
+Option<int64_t> make_option(bool present, int64_t value) {
+  if (present) return Some(static_cast<int64_t>(value));
+  return None;
+}
+
+Result<int64_t, Error> make_result(bool present, int64_t value) {
+  if (present) return Ok(static_cast<int64_t>(value));
+  return Err(Error::Invalid);
+}
+
+template <typename T, typename Make, typename Unwrap>
+void run(benchmark::State& state, Make make, Unwrap unwrap) noexcept {
+  static_assert(std::is_trivially_copyable_v<T>);
+  std::vector<T> const elements = make_elements<T>(state, make);
+
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (T const& element : elements) {
+      // `clone()` branches on the variant state, the payloads are trivially
+      // copyable so the bytes are copied instead
+      alignas(T) unsigned char copy[sizeof(T)];
+      std::memcpy(copy, &element, sizeof(T));
+      sum += unwrap(std::move(*std::launder(reinterpret_cast<T*>(copy))));
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(kElements));
+}
+
+// what `unwrap_or` did before selecting without branching
+template <typename T>
+int64_t unwrap_or_branch(T&& element) noexcept {
+  return std::move(element).unwrap_or_else(
+      [](auto&&...) { return int64_t{-1}; });
+}
+
+template <typename T>
+int64_t unwrap_or_select(T&& element) noexcept {
+  return std::move(element).unwrap_or(int64_t{-1});
+}
+
+// Arg(n): n percent of the elements hold a value
+void Option_UnwrapOr_Branch(benchmark::State& state) noexcept {  // NOLINT
+  run<Option<int64_t>>(state, make_option,
+                       unwrap_or_branch<Option<int64_t>>);
+}
+
+void Option_UnwrapOr_Select(benchmark::State& state) noexcept {  // NOLINT
+  run<Option<int64_t>>(state, make_option,
+                       unwrap_or_select<Option<int64_t>>);
+}
+
+void Result_UnwrapOr_Branch(benchmark::State& state) noexcept {  // NOLINT
+  run<Result<int64_t, Error>>(state, make_result,
+                              unwrap_or_branch<Result<int64_t, Error>>);
+}
+
+void Result_UnwrapOr_Select(benchmark::State& state) noexcept {  // NOLINT
+  run<Result<int64_t, Error>>(state, make_result,
+                              unwrap_or_select<Result<int64_t, Error>>);
+}
+
+BENCHMARK(Option_UnwrapOr_Branch)->Arg(50)->Arg(90)->Arg(100);
+BENCHMARK(Option_UnwrapOr_Select)->Arg(50)->Arg(90)->Arg(100);
+BENCHMARK(Result_UnwrapOr_Branch)->Arg(50)->Arg(90)->Arg(100);
+BENCHMARK(Result_UnwrapOr_Select)->Arg(50)->Arg(90)->Arg(100);
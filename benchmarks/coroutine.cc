@@ -0,0 +1,80 @@
+#include <cstdint>
+#include <utility>
+
+#include "benchmark/benchmark.h"
+#include "stx/coroutine.h"
+
+using stx::Result, stx::Ok, stx::Err;
+
+enum class Error { Invalid };
+
+// counts the frame allocations that the compiler did not elide
+static int64_t frames = 0;
+
+void* counting_allocate(size_t size) {
+  frames++;
+  return stx::arena_coroutine_frame_allocator.allocate(size);
+}
+
+void counting_deallocate(void* frame, size_t size) noexcept {
+  stx::arena_coroutine_frame_allocator.deallocate(frame, size);
+}
+
+[[gnu::noinline]] Result<int64_t, Error> leaf(int64_t value) noexcept {
+  if (value < 0) return Err(Error::Invalid);
+  return Ok(std::move(value));
+}
+
+template <int Depth>
+Result<int64_t, Error> chain_try(int64_t value) noexcept {
+  if constexpr (Depth == 1) {
+    return leaf(value);
+  } else {
+    TRY_OK(x, chain_try<Depth - 1>(value));
+    return Ok(x + 1);
+  }
+}
+
+template <int Depth>
+Result<int64_t, Error> chain_co_await(int64_t value) noexcept {
+  if constexpr (Depth == 1) {
+    co_return co_await leaf(value);
+  } else {
+    co_return co_await chain_co_await<Depth - 1>(value) + 1;
+  }
+}
+
+template <Result<int64_t, Error> (*Chain)(int64_t)>
+void run(benchmark::State& state) noexcept {
+  auto previous = stx::set_coroutine_frame_allocator(
+      stx::CoroutineFrameAllocator{counting_allocate, counting_deallocate});
+  // a negative value fails at the innermost level and propagates the error
+  int64_t value = state.range(0);
+  frames = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(value);
+    auto result = Chain(value);
+    benchmark::DoNotOptimize(&result);
+  }
+  state.counters["frames/op"] = benchmark::Counter(
+      static_cast<double>(frames), benchmark::Counter::kAvgIterations);
+  stx::set_coroutine_frame_allocator(previous);
+}
+
+template <int Depth>
+void Try_Chain(benchmark::State& state) noexcept {  // NOLINT
+  run<chain_try<Depth>>(state);
+}
+
+template <int Depth>
+void CoAwait_Chain(benchmark::State& state) noexcept {  // NOLINT
+  run<chain_co_await<Depth>>(state);
+}
+
+// Arg(1): success path, Arg(-1): failure path
+BENCHMARK_TEMPLATE(Try_Chain, 1)->Arg(1)->Arg(-1);
+BENCHMARK_TEMPLATE(CoAwait_Chain, 1)->Arg(1)->Arg(-1);
+BENCHMARK_TEMPLATE(Try_Chain, 4)->Arg(1)->Arg(-1);
+BENCHMARK_TEMPLATE(CoAwait_Chain, 4)->Arg(1)->Arg(-1);
+BENCHMARK_TEMPLATE(Try_Chain, 16)->Arg(1)->Arg(-1);
+BENCHMARK_TEMPLATE(CoAwait_Chain, 16)->Arg(1)->Arg(-1);
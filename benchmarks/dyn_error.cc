@@ -0,0 +1,83 @@
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <utility>
+
+#include "benchmark/benchmark.h"
+#include "stx/dyn_error.h"
+
+using stx::Result, stx::Ok, stx::Err, stx::DynError;
+
+enum class IoError { Closed };
+
+stx::SpanReport operator>>(stx::ReportQuery, IoError const&) noexcept {
+  return stx::SpanReport("connection closed");
+}
+
+struct IoException : std::exception {
+  char const* what() const noexcept override { return "connection closed"; }
+};
+
+// the error is created at the innermost level and propagated to the caller
+
+[[gnu::noinline]] Result<int64_t, DynError> dyn_error_leaf(
+    int64_t value) noexcept {
+  if (value < 0) return Err(IoError::Closed);
+  return Ok(std::move(value));
+}
+
+[[gnu::noinline]] Result<int64_t, std::unique_ptr<std::exception>>
+unique_ptr_leaf(int64_t value) noexcept {
+  if (value < 0) return Err(std::unique_ptr<std::exception>(new IoException{}));
+  return Ok(std::move(value));
+}
+
+template <int Depth>
+[[gnu::noinline]] Result<int64_t, DynError> dyn_error_chain(
+    int64_t value) noexcept {
+  if constexpr (Depth == 1) {
+    return dyn_error_leaf(value);
+  } else {
+    TRY_OK(x, dyn_error_chain<Depth - 1>(value));
+    return Ok(x + 1);
+  }
+}
+
+template <int Depth>
+[[gnu::noinline]] Result<int64_t, std::unique_ptr<std::exception>>
+unique_ptr_chain(int64_t value) noexcept {
+  if constexpr (Depth == 1) {
+    return unique_ptr_leaf(value);
+  } else {
+    TRY_OK(x, unique_ptr_chain<Depth - 1>(value));
+    return Ok(x + 1);
+  }
+}
+
+template <int Depth>
+void DynError_Chain(benchmark::State& state) noexcept {  // NOLINT
+  int64_t value = state.range(0);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(value);
+    dyn_error_chain<Depth>(value).match(
+        [](auto x) { benchmark::DoNotOptimize(x); },
+        [](auto error) { benchmark::DoNotOptimize(&error); });
+  }
+}
+
+template <int Depth>
+void UniquePtrException_Chain(benchmark::State& state) noexcept {  // NOLINT
+  int64_t value = state.range(0);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(value);
+    unique_ptr_chain<Depth>(value).match(
+        [](auto x) { benchmark::DoNotOptimize(x); },
+        [](auto error) { benchmark::DoNotOptimize(error.get()); });
+  }
+}
+
+// Arg(1): success path, Arg(-1): failure path
+BENCHMARK_TEMPLATE(DynError_Chain, 1)->Arg(1)->Arg(-1);
+BENCHMARK_TEMPLATE(UniquePtrException_Chain, 1)->Arg(1)->Arg(-1);
+BENCHMARK_TEMPLATE(DynError_Chain, 4)->Arg(1)->Arg(-1);
+BENCHMARK_TEMPLATE(UniquePtrException_Chain, 4)->Arg(1)->Arg(-1);
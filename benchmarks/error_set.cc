@@ -0,0 +1,78 @@
+#include <cstdint>
+#include <utility>
+
+#include "benchmark/benchmark.h"
+#include "stx/error_set.h"
+
+using stx::Result, stx::Ok, stx::Err, stx::ErrorSet;
+
+enum class IoError : uint8_t { Closed, TimedOut };
+enum class ParseError : uint8_t { Truncated, BadChecksum };
+
+// a hand-written error enum flattening the errors of both layers
+enum class FlatError : uint8_t { Closed, TimedOut, Truncated, BadChecksum };
+
+[[gnu::noinline]] Result<int64_t, IoError> read(int64_t fd) noexcept {
+  if (fd < 0) return Err(IoError::TimedOut);
+  return Ok(std::move(fd));
+}
+
+[[gnu::noinline]] Result<int64_t, ParseError> parse(int64_t frame) noexcept {
+  if (frame == 0) return Err(ParseError::BadChecksum);
+  return Ok(frame * 2);
+}
+
+FlatError flatten_io(IoError error) noexcept {
+  return error == IoError::Closed ? FlatError::Closed : FlatError::TimedOut;
+}
+
+FlatError flatten_parse(ParseError error) noexcept {
+  return error == ParseError::Truncated ? FlatError::Truncated
+                                        : FlatError::BadChecksum;
+}
+
+[[gnu::noinline]] Result<int64_t, FlatError> receive_map_err(
+    int64_t fd) noexcept {
+  TRY_OK(frame, read(fd).map_err(flatten_io));
+  TRY_OK(message, parse(frame).map_err(flatten_parse));
+  return Ok(std::move(message));
+}
+
+[[gnu::noinline]] Result<int64_t, ErrorSet<IoError, ParseError>>
+receive_error_set(int64_t fd) noexcept {
+  TRY_OK(frame, read(fd));
+  TRY_OK(message, parse(frame));
+  return Ok(std::move(message));
+}
+
+void MapErr(benchmark::State& state) noexcept {  // NOLINT
+  int64_t fd = state.range(0);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fd);
+    receive_map_err(fd).match(
+        [](int64_t message) { benchmark::DoNotOptimize(message); },
+        [](FlatError error) {
+          bool retry = error == FlatError::TimedOut;
+          benchmark::DoNotOptimize(retry);
+        });
+  }
+}
+
+void ErrorSet_Widening(benchmark::State& state) noexcept {  // NOLINT
+  int64_t fd = state.range(0);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fd);
+    receive_error_set(fd).match(
+        [](int64_t message) { benchmark::DoNotOptimize(message); },
+        [](ErrorSet<IoError, ParseError> error) {
+          bool retry = std::move(error).match(
+              [](IoError io) { return io == IoError::TimedOut; },
+              [](ParseError) { return false; });
+          benchmark::DoNotOptimize(retry);
+        });
+  }
+}
+
+// Arg(1): success path, Arg(-1): I/O failure, Arg(0): parse failure
+BENCHMARK(MapErr)->Arg(1)->Arg(-1)->Arg(0);
+BENCHMARK(ErrorSet_Widening)->Arg(1)->Arg(-1)->Arg(0);
@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#include "benchmark/benchmark.h"
+#include "stx/executor.h"
+
+// number of tasks per iteration
+constexpr int64_t kTasks = 4'096;
+
+// number of tasks each forking task submits from its worker
+constexpr int64_t kFanOut = 64;
+
+// busy-waits for `duration`, a task of a fixed granularity
+void spin(std::chrono::nanoseconds duration) noexcept {
+  auto const deadline = std::chrono::steady_clock::now() + duration;
+  while (std::chrono::steady_clock::now() < deadline) {
+  }
+}
+
+// Arg(g): tasks of g microseconds, run by the calling thread
+void Spin_Serial(benchmark::State& state) noexcept {  // NOLINT
+  std::chrono::microseconds const granularity{state.range(0)};
+  for (auto _ : state) {
+    for (int64_t i = 0; i < kTasks; i++) spin(granularity);
+  }
+  state.SetItemsProcessed(state.iterations() * kTasks);
+}
+
+// Args(g, n): tasks of g microseconds submitted by the calling thread to `n`
+// workers through the injection queue
+void Spin_Submit(benchmark::State& state) noexcept {  // NOLINT
+  std::chrono::microseconds const granularity{state.range(0)};
+  stx::Executor executor{static_cast<size_t>(state.range(1))};
+  for (auto _ : state) {
+    for (int64_t i = 0; i < kTasks; i++) {
+      auto handle =
+          executor.submit("spin", [granularity] { spin(granularity); });
+      if (handle.is_err()) spin(granularity);
+    }
+    executor.wait_idle();
+  }
+  state.SetItemsProcessed(state.iterations() * kTasks);
+}
+
+// Args(g, n): tasks of g microseconds forked by tasks running on `n` workers,
+// through the workers' deques and stealing
+void Spin_Fork(benchmark::State& state) noexcept {  // NOLINT
+  std::chrono::microseconds const granularity{state.range(0)};
+  stx::Executor executor{static_cast<size_t>(state.range(1))};
+  for (auto _ : state) {
+    for (int64_t i = 0; i < kTasks / kFanOut; i++) {
+      auto fork = [&executor, granularity] {
+        for (int64_t j = 0; j < kFanOut; j++) {
+          auto handle =
+              executor.submit("spin", [granularity] { spin(granularity); });
+          if (handle.is_err()) spin(granularity);
+        }
+      };
+      if (executor.submit("fork", fork).is_err()) fork();
+    }
+    executor.wait_idle();
+  }
+  state.SetItemsProcessed(state.iterations() * kTasks);
+}
+
+void granularities_and_workers(benchmark::internal::Benchmark* bench) {
+  int64_t const max_workers =
+      std::max<int64_t>(std::thread::hardware_concurrency(), 1);
+  for (int64_t granularity : {1, 10}) {
+    for (int64_t workers = 1; workers <= max_workers; workers++) {
+      bench->Args({granularity, workers});
+    }
+  }
+}
+
+BENCHMARK(Spin_Serial)
+    ->Arg(1)
+    ->Arg(10)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+BENCHMARK(Spin_Submit)
+    ->Apply(granularities_and_workers)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+BENCHMARK(Spin_Fork)
+    ->Apply(granularities_and_workers)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
@@ -0,0 +1,97 @@
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "stx/future.h"
+
+using stx::Result, stx::Ok, stx::FutureError, stx::FutureSlot;
+
+// number of round trips between the two threads per iteration
+constexpr size_t kRounds = 1'000;
+
+// the main thread fulfills `ping[i]`, the responder waits for it and fulfills
+// `pong[i]`, which the main thread waits for
+void Handoff_StdFuture(benchmark::State& state) noexcept {  // NOLINT
+  for (auto _ : state) {
+    std::vector<std::promise<int64_t>> ping(kRounds);
+    std::vector<std::promise<int64_t>> pong(kRounds);
+    std::vector<std::future<int64_t>> ping_futures;
+    std::vector<std::future<int64_t>> pong_futures;
+    for (size_t i = 0; i < kRounds; i++) {
+      ping_futures.push_back(ping[i].get_future());
+      pong_futures.push_back(pong[i].get_future());
+    }
+
+    std::thread responder{[&] {
+      for (size_t i = 0; i < kRounds; i++) {
+        pong[i].set_value(ping_futures[i].get() + 1);
+      }
+    }};
+    int64_t sum = 0;
+    for (size_t i = 0; i < kRounds; i++) {
+      ping[i].set_value(static_cast<int64_t>(i));
+      sum += pong_futures[i].get();
+    }
+    responder.join();
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kRounds));
+}
+
+void Handoff_StxFuture(benchmark::State& state) noexcept {  // NOLINT
+  for (auto _ : state) {
+    std::vector<FutureSlot<int64_t, FutureError>> ping(kRounds);
+    std::vector<FutureSlot<int64_t, FutureError>> pong(kRounds);
+    std::vector<stx::FuturePair<int64_t, FutureError>> ping_ends;
+    std::vector<stx::FuturePair<int64_t, FutureError>> pong_ends;
+    ping_ends.reserve(kRounds);
+    pong_ends.reserve(kRounds);
+    for (size_t i = 0; i < kRounds; i++) {
+      ping_ends.push_back(stx::make_future(ping[i]));
+      pong_ends.push_back(stx::make_future(pong[i]));
+    }
+
+    std::thread responder{[&] {
+      for (size_t i = 0; i < kRounds; i++) {
+        int64_t const value = std::move(ping_ends[i].future).get().unwrap();
+        std::move(pong_ends[i].promise).fulfill(Ok(value + 1));
+      }
+    }};
+    int64_t sum = 0;
+    for (size_t i = 0; i < kRounds; i++) {
+      std::move(ping_ends[i].promise).fulfill(Ok(static_cast<int64_t>(i)));
+      sum += std::move(pong_ends[i].future).get().unwrap();
+    }
+    responder.join();
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kRounds));
+}
+
+// fulfilling and taking the result on the same thread, measures the cost of
+// the shared state alone
+void SameThread_StdFuture(benchmark::State& state) noexcept {  // NOLINT
+  for (auto _ : state) {
+    std::promise<int64_t> promise;
+    std::future<int64_t> future = promise.get_future();
+    promise.set_value(1);
+    benchmark::DoNotOptimize(future.get());
+  }
+}
+
+void SameThread_StxFuture(benchmark::State& state) noexcept {  // NOLINT
+  FutureSlot<int64_t, FutureError> slot;
+  for (auto _ : state) {
+    auto [promise, future] = stx::make_future(slot);
+    std::move(promise).fulfill(Ok(int64_t{1}));
+    benchmark::DoNotOptimize(std::move(future).get());
+  }
+}
+
+BENCHMARK(Handoff_StdFuture)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(Handoff_StxFuture)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(SameThread_StdFuture);
+BENCHMARK(SameThread_StxFuture);
@@ -0,0 +1,126 @@
+#include <array>
+#include <cstdint>
+#include <utility>
+
+#include "benchmark/benchmark.h"
+#include "stx/option.h"
+#include "stx/result.h"
+
+using stx::Option, stx::Result, stx::Some, stx::Ok;
+
+enum class Error { Invalid };
+
+// counts the move constructions of every `Payload`
+static int64_t moves = 0;
+
+// a 4 KiB payload, i.e. a fixed-size I/O buffer
+struct Payload {
+  explicit Payload(uint8_t seed) noexcept { bytes.fill(seed); }
+
+  Payload(Payload&& other) noexcept : bytes{other.bytes} { moves++; }
+
+  Payload& operator=(Payload&& other) noexcept {
+    bytes = other.bytes;
+    return *this;
+  }
+
+  std::array<uint8_t, 4096> bytes;
+};
+
+static_assert(sizeof(Payload) == 4096);
+
+// a payload that can't be moved at all, only constructed in-place
+struct PinnedPayload {
+  explicit PinnedPayload(uint8_t seed) noexcept { bytes.fill(seed); }
+
+  PinnedPayload(PinnedPayload&&) = delete;
+  PinnedPayload& operator=(PinnedPayload&&) = delete;
+
+  std::array<uint8_t, 4096> bytes;
+};
+
+[[gnu::noinline]] Option<Payload> some_moved(uint8_t seed) noexcept {
+  return Some(Payload{seed});
+}
+
+[[gnu::noinline]] Option<Payload> some_in_place(uint8_t seed) noexcept {
+  return stx::make_some_in_place<Payload>(seed);
+}
+
+[[gnu::noinline]] Option<PinnedPayload> some_pinned(uint8_t seed) noexcept {
+  return stx::make_some_in_place<PinnedPayload>(seed);
+}
+
+[[gnu::noinline]] Result<Payload, Error> ok_moved(uint8_t seed) noexcept {
+  return Ok(Payload{seed});
+}
+
+[[gnu::noinline]] Result<Payload, Error> ok_in_place(uint8_t seed) noexcept {
+  return stx::make_ok_in_place<Payload, Error>(seed);
+}
+
+template <typename Fn>
+void run(benchmark::State& state, Fn&& fn) noexcept {
+  moves = 0;
+  uint8_t seed = 0;
+  for (auto _ : state) {
+    auto result = fn(seed++);
+    benchmark::DoNotOptimize(&result);
+  }
+  state.counters["moves/op"] = benchmark::Counter(
+      static_cast<double>(moves), benchmark::Counter::kAvgIterations);
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(sizeof(Payload)));
+}
+
+void Option_Moved(benchmark::State& state) noexcept {  // NOLINT
+  run(state, some_moved);
+}
+
+void Option_InPlace(benchmark::State& state) noexcept {  // NOLINT
+  run(state, some_in_place);
+}
+
+void Option_Pinned(benchmark::State& state) noexcept {  // NOLINT
+  run(state, some_pinned);
+}
+
+void Result_Moved(benchmark::State& state) noexcept {  // NOLINT
+  run(state, ok_moved);
+}
+
+void Result_InPlace(benchmark::State& state) noexcept {  // NOLINT
+  run(state, ok_in_place);
+}
+
+void Option_Emplace(benchmark::State& state) noexcept {  // NOLINT
+  moves = 0;
+  uint8_t seed = 0;
+  Option<Payload> option = stx::None;
+  for (auto _ : state) {
+    option.emplace(seed++);
+    benchmark::DoNotOptimize(&option);
+  }
+  state.counters["moves/op"] = benchmark::Counter(
+      static_cast<double>(moves), benchmark::Counter::kAvgIterations);
+}
+
+void Option_Assign(benchmark::State& state) noexcept {  // NOLINT
+  moves = 0;
+  uint8_t seed = 0;
+  Option<Payload> option = stx::None;
+  for (auto _ : state) {
+    option = Some(Payload{seed++});
+    benchmark::DoNotOptimize(&option);
+  }
+  state.counters["moves/op"] = benchmark::Counter(
+      static_cast<double>(moves), benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(Option_Moved);
+BENCHMARK(Option_InPlace);
+BENCHMARK(Option_Pinned);
+BENCHMARK(Result_Moved);
+BENCHMARK(Result_InPlace);
+BENCHMARK(Option_Emplace);
+BENCHMARK(Option_Assign);
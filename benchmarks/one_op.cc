@@ -1,10 +1,16 @@
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <system_error>
 #include <variant>
 
 #include "benchmark/benchmark.h"
+#include "stx/error_code.h"
 #include "stx/option.h"
 
-enum Error { ZeroDivision, NoError };
+enum Error { ZeroDivision, NotFound, NoError };
 
 using stx::Result, stx::Ok, stx::Err, stx::make_ok, stx::make_err;
 
@@ -33,6 +39,86 @@ Error c_style_divide(double num, double div, double* result) noexcept {
   return Error::NoError;
 }
 
+Result<void, Error> result_check_divisor(double denominator) noexcept {
+  if (denominator == 0.0) return Err(Error::ZeroDivision);
+  return Ok();
+}
+
+Error c_style_check_divisor(double denominator) noexcept {
+  if (denominator == 0.0) return Error::ZeroDivision;
+  return Error::NoError;
+}
+
+struct Entry {
+  size_t key;
+  double value;
+};
+
+static std::array<Entry, 16> const table{
+    {{0, 0.0},  {1, 1.0},   {2, 2.0},   {3, 3.0},   {4, 4.0},   {5, 5.0},
+     {6, 6.0},  {7, 7.0},   {8, 8.0},   {9, 9.0},   {10, 10.0}, {11, 11.0},
+     {12, 12.0}, {13, 13.0}, {14, 14.0}, {15, 15.0}}};
+
+// the discriminant is stored in the pointer's lowest bit, the `Result` is
+// returned in a single register
+static_assert(sizeof(Result<Entry const*, Error>) == sizeof(Entry const*));
+
+// the alignment of `void` is unknown, the `Result` stores a separate
+// discriminant and is returned in two registers
+static_assert(sizeof(Result<void const*, Error>) > sizeof(void const*));
+
+// the lookups are not inlined so the results go through the calling convention
+
+[[gnu::noinline]] std::variant<Entry const*, Error> variant_lookup(
+    size_t key) noexcept {
+  if (key >= table.size()) return Error::NotFound;
+  return &table[key];
+}
+
+[[gnu::noinline]] Result<Entry const*, Error> result_lookup(
+    size_t key) noexcept {
+  if (key >= table.size()) return Err(Error::NotFound);
+  return Ok(&table[key]);
+}
+
+[[gnu::noinline]] Result<void const*, Error> tagged_result_lookup(
+    size_t key) noexcept {
+  if (key >= table.size()) return Err(Error::NotFound);
+  return Ok(static_cast<void const*>(&table[key]));
+}
+
+[[gnu::noinline]] Error c_style_lookup(size_t key, Entry const** entry) noexcept {
+  if (key >= table.size()) return Error::NotFound;
+  *entry = &table[key];
+  return Error::NoError;
+}
+
+// the value is packed after the category pointer, the `Result` is returned in
+// two registers
+static_assert(sizeof(Result<int64_t, stx::ErrorCode>) == 2 * sizeof(void*));
+
+// the `Result` stores a separate discriminant and is returned in memory
+static_assert(sizeof(Result<int64_t, std::error_code>) > 2 * sizeof(void*));
+
+[[gnu::noinline]] Result<int64_t, Error> enum_key_of(size_t index) noexcept {
+  if (index >= table.size()) return Err(Error::NotFound);
+  return Ok(static_cast<int64_t>(table[index].key));
+}
+
+[[gnu::noinline]] Result<int64_t, std::error_code> std_error_code_key_of(
+    size_t index) noexcept {
+  if (index >= table.size())
+    return Err(std::make_error_code(std::errc::result_out_of_range));
+  return Ok(static_cast<int64_t>(table[index].key));
+}
+
+[[gnu::noinline]] Result<int64_t, stx::ErrorCode> error_code_key_of(
+    size_t index) noexcept {
+  if (index >= table.size())
+    return Err(stx::ErrorCode(stx::errno_category, ERANGE));
+  return Ok(static_cast<int64_t>(table[index].key));
+}
+
 void Variant_SuccessPath(benchmark::State& state) noexcept {  // NOLINT
   for (auto _ : state) {
     auto result = variant_divide(1.0, 0.5);
@@ -137,6 +223,210 @@ void CStyle_FailurePath(benchmark::State& state) noexcept {  // NOLINT
   }
 }
 
+void VoidResult_SuccessPath(benchmark::State& state) noexcept {  // NOLINT
+  for (auto _ : state) {
+    result_check_divisor(0.5).match([]() { benchmark::ClobberMemory(); },
+                                    [](auto err) {
+                                      if (err == Error::ZeroDivision) {
+                                        benchmark::DoNotOptimize(err);
+                                      }
+                                    });
+  }
+}
+
+void VoidCStyle_SuccessPath(benchmark::State& state) noexcept {  // NOLINT
+  for (auto _ : state) {
+    auto err = c_style_check_divisor(0.5);
+    if (err == Error::ZeroDivision) {
+      benchmark::DoNotOptimize(err);
+    } else {
+      benchmark::ClobberMemory();
+    }
+  }
+}
+
+void VoidResult_FailurePath(benchmark::State& state) noexcept {  // NOLINT
+  for (auto _ : state) {
+    result_check_divisor(0.0).match([]() { benchmark::ClobberMemory(); },
+                                    [](auto err) {
+                                      if (err == Error::ZeroDivision) {
+                                        benchmark::DoNotOptimize(err);
+                                      }
+                                    });
+  }
+}
+
+void VoidCStyle_FailurePath(benchmark::State& state) noexcept {  // NOLINT
+  for (auto _ : state) {
+    auto err = c_style_check_divisor(0.0);
+    if (err == Error::ZeroDivision) {
+      benchmark::DoNotOptimize(err);
+    } else {
+      benchmark::ClobberMemory();
+    }
+  }
+}
+
+void VariantLookup_SuccessPath(benchmark::State& state) noexcept {  // NOLINT
+  size_t key = 5;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(key);
+    auto result = variant_lookup(key);
+    if (std::holds_alternative<Entry const*>(result)) {
+      benchmark::DoNotOptimize(std::get<Entry const*>(result)->value);
+    } else {
+      benchmark::DoNotOptimize(std::get<Error>(result));
+    }
+  }
+}
+
+void ResultLookup_SuccessPath(benchmark::State& state) noexcept {  // NOLINT
+  size_t key = 5;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(key);
+    result_lookup(key).match(
+        [](auto entry) { benchmark::DoNotOptimize(entry->value); },
+        [](auto err) { benchmark::DoNotOptimize(err); });
+  }
+}
+
+void TaggedResultLookup_SuccessPath(  // NOLINT
+    benchmark::State& state) noexcept {
+  size_t key = 5;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(key);
+    tagged_result_lookup(key).match(
+        [](auto entry) {
+          benchmark::DoNotOptimize(static_cast<Entry const*>(entry)->value);
+        },
+        [](auto err) { benchmark::DoNotOptimize(err); });
+  }
+}
+
+void CStyleLookup_SuccessPath(benchmark::State& state) noexcept {  // NOLINT
+  size_t key = 5;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(key);
+    Entry const* entry;
+    auto err = c_style_lookup(key, &entry);
+    if (err == Error::NotFound) {
+      benchmark::DoNotOptimize(err);
+    } else {
+      benchmark::DoNotOptimize(entry->value);
+    }
+  }
+}
+
+void VariantLookup_FailurePath(benchmark::State& state) noexcept {  // NOLINT
+  size_t key = 16;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(key);
+    auto result = variant_lookup(key);
+    if (std::holds_alternative<Entry const*>(result)) {
+      benchmark::DoNotOptimize(std::get<Entry const*>(result)->value);
+    } else {
+      benchmark::DoNotOptimize(std::get<Error>(result));
+    }
+  }
+}
+
+void ResultLookup_FailurePath(benchmark::State& state) noexcept {  // NOLINT
+  size_t key = 16;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(key);
+    result_lookup(key).match(
+        [](auto entry) { benchmark::DoNotOptimize(entry->value); },
+        [](auto err) { benchmark::DoNotOptimize(err); });
+  }
+}
+
+void TaggedResultLookup_FailurePath(  // NOLINT
+    benchmark::State& state) noexcept {
+  size_t key = 16;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(key);
+    tagged_result_lookup(key).match(
+        [](auto entry) {
+          benchmark::DoNotOptimize(static_cast<Entry const*>(entry)->value);
+        },
+        [](auto err) { benchmark::DoNotOptimize(err); });
+  }
+}
+
+void CStyleLookup_FailurePath(benchmark::State& state) noexcept {  // NOLINT
+  size_t key = 16;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(key);
+    Entry const* entry;
+    auto err = c_style_lookup(key, &entry);
+    if (err == Error::NotFound) {
+      benchmark::DoNotOptimize(err);
+    } else {
+      benchmark::DoNotOptimize(entry->value);
+    }
+  }
+}
+
+void EnumError_SuccessPath(benchmark::State& state) noexcept {  // NOLINT
+  size_t index = 5;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(index);
+    enum_key_of(index).match(
+        [](auto key) { benchmark::DoNotOptimize(key); },
+        [](auto err) { benchmark::DoNotOptimize(err); });
+  }
+}
+
+void StdErrorCode_SuccessPath(benchmark::State& state) noexcept {  // NOLINT
+  size_t index = 5;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(index);
+    std_error_code_key_of(index).match(
+        [](auto key) { benchmark::DoNotOptimize(key); },
+        [](auto err) { benchmark::DoNotOptimize(err); });
+  }
+}
+
+void ErrorCode_SuccessPath(benchmark::State& state) noexcept {  // NOLINT
+  size_t index = 5;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(index);
+    error_code_key_of(index).match(
+        [](auto key) { benchmark::DoNotOptimize(key); },
+        [](auto err) { benchmark::DoNotOptimize(err); });
+  }
+}
+
+void EnumError_FailurePath(benchmark::State& state) noexcept {  // NOLINT
+  size_t index = 16;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(index);
+    enum_key_of(index).match(
+        [](auto key) { benchmark::DoNotOptimize(key); },
+        [](auto err) { benchmark::DoNotOptimize(err); });
+  }
+}
+
+void StdErrorCode_FailurePath(benchmark::State& state) noexcept {  // NOLINT
+  size_t index = 16;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(index);
+    std_error_code_key_of(index).match(
+        [](auto key) { benchmark::DoNotOptimize(key); },
+        [](auto err) { benchmark::DoNotOptimize(err); });
+  }
+}
+
+void ErrorCode_FailurePath(benchmark::State& state) noexcept {  // NOLINT
+  size_t index = 16;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(index);
+    error_code_key_of(index).match(
+        [](auto key) { benchmark::DoNotOptimize(key); },
+        [](auto err) { benchmark::DoNotOptimize(err); });
+  }
+}
+
 BENCHMARK(Variant_SuccessPath);
 BENCHMARK(Exception_SuccessPath);
 BENCHMARK(Result_SuccessPath);
@@ -146,3 +436,24 @@ BENCHMARK(Variant_FailurePath);
 BENCHMARK(Exception_FailurePath);
 BENCHMARK(Result_FailurePath);
 BENCHMARK(CStyle_FailurePath);
+
+BENCHMARK(VoidResult_SuccessPath);
+BENCHMARK(VoidCStyle_SuccessPath);
+BENCHMARK(VoidResult_FailurePath);
+BENCHMARK(VoidCStyle_FailurePath);
+
+BENCHMARK(VariantLookup_SuccessPath);
+BENCHMARK(ResultLookup_SuccessPath);
+BENCHMARK(TaggedResultLookup_SuccessPath);
+BENCHMARK(CStyleLookup_SuccessPath);
+BENCHMARK(VariantLookup_FailurePath);
+BENCHMARK(ResultLookup_FailurePath);
+BENCHMARK(TaggedResultLookup_FailurePath);
+BENCHMARK(CStyleLookup_FailurePath);
+
+BENCHMARK(EnumError_SuccessPath);
+BENCHMARK(StdErrorCode_SuccessPath);
+BENCHMARK(ErrorCode_SuccessPath);
+BENCHMARK(EnumError_FailurePath);
+BENCHMARK(StdErrorCode_FailurePath);
+BENCHMARK(ErrorCode_FailurePath);
@@ -0,0 +1,99 @@
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "stx/option.h"
+#include "stx/option_vec.h"
+
+using stx::Option, stx::OptionVec, stx::Some, stx::None;
+
+constexpr size_t kSamples = 1'000'000;
+
+// `state.range(0)` percent of the samples are present, at random positions
+template <typename Push>
+void make_samples(benchmark::State& state, Push push) {
+  std::mt19937 generator{42};
+  std::uniform_int_distribution<int64_t> percent{0, 99};
+  for (size_t i = 0; i < kSamples; i++) {
+    push(percent(generator) < state.range(0), static_cast<double>(i));
+  }
+}
+
+std::vector<Option<double>> make_vector(benchmark::State& state) {
+  std::vector<Option<double>> samples;
+  samples.reserve(kSamples);
+  make_samples(state, [&](bool present, double value) {
+    if (present) {
+      samples.push_back(Some(double{value}));
+    } else {
+      samples.push_back(None);
+    }
+  });
+  return samples;
+}
+
+OptionVec<double> make_option_vec(benchmark::State& state) {
+  OptionVec<double> samples;
+  samples.reserve(kSamples);
+  make_samples(state, [&](bool present, double value) {
+    if (present) {
+      samples.push_some(value);
+    } else {
+      samples.push_none();
+    }
+  });
+  return samples;
+}
+
+// Arg(n): n percent of the samples are present
+void Count_VectorOfOption(benchmark::State& state) noexcept {  // NOLINT
+  auto const samples = make_vector(state);
+  for (auto _ : state) {
+    size_t count = 0;
+    for (auto const& sample : samples) count += sample.is_some();
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kSamples));
+}
+
+void Count_OptionVec(benchmark::State& state) noexcept {  // NOLINT
+  auto const samples = make_option_vec(state);
+  for (auto _ : state) {
+    size_t count = samples.count_some();
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kSamples));
+}
+
+void Sum_VectorOfOption(benchmark::State& state) noexcept {  // NOLINT
+  auto const samples = make_vector(state);
+  for (auto _ : state) {
+    double sum = 0;
+    for (auto const& sample : samples) {
+      if (sample.is_some()) sum += sample.value();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kSamples));
+}
+
+void Sum_OptionVec(benchmark::State& state) noexcept {  // NOLINT
+  auto const samples = make_option_vec(state);
+  for (auto _ : state) {
+    double sum = 0;
+    samples.for_each_some([&](size_t, double value) { sum += value; });
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kSamples));
+}
+
+BENCHMARK(Count_VectorOfOption)->Arg(10)->Arg(50)->Arg(90)->Unit(
+    benchmark::kMicrosecond);
+BENCHMARK(Count_OptionVec)->Arg(10)->Arg(50)->Arg(90)->Unit(
+    benchmark::kMicrosecond);
+BENCHMARK(Sum_VectorOfOption)->Arg(10)->Arg(50)->Arg(90)->Unit(
+    benchmark::kMicrosecond);
+BENCHMARK(Sum_OptionVec)->Arg(10)->Arg(50)->Arg(90)->Unit(
+    benchmark::kMicrosecond);
@@ -0,0 +1,91 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "stx/parallel.h"
+
+using stx::Result, stx::Span, stx::Ok, stx::Err;
+
+enum class Error { Invalid };
+
+constexpr size_t kRows = 1'000'000;
+
+// a validation and a transform costing a few dozen nanoseconds per element
+Result<double, Error> validate(int64_t const& row) {
+  if (row < 0) return Err(Error::Invalid);
+  double value = static_cast<double>(row);
+  for (int i = 0; i < 8; i++) value = std::sqrt(value + 1.0);
+  return Ok(double{value});
+}
+
+std::vector<int64_t> make_rows() {
+  std::vector<int64_t> rows(kRows);
+  for (size_t i = 0; i < kRows; i++) rows[i] = static_cast<int64_t>(i);
+  return rows;
+}
+
+void TryTransform_Serial(benchmark::State& state) noexcept {  // NOLINT
+  auto const rows = make_rows();
+  std::vector<double> values(kRows);
+  for (auto _ : state) {
+    bool failed = false;
+    for (size_t i = 0; i < kRows; i++) {
+      auto result = validate(rows[i]);
+      if (result.is_err()) {
+        failed = true;
+        break;
+      }
+      values[i] = result.value();
+    }
+    benchmark::DoNotOptimize(failed);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kRows));
+}
+
+// Arg(n): n threads, including the calling thread
+void TryTransform_Parallel(benchmark::State& state) noexcept {  // NOLINT
+  stx::par::ThreadPool pool{static_cast<size_t>(state.range(0))};
+  auto const rows = make_rows();
+  std::vector<double> values(kRows);
+  for (auto _ : state) {
+    auto result = stx::par::try_transform(
+        pool, Span<int64_t const>(rows), Span<double>(values),
+        [](int64_t const& row) { return validate(row); });
+    benchmark::DoNotOptimize(result);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kRows));
+}
+
+// Arg(n): n threads, the first element fails and cancels the batch
+void TryTransform_EarlyErr(benchmark::State& state) noexcept {  // NOLINT
+  stx::par::ThreadPool pool{static_cast<size_t>(state.range(0))};
+  auto rows = make_rows();
+  rows[0] = -1;
+  std::vector<double> values(kRows);
+  for (auto _ : state) {
+    auto result = stx::par::try_transform(
+        pool, Span<int64_t const>(rows), Span<double>(values),
+        [](int64_t const& row) { return validate(row); });
+    benchmark::DoNotOptimize(result);
+    benchmark::ClobberMemory();
+  }
+}
+
+int64_t max_threads() {
+  return std::max<int64_t>(std::thread::hardware_concurrency(), 1);
+}
+
+BENCHMARK(TryTransform_Serial)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(TryTransform_Parallel)
+    ->DenseRange(1, max_threads())
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+BENCHMARK(TryTransform_EarlyErr)
+    ->DenseRange(1, max_threads())
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
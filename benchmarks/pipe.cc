@@ -0,0 +1,63 @@
+#include <string>
+#include <utility>
+
+#include "benchmark/benchmark.h"
+#include "stx/option.h"
+#include "stx/pipe.h"
+
+using stx::Option, stx::Some, stx::None;
+
+// longer than the small string buffer, moves transfer the heap buffer
+std::string const kPayload = "  a payload past the small string buffer  ";
+
+std::string trim(std::string&& s) {
+  size_t const first = s.find_first_not_of(' ');
+  size_t const last = s.find_last_not_of(' ');
+  s.erase(last + 1);
+  s.erase(0, first);
+  return std::move(s);
+}
+
+Option<std::string> non_empty(std::string&& s) {
+  if (s.empty()) return None;
+  return Some(std::move(s));
+}
+
+bool is_short(std::string const& s) { return s.size() < 64; }
+
+// the payload is moved back and forth between the input and the output, so
+// only the pipeline is measured rather than the string's allocation
+template <typename Pipeline>
+void run(benchmark::State& state, Pipeline pipeline) noexcept {
+  std::string payload = kPayload;
+  for (auto _ : state) {
+    Option<std::string> input = None;
+    if (state.range(0) == 1) input = Some(std::move(payload));
+    benchmark::DoNotOptimize(input);
+    std::string output = pipeline(std::move(input));
+    benchmark::DoNotOptimize(output);
+    if (state.range(0) == 1) payload = std::move(output);
+  }
+}
+
+// Arg(1): value present, Arg(0): None
+void Option_String_Eager(benchmark::State& state) noexcept {  // NOLINT
+  run(state, [](Option<std::string>&& input) {
+    return std::move(input)
+        .map(trim)
+        .and_then(non_empty)
+        .filter(is_short)
+        .unwrap_or(std::string{});
+  });
+}
+
+void Option_String_Lazy(benchmark::State& state) noexcept {  // NOLINT
+  run(state, [](Option<std::string>&& input) {
+    return stx::pipe(std::move(input)) | stx::lazy::map(trim) |
+           stx::lazy::and_then(non_empty) | stx::lazy::filter(is_short) |
+           stx::lazy::unwrap_or(std::string{});
+  });
+}
+
+BENCHMARK(Option_String_Eager)->Arg(1)->Arg(0);
+BENCHMARK(Option_String_Lazy)->Arg(1)->Arg(0);
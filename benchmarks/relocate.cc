@@ -0,0 +1,94 @@
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "stx/option.h"
+#include "stx/result.h"
+
+using stx::Option, stx::Some, stx::Result, stx::Ok, stx::Err;
+
+enum class Error { Invalid };
+
+constexpr size_t kElements = 10'000'000;
+
+// what the containers do for payloads that aren't trivially relocatable
+template <typename T>
+T* relocate_one_by_one(T* first, T* last, T* dest) noexcept {
+  for (; first != last; first++, dest++) {
+    new (static_cast<void*>(dest)) T(std::move(*first));
+    first->~T();
+  }
+  return dest;
+}
+
+template <typename T>
+T* allocate() noexcept {
+  return static_cast<T*>(std::malloc(kElements * sizeof(T)));
+}
+
+// relocates 10M elements into a new buffer, as a container growing past its
+// capacity does. The elements are moved back and forth between two buffers
+// allocated upfront, so the page faults of fresh allocations aren't measured.
+template <typename T, typename Make, typename Relocate>
+void run(benchmark::State& state, Make make, Relocate relocate) noexcept {
+  T* buffer = allocate<T>();
+  T* grown = allocate<T>();
+  std::memset(static_cast<void*>(grown), 0, kElements * sizeof(T));
+  for (size_t i = 0; i < kElements; i++) new (buffer + i) T(make(i));
+
+  for (auto _ : state) {
+    relocate(buffer, buffer + kElements, grown);
+    std::swap(buffer, grown);
+    benchmark::DoNotOptimize(buffer);
+    benchmark::ClobberMemory();
+  }
+
+  for (size_t i = 0; i < kElements; i++) buffer[i].~T();
+  std::free(buffer);
+  std::free(grown);
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(kElements * sizeof(T)));
+}
+
+using OptionPtr = Option<std::unique_ptr<int>>;
+using ResultVec = Result<std::vector<int>, Error>;
+
+static_assert(stx::trivially_relocatable<OptionPtr>);
+static_assert(stx::trivially_relocatable<ResultVec>);
+
+OptionPtr make_option(size_t i) noexcept {
+  if (i % 2 == 0) return stx::None;
+  return Some(std::unique_ptr<int>(nullptr));
+}
+
+ResultVec make_result(size_t i) noexcept {
+  if (i % 2 == 0) return Err(Error::Invalid);
+  return Ok(std::vector<int>{});
+}
+
+void OptionUniquePtr_OneByOne(benchmark::State& state) noexcept {  // NOLINT
+  run<OptionPtr>(state, make_option, relocate_one_by_one<OptionPtr>);
+}
+
+void OptionUniquePtr_Memcpy(benchmark::State& state) noexcept {  // NOLINT
+  run<OptionPtr>(state, make_option, stx::uninitialized_relocate<OptionPtr>);
+}
+
+void ResultVector_OneByOne(benchmark::State& state) noexcept {  // NOLINT
+  run<ResultVec>(state, make_result, relocate_one_by_one<ResultVec>);
+}
+
+void ResultVector_Memcpy(benchmark::State& state) noexcept {  // NOLINT
+  run<ResultVec>(state, make_result, stx::uninitialized_relocate<ResultVec>);
+}
+
+BENCHMARK(OptionUniquePtr_OneByOne)->Unit(benchmark::kMillisecond);
+BENCHMARK(OptionUniquePtr_Memcpy)->Unit(benchmark::kMillisecond);
+BENCHMARK(ResultVector_OneByOne)->Unit(benchmark::kMillisecond);
+BENCHMARK(ResultVector_Memcpy)->Unit(benchmark::kMillisecond);
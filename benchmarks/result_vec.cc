@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "stx/result.h"
+#include "stx/result_vec.h"
+
+using stx::Result, stx::ResultVec, stx::Ok, stx::Err;
+
+enum class Error { Invalid };
+
+// a validated row, the `Result<Row, Error>` is 40 bytes wide
+struct Row {
+  double x;
+  double y;
+  double z;
+  int64_t id;
+};
+
+constexpr size_t kRows = 1'000'000;
+
+// 1% of the rows are errors, at random positions. With `last_only`, only
+// the last row is an error.
+bool is_err(std::mt19937& generator, size_t index, bool last_only) {
+  if (last_only) return index == kRows - 1;
+  return std::uniform_int_distribution<int>{0, 99}(generator) == 0;
+}
+
+std::vector<Result<Row, Error>> make_aos(bool last_only) {
+  std::mt19937 generator{42};
+  std::vector<Result<Row, Error>> rows;
+  rows.reserve(kRows);
+  for (size_t i = 0; i < kRows; i++) {
+    if (is_err(generator, i, last_only)) {
+      rows.push_back(Err(Error::Invalid));
+    } else {
+      rows.push_back(Ok(Row{1.0, 2.0, 3.0, static_cast<int64_t>(i)}));
+    }
+  }
+  return rows;
+}
+
+ResultVec<Row, Error> make_soa(bool last_only) {
+  std::mt19937 generator{42};
+  ResultVec<Row, Error> rows;
+  rows.reserve(kRows);
+  for (size_t i = 0; i < kRows; i++) {
+    if (is_err(generator, i, last_only)) {
+      rows.push_err(Error::Invalid);
+    } else {
+      rows.push_ok(Row{1.0, 2.0, 3.0, static_cast<int64_t>(i)});
+    }
+  }
+  return rows;
+}
+
+void CountErr_VectorOfResult(benchmark::State& state) noexcept {  // NOLINT
+  auto const rows = make_aos(false);
+  for (auto _ : state) {
+    size_t count = static_cast<size_t>(
+        std::count_if(rows.begin(), rows.end(),
+                      [](auto const& row) { return row.is_err(); }));
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kRows));
+}
+
+void CountErr_ResultVec(benchmark::State& state) noexcept {  // NOLINT
+  auto const rows = make_soa(false);
+  for (auto _ : state) {
+    size_t count = rows.count_err();
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kRows));
+}
+
+void FirstErr_VectorOfResult(benchmark::State& state) noexcept {  // NOLINT
+  auto const rows = make_aos(true);
+  for (auto _ : state) {
+    auto first = std::find_if(rows.begin(), rows.end(),
+                              [](auto const& row) { return row.is_err(); });
+    benchmark::DoNotOptimize(first);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kRows));
+}
+
+void FirstErr_ResultVec(benchmark::State& state) noexcept {  // NOLINT
+  auto const rows = make_soa(true);
+  for (auto _ : state) {
+    auto first = rows.first_err();
+    benchmark::DoNotOptimize(first);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kRows));
+}
+
+BENCHMARK(CountErr_VectorOfResult)->Unit(benchmark::kMicrosecond);
+BENCHMARK(CountErr_ResultVec)->Unit(benchmark::kMicrosecond);
+BENCHMARK(FirstErr_VectorOfResult)->Unit(benchmark::kMicrosecond);
+BENCHMARK(FirstErr_ResultVec)->Unit(benchmark::kMicrosecond);
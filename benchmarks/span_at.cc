@@ -0,0 +1,66 @@
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "stx/span.h"
+
+using stx::Option, stx::Ref, stx::Span;
+
+// forces the `Option<Ref<T>>` through the calling convention, as it would be
+// across a translation unit boundary
+[[gnu::noinline]] Option<Ref<int64_t>> opaque_at(Span<int64_t> span,
+                                                  size_t index) noexcept {
+  return span.at(index);
+}
+
+std::vector<int64_t> make_data(benchmark::State& state) {
+  std::vector<int64_t> data(static_cast<size_t>(state.range(0)));
+  std::iota(data.begin(), data.end(), 0);
+  return data;
+}
+
+void Subscript_Sum(benchmark::State& state) noexcept {  // NOLINT
+  auto data = make_data(state);
+  Span<int64_t> span = data;
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (size_t i = 0; i < span.size(); i++) {
+      sum += span[i];
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void At_Sum(benchmark::State& state) noexcept {  // NOLINT
+  auto data = make_data(state);
+  Span<int64_t> span = data;
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (size_t i = 0; i < span.size(); i++) {
+      sum += span.at(i).map([](int64_t& v) { return v; }).unwrap_or(0);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void OutOfLineAt_Sum(benchmark::State& state) noexcept {  // NOLINT
+  auto data = make_data(state);
+  Span<int64_t> span = data;
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (size_t i = 0; i < span.size(); i++) {
+      auto element = opaque_at(span, i);
+      if (element.is_some()) sum += std::move(element).unwrap().get();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(Subscript_Sum)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(At_Sum)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(OutOfLineAt_Sum)->Arg(1 << 10)->Arg(1 << 16);
@@ -0,0 +1,88 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "benchmark/benchmark.h"
+#include "stx/task.h"
+
+using stx::Task, stx::Result, stx::Ok, stx::Err;
+
+enum class Error { Invalid };
+
+// counts the calls to the global `operator new`
+static int64_t allocations = 0;
+
+void* operator new(size_t size) {
+  allocations++;
+  if (void* memory = std::malloc(size == 0 ? 1 : size)) return memory;
+  throw std::bad_alloc{};
+}
+
+// out of line, so the compiler doesn't pair the `free` with a new-expression
+[[gnu::noinline]] void release(void* memory) noexcept { std::free(memory); }
+
+void operator delete(void* memory) noexcept { release(memory); }
+
+void operator delete(void* memory, size_t) noexcept { release(memory); }
+
+constexpr int64_t kTasks = 1'000'000;
+
+[[gnu::noinline]] Task<int64_t, Error> leaf(int64_t value) {
+  if (value < 0) co_return Err(Error::Invalid);
+  co_return value;
+}
+
+// awaits `kTasks` child tasks one after the other
+Task<int64_t, Error> sequence() {
+  int64_t sum = 0;
+  for (int64_t i = 0; i < kTasks; i++) sum += co_await leaf(i);
+  co_return sum;
+}
+
+// a chain of `depth` tasks, each awaiting the next one
+Task<int64_t, Error> chain(int64_t depth) {
+  if (depth == 0) co_return int64_t{0};
+  co_return co_await chain(depth - 1) + 1;
+}
+
+// ns per resume: each task is resumed once when awaited and resumes its
+// parent once when it completes
+void Task_Sequence(benchmark::State& state) noexcept {  // NOLINT
+  int64_t const before = allocations;
+  for (auto _ : state) {
+    auto result = sequence().run();
+    benchmark::DoNotOptimize(result);
+  }
+  state.counters["allocs_per_task"] = benchmark::Counter(
+      static_cast<double>(allocations - before) /
+      static_cast<double>(state.iterations() * kTasks));
+  state.counters["ns_per_resume"] = benchmark::Counter(
+      static_cast<double>(state.iterations() * kTasks * 2),
+      benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+// Arg(n): chains of n tasks, 1M tasks per iteration
+void Task_Chain(benchmark::State& state) noexcept {  // NOLINT
+  int64_t const depth = state.range(0);
+  int64_t const before = allocations;
+  for (auto _ : state) {
+    for (int64_t i = 0; i < kTasks / depth; i++) {
+      auto result = chain(depth - 1).run();
+      benchmark::DoNotOptimize(result);
+    }
+  }
+  state.counters["allocs_per_task"] = benchmark::Counter(
+      static_cast<double>(allocations - before) /
+      static_cast<double>(state.iterations() * kTasks));
+  state.counters["ns_per_resume"] = benchmark::Counter(
+      static_cast<double>(state.iterations() * kTasks * 2),
+      benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+BENCHMARK(Task_Sequence)->Unit(benchmark::kMillisecond);
+BENCHMARK(Task_Chain)
+    ->Arg(10)
+    ->Arg(1'000)
+    ->Arg(100'000)
+    ->Unit(benchmark::kMillisecond);
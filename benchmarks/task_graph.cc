@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "stx/task_graph.h"
+
+using stx::Result, stx::Ok, stx::Err, stx::TaskGraph;
+
+enum class Error { Invalid };
+
+// number of nodes of the synthetic graphs
+constexpr int64_t kNodes = 100'000;
+
+// a stage costing a few dozen nanoseconds
+Result<uint64_t, Error> stage(uint64_t const& input) {
+  uint64_t value = input;
+  for (int i = 0; i < 16; i++) value = value * 6364136223846793005U + 1;
+  return Ok(uint64_t{value});
+}
+
+Result<uint64_t, Error> source() { return Ok(uint64_t{1}); }
+
+// one root whose value is consumed by `kNodes - 1` independent leaves
+TaskGraph<Error> make_wide() {
+  TaskGraph<Error> graph;
+  auto root = graph.add("root", source);
+  for (int64_t i = 1; i < kNodes; i++) graph.add("leaf", stage, root);
+  return graph;
+}
+
+// a chain of `kNodes` nodes, each consuming the previous node's value
+TaskGraph<Error> make_deep() {
+  TaskGraph<Error> graph;
+  auto node = graph.add("root", source);
+  for (int64_t i = 1; i < kNodes; i++) node = graph.add("link", stage, node);
+  return graph;
+}
+
+// the stages called in a loop, without the graph
+void Stages_Serial(benchmark::State& state) noexcept {  // NOLINT
+  for (auto _ : state) {
+    uint64_t value = source().unwrap();
+    for (int64_t i = 1; i < kNodes; i++) value = stage(value).unwrap();
+    benchmark::DoNotOptimize(value);
+  }
+  state.SetItemsProcessed(state.iterations() * kNodes);
+}
+
+// Arg(n): the wide graph run on `n` workers
+void TaskGraph_Wide(benchmark::State& state) noexcept {  // NOLINT
+  stx::Executor executor{static_cast<size_t>(state.range(0)), kNodes};
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto graph = make_wide();
+    state.ResumeTiming();
+    auto report = graph.run(executor);
+    benchmark::DoNotOptimize(report);
+    state.PauseTiming();
+    graph = TaskGraph<Error>{};
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * kNodes);
+}
+
+// Arg(n): the deep graph run on `n` workers
+void TaskGraph_Deep(benchmark::State& state) noexcept {  // NOLINT
+  stx::Executor executor{static_cast<size_t>(state.range(0))};
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto graph = make_deep();
+    state.ResumeTiming();
+    auto report = graph.run(executor);
+    benchmark::DoNotOptimize(report);
+    state.PauseTiming();
+    graph = TaskGraph<Error>{};
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * kNodes);
+}
+
+// the wide and deep graphs built and torn down, not run
+void TaskGraph_Build(benchmark::State& state) noexcept {  // NOLINT
+  for (auto _ : state) {
+    auto wide = make_wide();
+    auto deep = make_deep();
+    benchmark::DoNotOptimize(wide);
+    benchmark::DoNotOptimize(deep);
+  }
+  state.SetItemsProcessed(state.iterations() * 2 * kNodes);
+}
+
+int64_t max_workers() {
+  return std::max<int64_t>(std::thread::hardware_concurrency(), 1);
+}
+
+BENCHMARK(Stages_Serial)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(TaskGraph_Wide)
+    ->DenseRange(1, max_workers())
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+BENCHMARK(TaskGraph_Deep)
+    ->DenseRange(1, max_workers())
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+BENCHMARK(TaskGraph_Build)->Unit(benchmark::kMicrosecond)->UseRealTime();
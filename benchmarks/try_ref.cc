@@ -0,0 +1,117 @@
+#include <array>
+#include <cstdint>
+#include <utility>
+
+#include "benchmark/benchmark.h"
+#include "stx/result.h"
+
+using stx::Result, stx::Ok, stx::Err;
+
+enum class Error { Invalid };
+
+// counts the move constructions of every `Message`
+static int64_t moves = 0;
+
+// a 1 KiB payload, i.e. a parsed message
+struct Message {
+  explicit Message(uint8_t seed) noexcept { bytes.fill(seed); }
+
+  Message(Message&& other) noexcept : bytes{other.bytes} { moves++; }
+
+  Message& operator=(Message&& other) noexcept {
+    bytes = other.bytes;
+    return *this;
+  }
+
+  std::array<uint8_t, 1024> bytes;
+};
+
+static_assert(sizeof(Message) == 1024);
+
+constexpr int kDepth = 8;
+
+[[gnu::noinline]] Result<Message, Error> parse(uint8_t seed) noexcept {
+  if (seed == 0) return Err(Error::Invalid);
+  return stx::make_ok_in_place<Message, Error>(seed);
+}
+
+// each level validates the message and propagates it to its caller
+
+template <int Level>
+[[gnu::noinline]] Result<Message, Error> chain_try(uint8_t seed) noexcept {
+  if constexpr (Level == 0) {
+    return parse(seed);
+  } else {
+    TRY_OK(message, chain_try<Level - 1>(seed));
+    message.bytes[Level]++;
+    return Ok(std::move(message));
+  }
+}
+
+template <int Level>
+[[gnu::noinline]] Result<Message, Error> chain_try_ref(uint8_t seed) noexcept {
+  if constexpr (Level == 0) {
+    return parse(seed);
+  } else {
+    TRY_OK_REF(message, chain_try_ref<Level - 1>(seed));
+    message.bytes[Level]++;
+    return Ok(std::move(message));
+  }
+}
+
+template <int Level>
+[[gnu::noinline]] Result<Message, Error> chain_try_ref_in_place(
+    uint8_t seed) noexcept {
+  if constexpr (Level == 0) {
+    return parse(seed);
+  } else {
+    TRY_OK_REF(message, chain_try_ref_in_place<Level - 1>(seed));
+    message.bytes[Level]++;
+    return stx::make_ok_in_place<Message, Error>(std::move(message));
+  }
+}
+
+template <int Level>
+[[gnu::noinline]] Result<Message, Error> chain_try_expr(uint8_t seed) noexcept {
+  if constexpr (Level == 0) {
+    return parse(seed);
+  } else {
+    return stx::make_ok_in_place<Message, Error>(
+        TRY_OK_EXPR(chain_try_expr<Level - 1>(seed)));
+  }
+}
+
+template <Result<Message, Error> (*Chain)(uint8_t)>
+void run(benchmark::State& state) noexcept {
+  // seed 0 fails at the innermost level and propagates the error
+  uint8_t seed = static_cast<uint8_t>(state.range(0));
+  moves = 0;
+  for (auto _ : state) {
+    auto result = Chain(seed);
+    benchmark::DoNotOptimize(&result);
+  }
+  state.counters["moves/op"] = benchmark::Counter(
+      static_cast<double>(moves), benchmark::Counter::kAvgIterations);
+}
+
+void Try_Chain(benchmark::State& state) noexcept {  // NOLINT
+  run<chain_try<kDepth>>(state);
+}
+
+void TryRef_Chain(benchmark::State& state) noexcept {  // NOLINT
+  run<chain_try_ref<kDepth>>(state);
+}
+
+void TryRefInPlace_Chain(benchmark::State& state) noexcept {  // NOLINT
+  run<chain_try_ref_in_place<kDepth>>(state);
+}
+
+void TryExpr_Chain(benchmark::State& state) noexcept {  // NOLINT
+  run<chain_try_expr<kDepth>>(state);
+}
+
+// Arg(1): success path, Arg(0): failure path
+BENCHMARK(Try_Chain)->Arg(1)->Arg(0);
+BENCHMARK(TryRef_Chain)->Arg(1)->Arg(0);
+BENCHMARK(TryRefInPlace_Chain)->Arg(1)->Arg(0);
+BENCHMARK(TryExpr_Chain)->Arg(1)->Arg(0);
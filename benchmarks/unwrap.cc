@@ -0,0 +1,135 @@
+// Measures the cost of many `unwrap()` call sites in a single hot function.
+//
+// The `Stx_*` functions use `unwrap()` whose panic path is out-of-line and
+// cold, the `InlinePanic_*` functions expand the panic path (source location,
+// report and `begin_panic` call) at every call site as the unwrap helpers
+// previously did.
+//
+// Throughput is reported by the benchmarks, the code size of each function
+// can be compared with:
+//
+//   nm -C -S --size-sort stx_benchmark_unwrap | grep _sites
+//
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "stx/option.h"
+#include "stx/panic.h"
+
+using stx::Option, stx::Result, stx::Some, stx::Ok;
+
+enum class Error { Invalid };
+
+using IntResult = Result<int64_t, Error>;
+
+inline IntResult checked(int64_t value) {
+  if (value < 0) return stx::Err(Error::Invalid);
+  return Ok(std::move(value));
+}
+
+#define STX_BENCH_REPEAT_16_(x) x x x x x x x x x x x x x x x x
+#define STX_BENCH_REPEAT_256_(x) STX_BENCH_REPEAT_16_(STX_BENCH_REPEAT_16_(x))
+
+constexpr size_t num_sites = 256;
+
+template <typename T>
+STX_FORCE_INLINE T inline_panic_unwrap(Option<T>&& option) {
+  if (option.is_none()) {
+    stx::panic("called `Option::unwrap()` on a `None` value");
+  }
+  return std::move(option).unwrap();
+}
+
+template <typename T, typename E>
+STX_FORCE_INLINE T inline_panic_unwrap(Result<T, E>&& result) {
+  if (result.is_err()) {
+    stx::panic("called `Result::unwrap()` on an `Err` value",
+               std::move(result).unwrap_err());
+  }
+  return std::move(result).unwrap();
+}
+
+[[gnu::noinline]] int64_t stx_option_sites(Option<int64_t> const* options) {
+  int64_t sum = 0;
+  size_t i = 0;
+  STX_BENCH_REPEAT_256_(sum += options[i++].clone().unwrap();)
+  return sum;
+}
+
+[[gnu::noinline]] int64_t inline_panic_option_sites(
+    Option<int64_t> const* options) {
+  int64_t sum = 0;
+  size_t i = 0;
+  STX_BENCH_REPEAT_256_(sum += inline_panic_unwrap(options[i++].clone());)
+  return sum;
+}
+
+[[gnu::noinline]] int64_t stx_result_sites(int64_t const* values) {
+  int64_t sum = 0;
+  size_t i = 0;
+  STX_BENCH_REPEAT_256_(sum += checked(values[i++]).unwrap();)
+  return sum;
+}
+
+[[gnu::noinline]] int64_t inline_panic_result_sites(int64_t const* values) {
+  int64_t sum = 0;
+  size_t i = 0;
+  STX_BENCH_REPEAT_256_(sum += inline_panic_unwrap(checked(values[i++]));)
+  return sum;
+}
+
+std::vector<Option<int64_t>> make_options() {
+  std::vector<Option<int64_t>> options;
+  for (size_t i = 0; i < num_sites; i++) {
+    options.push_back(Some(static_cast<int64_t>(i)));
+  }
+  return options;
+}
+
+std::vector<int64_t> make_values() {
+  std::vector<int64_t> values;
+  for (size_t i = 0; i < num_sites; i++) {
+    values.push_back(static_cast<int64_t>(i));
+  }
+  return values;
+}
+
+void Stx_OptionUnwrapSites(benchmark::State& state) noexcept {  // NOLINT
+  auto options = make_options();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(stx_option_sites(options.data()));
+  }
+  state.SetItemsProcessed(state.iterations() * num_sites);
+}
+
+void InlinePanic_OptionUnwrapSites(benchmark::State& state) noexcept {  // NOLINT
+  auto options = make_options();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(inline_panic_option_sites(options.data()));
+  }
+  state.SetItemsProcessed(state.iterations() * num_sites);
+}
+
+void Stx_ResultUnwrapSites(benchmark::State& state) noexcept {  // NOLINT
+  auto values = make_values();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(stx_result_sites(values.data()));
+  }
+  state.SetItemsProcessed(state.iterations() * num_sites);
+}
+
+void InlinePanic_ResultUnwrapSites(benchmark::State& state) noexcept {  // NOLINT
+  auto values = make_values();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(inline_panic_result_sites(values.data()));
+  }
+  state.SetItemsProcessed(state.iterations() * num_sites);
+}
+
+BENCHMARK(Stx_OptionUnwrapSites);
+BENCHMARK(InlinePanic_OptionUnwrapSites);
+BENCHMARK(Stx_ResultUnwrapSites);
+BENCHMARK(InlinePanic_ResultUnwrapSites);
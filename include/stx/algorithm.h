@@ -0,0 +1,248 @@
+/**
+ * @file algorithm.h
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-20
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "stx/config.h"
+#include "stx/option.h"
+#include "stx/panic.h"
+#include "stx/result.h"
+#include "stx/span.h"
+
+// Algorithms over spans of `Result`s and `Option`s.
+//
+// They write into caller-provided output spans and never allocate. The
+// values and errors are moved out of the input elements, or copied if the
+// input span's elements are `const`.
+
+STX_BEGIN_NAMESPACE
+
+namespace internal {
+namespace algorithm {
+
+/// panic helper for the algorithms when an output span can't hold the
+/// elements written into it
+[[noreturn]] STX_COLD STX_NOINLINE inline void output_too_small() noexcept {
+  panic("output span is smaller than the input span");
+}
+
+template <typename R>
+struct result_types;
+
+template <typename T, typename E>
+struct result_types<Result<T, E>> {
+  using value_type = T;
+  using error_type = E;
+};
+
+template <typename O>
+struct option_types;
+
+template <typename T>
+struct option_types<Option<T>> {
+  using value_type = T;
+};
+
+template <typename T, typename E>
+T&& forward_value(Result<T, E>& result) {
+  return result::unsafe_value_move(result);
+}
+
+template <typename T, typename E>
+T const& forward_value(Result<T, E> const& result) {
+  return result.value();
+}
+
+template <typename T, typename E>
+E&& forward_err(Result<T, E>& result) {
+  return result::unsafe_err_move(result);
+}
+
+template <typename T, typename E>
+E const& forward_err(Result<T, E> const& result) {
+  return result.err_value();
+}
+
+template <typename T>
+T&& forward_value(Option<T>& option) {
+  return option::unsafe_value_move(option);
+}
+
+template <typename T>
+T const& forward_value(Option<T> const& option) {
+  return option.value();
+}
+
+}  // namespace algorithm
+}  // namespace internal
+
+/// Writes the values of `input` into `output` if all of its elements are
+/// `Ok`, stopping at the first `Err`.
+///
+/// Returns the prefix of `output` holding the values, or the first error.
+/// When an error is returned, the values of the elements preceding it have
+/// been written into `output`.
+///
+/// # Panics
+///
+/// Panics if `output` is smaller than `input`.
+///
+/// # Examples
+///
+/// Basic usage:
+///
+/// ``` cpp
+/// vector<Result<int, Error>> rows = ...;
+/// vector<int> values(rows.size());
+///
+/// TRY_OK(parsed, try_collect(Span<Result<int, Error>>(rows),
+///                            Span<int>(values)));
+/// ```
+template <typename R, size_t InExtent, typename T, size_t OutExtent>
+[[nodiscard]] auto try_collect(Span<R, InExtent> input,
+                               Span<T, OutExtent> output)
+    -> Result<Span<T>, typename internal::algorithm::result_types<
+                           std::remove_const_t<R>>::error_type> {
+  using E = typename internal::algorithm::result_types<
+      std::remove_const_t<R>>::error_type;
+  STX_CHECK(output.size() >= input.size(),
+            internal::algorithm::output_too_small());
+  R* const results = input.data();
+  T* const values = output.data();
+  size_t const size = input.size();
+  for (size_t i = 0; i < size; i++) {
+    if (results[i].is_err()) {
+      return Err<E>(E(internal::algorithm::forward_err(results[i])));
+    }
+    values[i] = internal::algorithm::forward_value(results[i]);
+  }
+  return Ok(Span<T>(values, size));
+}
+
+/// the outputs of `partition_results`
+template <typename T, typename E>
+struct Partitioned {
+  /// the values of the `Ok` elements, in order
+  Span<T> ok;
+  /// the errors of the `Err` elements, in order
+  Span<E> err;
+};
+
+/// Writes the values of the `Ok` elements of `input` into `ok` and the
+/// errors of the `Err` elements into `err`, preserving their order.
+///
+/// # Panics
+///
+/// Panics if `ok` or `err` is smaller than `input`: the outputs must be able
+/// to hold all the elements.
+///
+/// # Examples
+///
+/// Basic usage:
+///
+/// ``` cpp
+/// Result<int, Error> rows[] = {Ok(1), Err(Error::Invalid), Ok(3)};
+/// int values[3];
+/// Error errors[3];
+///
+/// auto [ok, err] = partition_results(Span<Result<int, Error>>(rows),
+///                                    Span<int>(values), Span<Error>(errors));
+/// ASSERT_EQ(ok.size(), 2);
+/// ASSERT_EQ(err.size(), 1);
+/// ```
+template <typename R, size_t InExtent, typename T, size_t OkExtent,
+          typename E, size_t ErrExtent>
+[[nodiscard]] Partitioned<T, E> partition_results(Span<R, InExtent> input,
+                                                  Span<T, OkExtent> ok,
+                                                  Span<E, ErrExtent> err) {
+  STX_CHECK(ok.size() >= input.size() && err.size() >= input.size(),
+            internal::algorithm::output_too_small());
+  R* const results = input.data();
+  T* const values = ok.data();
+  E* const errors = err.data();
+  size_t const size = input.size();
+  size_t num_ok = 0;
+  size_t num_err = 0;
+  for (size_t i = 0; i < size; i++) {
+    if (results[i].is_ok()) {
+      values[num_ok] = internal::algorithm::forward_value(results[i]);
+      num_ok++;
+    } else {
+      errors[num_err] = internal::algorithm::forward_err(results[i]);
+      num_err++;
+    }
+  }
+  return Partitioned<T, E>{Span<T>(values, num_ok), Span<E>(errors, num_err)};
+}
+
+/// Writes the values of the `Some` elements of `input` into `output`,
+/// preserving their order, and returns the prefix of `output` holding them.
+///
+/// # Panics
+///
+/// Panics if `output` is smaller than `input`.
+///
+/// # Examples
+///
+/// Basic usage:
+///
+/// ``` cpp
+/// Option<int> samples[] = {Some(1), None, Some(3)};
+/// int values[3];
+///
+/// Span<int> present = flatten(Span<Option<int>>(samples), Span<int>(values));
+/// ASSERT_EQ(present.size(), 2);
+/// ```
+template <typename O, size_t InExtent, typename T, size_t OutExtent>
+[[nodiscard]] Span<T> flatten(Span<O, InExtent> input,
+                              Span<T, OutExtent> output) {
+  static_assert(std::is_same_v<typename internal::algorithm::option_types<
+                                   std::remove_const_t<O>>::value_type,
+                               std::remove_const_t<T>>,
+                "'flatten' writes the values into a span of the same type");
+  STX_CHECK(output.size() >= input.size(),
+            internal::algorithm::output_too_small());
+  O* const options = input.data();
+  T* const values = output.data();
+  size_t const size = input.size();
+  size_t count = 0;
+  for (size_t i = 0; i < size; i++) {
+    if (options[i].is_some()) {
+      values[count] = internal::algorithm::forward_value(options[i]);
+      count++;
+    }
+  }
+  return Span<T>(values, count);
+}
+
+STX_END_NAMESPACE
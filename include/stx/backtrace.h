@@ -31,6 +31,7 @@
 
 #include <cstdint>
 
+#include "stx/error_code.h"
 #include "stx/internal/option_result.h"
 #include "stx/report.h"
 #include "stx/span.h"
@@ -67,6 +68,17 @@ inline SpanReport operator>>(ReportQuery, SignalError const &err) noexcept {
   }
 }
 
+inline std::string_view signal_error_message(int64_t value) noexcept {
+  // qualified, so the conversion into `ErrorCode` isn't considered before
+  // `error_code_traits<SignalError>` is specialized
+  return backtrace::operator>>(report_query, static_cast<SignalError>(value))
+      .what();
+}
+
+/// category of the `SignalError` values
+inline constexpr ErrorCategory signal_error_category{"signal",
+                                                     signal_error_message};
+
 /// `Symbol` contains references to buffers and as such should not be copied nor
 /// moved as a reference. Its raw data content can also be copied as a
 /// `std::string`.
@@ -168,4 +180,11 @@ auto handle_signal(int signal) noexcept -> Result<void (*)(int), SignalError>;
 
 }  // namespace backtrace
 
+/// `SignalError` converts into an `ErrorCode`
+template <>
+struct error_code_traits<backtrace::SignalError> {
+  static constexpr ErrorCategory const* category =
+      &backtrace::signal_error_category;
+};
+
 STX_END_NAMESPACE
@@ -206,6 +206,22 @@
 #define STX_ARCH_RISCV 0
 #endif
 
+/*********************** BYTE ORDER ***********************/
+
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__)
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define STX_ENDIAN_LITTLE 1
+#else
+#define STX_ENDIAN_LITTLE 0
+#endif
+#else
+#if CFG(COMPILER, MSVC)  // all the targets supported by MSVC
+#define STX_ENDIAN_LITTLE 1
+#else
+#define STX_ENDIAN_LITTLE 0
+#endif
+#endif
+
 /************ FEATURE AND LIBRARY REQUIREMENTS ************/
 
 #if defined __has_builtin
@@ -214,6 +230,23 @@
 #define STX_HAS_BUILTIN(feature) 0
 #endif
 
+/// `true` when evaluated in a constant expression. Without compiler support it
+/// is always `true`, code guarded by `!STX_IS_CONSTANT_EVALUATED()` then never
+/// runs
+#if STX_HAS_BUILTIN(is_constant_evaluated)
+#define STX_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#else
+#define STX_IS_CONSTANT_EVALUATED() true
+#endif
+
+#if defined(__cpp_consteval) && __cpp_consteval >= 201811L
+/// immediate function: always evaluated at compile time, it is `constexpr`
+/// before C++ 20
+#define STX_CONSTEVAL consteval
+#else
+#define STX_CONSTEVAL constexpr
+#endif
+
 // From non-trivial constexpr paper
 #if __cpp_constexpr >= 201807L
 
@@ -261,6 +294,136 @@
 #endif
 #endif
 
+/// marks a function as unlikely to be executed, the function is optimized for
+/// size and placed away from hot code. i.e. panic paths
+#if __has_cpp_attribute(gnu::cold)
+#define STX_COLD [[gnu::cold]]
+#else
+#define STX_COLD
+#endif
+
+#if __has_cpp_attribute(gnu::noinline)
+#define STX_NOINLINE [[gnu::noinline]]
+#else
+#if CFG(COMPILER, MSVC)
+#define STX_NOINLINE __declspec(noinline)
+#else
+#define STX_NOINLINE
+#endif
+#endif
+
+/// branch prediction hints, i.e. `if (STX_UNLIKELY(is_err())) { ... }`
+#if STX_HAS_BUILTIN(expect)
+#define STX_LIKELY(expr) __builtin_expect(static_cast<bool>(expr), 1)
+#define STX_UNLIKELY(expr) __builtin_expect(static_cast<bool>(expr), 0)
+#else
+#define STX_LIKELY(expr) static_cast<bool>(expr)
+#define STX_UNLIKELY(expr) static_cast<bool>(expr)
+#endif
+
+/// tells the optimizer that `expr` always holds. `expr` must be free of side
+/// effects and the program's behaviour is undefined if it doesn't hold.
+#if STX_HAS_BUILTIN(assume)
+#define STX_ASSUME(expr) __builtin_assume(static_cast<bool>(expr))
+#else
+#if STX_HAS_BUILTIN(unreachable)
+#define STX_ASSUME(expr) \
+  (static_cast<bool>(expr) ? static_cast<void>(0) : __builtin_unreachable())
+#else
+#if CFG(COMPILER, MSVC)
+#define STX_ASSUME(expr) __assume(static_cast<bool>(expr))
+#else
+#define STX_ASSUME(expr) static_cast<void>(0)
+#endif
+#endif
+#endif
+
+/*********************** CONTRACT LEVELS ***********************/
+
+// The contract level determines what happens when a precondition of a
+// checked accessor (i.e. `Option::unwrap()`, `Result::value()`,
+// `Span::operator[]`) is violated:
+//
+// - `STX_CONTRACT_LEVEL_CHECKED`: the precondition is checked and violations
+// panic. This is the default.
+// - `STX_CONTRACT_LEVEL_AUDIT`: same as checked, with additional (possibly
+// costly) invariants checked, i.e. Span bounds. This is the default when
+// `STX_ENABLE_DEBUG_ASSERTIONS` is defined.
+// - `STX_CONTRACT_LEVEL_ASSUME`: the preconditions are not checked but assumed
+// to hold and handed to the optimizer, violating them is undefined behaviour.
+//
+// The level is selected by defining `STX_CONTRACT_LEVEL` to one of the values
+// above. It doesn't apply to the documented panics guarding against API
+// misuse (i.e. an output span smaller than the input), which are always
+// checked with `STX_CHECK`.
+
+#define STX_CONTRACT_LEVEL_ASSUME 0
+#define STX_CONTRACT_LEVEL_CHECKED 1
+#define STX_CONTRACT_LEVEL_AUDIT 2
+
+#if !defined(STX_CONTRACT_LEVEL)
+#if defined(STX_ENABLE_DEBUG_ASSERTIONS)
+#define STX_CONTRACT_LEVEL STX_CONTRACT_LEVEL_AUDIT
+#else
+#define STX_CONTRACT_LEVEL STX_CONTRACT_LEVEL_CHECKED
+#endif
+#endif
+
+#if STX_CONTRACT_LEVEL != STX_CONTRACT_LEVEL_ASSUME &&  \
+    STX_CONTRACT_LEVEL != STX_CONTRACT_LEVEL_CHECKED && \
+    STX_CONTRACT_LEVEL != STX_CONTRACT_LEVEL_AUDIT
+#error `STX_CONTRACT_LEVEL` must be one of `STX_CONTRACT_LEVEL_ASSUME`, `STX_CONTRACT_LEVEL_CHECKED` or `STX_CONTRACT_LEVEL_AUDIT`
+#endif
+
+#define STX_CHECK_(expr, on_violation) \
+  do {                                 \
+    if (STX_UNLIKELY(!(expr))) {       \
+      on_violation;                    \
+    }                                  \
+  } while (false)
+
+/// documented panic guarding against API misuse, checked at every contract
+/// level. `on_violation` must not return.
+#define STX_CHECK(expr, on_violation) STX_CHECK_(expr, on_violation)
+
+// `on_violation` is kept in dead code so its arguments and the panic helpers
+// it calls are still used when the precondition is only assumed
+#define STX_ASSUME_(expr, on_violation) \
+  do {                                  \
+    STX_ASSUME(expr);                   \
+    if (false) {                        \
+      on_violation;                     \
+    }                                   \
+  } while (false)
+
+/// precondition of a checked accessor, `on_violation` must not return.
+#if STX_CONTRACT_LEVEL == STX_CONTRACT_LEVEL_ASSUME
+#define STX_EXPECTS(expr, on_violation) STX_ASSUME_(expr, on_violation)
+#else
+#define STX_EXPECTS(expr, on_violation) STX_CHECK_(expr, on_violation)
+#endif
+
+/// precondition only checked at the audit level, it is assumed at the assume
+/// level and ignored at the checked level.
+#if STX_CONTRACT_LEVEL == STX_CONTRACT_LEVEL_AUDIT
+#define STX_AUDIT_EXPECTS(expr, on_violation) STX_CHECK_(expr, on_violation)
+#else
+#if STX_CONTRACT_LEVEL == STX_CONTRACT_LEVEL_ASSUME
+#define STX_AUDIT_EXPECTS(expr, on_violation) STX_ASSUME_(expr, on_violation)
+#else
+#define STX_AUDIT_EXPECTS(expr, on_violation) static_cast<void>(0)
+#endif
+#endif
+
+/// precondition of an unchecked accessor (i.e. `Option::unwrap_unchecked()`),
+/// it is checked when `STX_ENABLE_DEBUG_ASSERTIONS` is defined and assumed
+/// otherwise, regardless of the contract level.
+#if defined(STX_ENABLE_DEBUG_ASSERTIONS)
+#define STX_DEBUG_EXPECTS(expr, on_violation) STX_CHECK_(expr, on_violation)
+#else
+#define STX_DEBUG_EXPECTS(expr, on_violation) STX_ASSUME_(expr, on_violation)
+#endif
+
 /*********************** ATTRIBUTE REQUIREMENTS ***********************/
 
 #if defined(__has_cpp_attribute)
@@ -0,0 +1,604 @@
+/**
+ * @file coroutine.h
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-02
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "stx/config.h"
+#include "stx/option.h"
+#include "stx/result.h"
+
+// `Result` and `Option` coroutines with a trivially copyable return type
+// require the compiler to defer the conversion of `get_return_object()`'s
+// result to the coroutine's return type until the coroutine first returns to
+// its caller (see `internal::coroutine::PromiseBase`), which the standard
+// leaves unspecified. GCC and MSVC defer it, Clang does since version 17.
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>) && \
+    (!defined(__clang__) || __clang_major__ >= 17)
+#define STX_HAS_COROUTINES 1
+#else
+#define STX_HAS_COROUTINES 0
+#endif
+
+/// size of the per-thread arena of the default coroutine frame allocator
+#if !defined(STX_COROUTINE_ARENA_SIZE)
+#define STX_COROUTINE_ARENA_SIZE (64 * 1024)
+#endif
+
+/// maximum number of bytes of released frames cached per size class by the
+/// per-thread pool of the pool coroutine frame allocator
+#if !defined(STX_COROUTINE_POOL_SIZE)
+#define STX_COROUTINE_POOL_SIZE (256 * 1024)
+#endif
+
+#if STX_HAS_COROUTINES
+
+#include <bit>
+#include <coroutine>
+#include <exception>
+
+STX_BEGIN_NAMESPACE
+
+//! Allocator for the frames of `Result` and `Option` coroutines.
+//!
+//! It is only used when the compiler can't elide the frame allocation
+//! (HALO), i.e. when the coroutine is not inlined into its caller.
+//!
+//! The frames of `Result` and `Option` coroutines never outlive the call to
+//! the coroutine, they are thus always released in the reverse order of their
+//! allocation. The default allocator (`arena_coroutine_frame_allocator`) is
+//! therefore a per-thread stack arena that falls back to the global heap once
+//! exhausted.
+//!
+//! The allocator is selected per-thread with `set_coroutine_frame_allocator`.
+//! Every frame records the allocator it was allocated with and is always
+//! released to it.
+//!
+struct CoroutineFrameAllocator {
+  /// allocates `size` bytes aligned to `alignof(std::max_align_t)`, must not
+  /// return `nullptr`
+  void* (*allocate)(size_t size);
+  /// releases `frame` of `size` bytes, previously returned by `allocate`
+  void (*deallocate)(void* frame, size_t size) noexcept;
+};
+
+namespace internal {
+namespace coroutine {
+
+constexpr size_t kFrameAlignment = alignof(std::max_align_t);
+
+constexpr size_t align_frame_size(size_t size) noexcept {
+  return (size + kFrameAlignment - 1) & ~(kFrameAlignment - 1);
+}
+
+struct Arena {
+  Arena() = default;
+  Arena(Arena const&) = delete;
+  Arena& operator=(Arena const&) = delete;
+  ~Arena() { ::operator delete(begin); }
+
+  std::byte* begin = nullptr;
+  std::byte* top = nullptr;
+  std::byte* end = nullptr;
+};
+
+// lazily allocated on the first frame allocation of each thread
+inline Arena& thread_arena() noexcept {
+  thread_local Arena arena;
+  return arena;
+}
+
+inline void* arena_allocate(size_t size) {
+  Arena& arena = thread_arena();
+  if (STX_UNLIKELY(arena.begin == nullptr)) {
+    arena.begin =
+        static_cast<std::byte*>(::operator new(STX_COROUTINE_ARENA_SIZE));
+    arena.top = arena.begin;
+    arena.end = arena.begin + STX_COROUTINE_ARENA_SIZE;
+  }
+
+  size = align_frame_size(size);
+
+  if (STX_LIKELY(static_cast<size_t>(arena.end - arena.top) >= size)) {
+    void* frame = arena.top;
+    arena.top += size;
+    return frame;
+  }
+
+  return ::operator new(size);
+}
+
+inline void arena_deallocate(void* frame, size_t size) noexcept {
+  Arena& arena = thread_arena();
+  auto address = reinterpret_cast<uintptr_t>(frame);
+  if (STX_LIKELY(address >= reinterpret_cast<uintptr_t>(arena.begin) &&
+                 address < reinterpret_cast<uintptr_t>(arena.end))) {
+    // frames are released in the reverse order of their allocation, this
+    // also releases the frames above it
+    arena.top = static_cast<std::byte*>(frame);
+  } else {
+    ::operator delete(frame, align_frame_size(size));
+  }
+}
+
+inline void* heap_allocate(size_t size) { return ::operator new(size); }
+
+inline void heap_deallocate(void* frame, size_t size) noexcept {
+  ::operator delete(frame, size);
+}
+
+// frames of up to 64, 128, ..., 4096 bytes are pooled, larger ones are
+// allocated from the global heap
+constexpr size_t kPoolMinClassSize = 64;
+constexpr size_t kPoolNumClasses = 7;
+
+constexpr size_t pool_class(size_t size) noexcept {
+  return size <= kPoolMinClassSize
+             ? 0
+             : static_cast<size_t>(std::bit_width(size - 1)) -
+                   static_cast<size_t>(std::bit_width(kPoolMinClassSize - 1));
+}
+
+constexpr size_t pool_class_size(size_t size_class) noexcept {
+  return kPoolMinClassSize << size_class;
+}
+
+// per-thread free lists of released frames, one per size class. A frame can
+// be released on another thread than the one it was allocated on, it then
+// joins the releasing thread's free list.
+struct Pool {
+  struct Block {
+    Block* next;
+  };
+
+  Pool() = default;
+  Pool(Pool const&) = delete;
+  Pool& operator=(Pool const&) = delete;
+
+  ~Pool() {
+    for (size_t c = 0; c < kPoolNumClasses; c++) {
+      while (Block* block = free[c]) {
+        free[c] = block->next;
+        ::operator delete(block, pool_class_size(c));
+      }
+    }
+  }
+
+  Block* free[kPoolNumClasses] = {};
+  size_t num_free[kPoolNumClasses] = {};
+};
+
+inline Pool& thread_pool() noexcept {
+  thread_local Pool pool;
+  return pool;
+}
+
+inline void* pool_allocate(size_t size) {
+  size_t const size_class = pool_class(size);
+  if (STX_UNLIKELY(size_class >= kPoolNumClasses)) {
+    return ::operator new(size);
+  }
+
+  Pool& pool = thread_pool();
+  if (Pool::Block* block = pool.free[size_class]; STX_LIKELY(block != nullptr)) {
+    pool.free[size_class] = block->next;
+    pool.num_free[size_class]--;
+    return block;
+  }
+
+  return ::operator new(pool_class_size(size_class));
+}
+
+inline void pool_deallocate(void* frame, size_t size) noexcept {
+  size_t const size_class = pool_class(size);
+  if (STX_UNLIKELY(size_class >= kPoolNumClasses)) {
+    ::operator delete(frame, size);
+    return;
+  }
+
+  Pool& pool = thread_pool();
+  if (STX_UNLIKELY(pool.num_free[size_class] * pool_class_size(size_class) >=
+                   STX_COROUTINE_POOL_SIZE)) {
+    ::operator delete(frame, pool_class_size(size_class));
+    return;
+  }
+
+  pool.free[size_class] = new (frame) Pool::Block{pool.free[size_class]};
+  pool.num_free[size_class]++;
+}
+
+}  // namespace coroutine
+}  // namespace internal
+
+/// per-thread stack arena frame allocator, falls back to the global heap once
+/// its `STX_COROUTINE_ARENA_SIZE` bytes are exhausted. This is the default.
+constexpr CoroutineFrameAllocator arena_coroutine_frame_allocator{
+    internal::coroutine::arena_allocate,
+    internal::coroutine::arena_deallocate};
+
+/// global heap frame allocator (`::operator new` and `::operator delete`)
+constexpr CoroutineFrameAllocator heap_coroutine_frame_allocator{
+    internal::coroutine::heap_allocate, internal::coroutine::heap_deallocate};
+
+/// per-thread size-class pool frame allocator: released frames of up to 4096
+/// bytes are cached (up to `STX_COROUTINE_POOL_SIZE` bytes per size class) and
+/// reused by the next allocations of the same size class. Unlike the arena,
+/// the frames can be released in any order and on any thread.
+constexpr CoroutineFrameAllocator pool_coroutine_frame_allocator{
+    internal::coroutine::pool_allocate, internal::coroutine::pool_deallocate};
+
+namespace internal {
+namespace coroutine {
+
+inline CoroutineFrameAllocator& thread_allocator() noexcept {
+  thread_local CoroutineFrameAllocator allocator =
+      arena_coroutine_frame_allocator;
+  return allocator;
+}
+
+// precedes every frame, records the allocator the frame was allocated with
+struct FrameHeader {
+  void (*deallocate)(void* frame, size_t size) noexcept;
+};
+
+static_assert(sizeof(FrameHeader) <= kFrameAlignment);
+
+inline void* allocate_frame(size_t size) {
+  CoroutineFrameAllocator const& allocator = thread_allocator();
+  auto* memory =
+      static_cast<std::byte*>(allocator.allocate(size + kFrameAlignment));
+  new (memory) FrameHeader{allocator.deallocate};
+  return memory + kFrameAlignment;
+}
+
+inline void deallocate_frame(void* frame, size_t size) noexcept {
+  auto* memory = static_cast<std::byte*>(frame) - kFrameAlignment;
+  auto* header = std::launder(reinterpret_cast<FrameHeader*>(memory));
+  header->deallocate(memory, size + kFrameAlignment);
+}
+
+// The coroutine runs synchronously to completion or until an awaited `Err` or
+// `None` short-circuits it, the frame is then released before the call
+// returns. The coroutine handle never escapes, which allows the compiler to
+// elide the frame allocation whenever the coroutine is inlined.
+//
+// The promise writes the value or error directly into the return object it
+// is bound to, which is constructed once, uninitialized, by the promise's
+// `make_return_object()`.
+//
+// A return object that is not trivially copyable is returned by
+// `get_return_object()` itself and is initialized in place as the
+// coroutine's return value. A trivially copyable one is returned in registers
+// and has no storage the promise could be bound to (GCC copies it out of the
+// object returned by `get_return_object()` before the coroutine starts): it
+// is constructed in the frame, and copied out once the coroutine completes,
+// when `get_return_object()`'s `ReturnProxy` is converted to the coroutine's
+// return type as it returns to its caller. The conversion must thus be
+// deferred until after `initial_suspend()`: a compiler converting it eagerly
+// can't produce a trivially copyable return object at all, as it is copied
+// out before the coroutine starts. `STX_HAS_COROUTINES` is only set for the
+// compilers known to defer it.
+template <typename Promise, typename Return,
+          bool InFrame = std::is_trivially_copyable_v<Return>>
+struct PromiseBase {
+  static void* operator new(size_t size) { return allocate_frame(size); }
+
+  static void operator delete(void* frame, size_t size) noexcept {
+    deallocate_frame(frame, size);
+  }
+
+  Return get_return_object() noexcept {
+    return static_cast<Promise&>(*this).make_return_object();
+  }
+
+  std::suspend_never initial_suspend() const noexcept { return {}; }
+
+  std::suspend_never final_suspend() const noexcept { return {}; }
+
+  // the return object is not fully constructed until the coroutine returns
+  [[noreturn]] void unhandled_exception() const noexcept { std::terminate(); }
+
+  // called by an awaiter once the value or error is written
+  void short_circuit() noexcept {
+    std::coroutine_handle<Promise>::from_promise(static_cast<Promise&>(*this))
+        .destroy();
+  }
+
+  // called by the return object's constructor
+  void bind(Return& return_object) noexcept { return_object_ = &return_object; }
+
+  Return* return_object_ = nullptr;
+};
+
+template <typename Promise, typename Return>
+struct PromiseBase<Promise, Return, true> {
+  struct ReturnProxy {
+    Promise& promise;
+
+    operator Return() const noexcept {
+      std::coroutine_handle<Promise> const coroutine =
+          std::coroutine_handle<Promise>::from_promise(promise);
+      coroutine.resume();
+      Return result{std::move(*promise.return_object_)};
+      coroutine.destroy();
+      return result;
+    }
+  };
+
+  static void* operator new(size_t size) { return allocate_frame(size); }
+
+  static void operator delete(void* frame, size_t size) noexcept {
+    deallocate_frame(frame, size);
+  }
+
+  ReturnProxy get_return_object() noexcept {
+    return ReturnProxy{static_cast<Promise&>(*this)};
+  }
+
+  // the coroutine is run by the conversion of the `ReturnProxy`
+  std::suspend_always initial_suspend() noexcept {
+    // `make_return_object()` returns through registers: its result is bound
+    // to a temporary and is rebound once moved into the frame
+    return_object_ =
+        new (storage_) Return(static_cast<Promise&>(*this).make_return_object());
+    return {};
+  }
+
+  // the frame is destroyed by the conversion of the `ReturnProxy`
+  std::suspend_always final_suspend() const noexcept { return {}; }
+
+  // the return object is not fully constructed until the coroutine returns
+  [[noreturn]] void unhandled_exception() const noexcept { std::terminate(); }
+
+  // called by an awaiter once the value or error is written, the coroutine is
+  // left suspended
+  void short_circuit() const noexcept {}
+
+  // called by the return object's constructor
+  void bind(Return& return_object) noexcept { return_object_ = &return_object; }
+
+  Return* return_object_ = nullptr;
+  alignas(Return) unsigned char storage_[sizeof(Return)];
+};
+
+}  // namespace coroutine
+}  // namespace internal
+
+/// sets the coroutine frame allocator of the calling thread, returning the
+/// previous one.
+///
+/// # Examples
+///
+/// Basic usage:
+///
+/// ``` cpp
+/// auto previous = set_coroutine_frame_allocator(heap_coroutine_frame_allocator);
+/// // ...
+/// set_coroutine_frame_allocator(previous);
+/// ```
+inline CoroutineFrameAllocator set_coroutine_frame_allocator(
+    CoroutineFrameAllocator allocator) noexcept {
+  return std::exchange(internal::coroutine::thread_allocator(), allocator);
+}
+
+namespace internal {
+namespace result {
+
+template <typename T, typename E>
+struct Awaiter {
+  Result<T, E>& result;
+
+  bool await_ready() const noexcept { return result.is_ok(); }
+
+  template <typename Promise>
+  void await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+    handle.promise().return_err(unsafe_err_move(result));
+    handle.promise().short_circuit();
+  }
+
+  T await_resume() noexcept(std::is_nothrow_move_constructible_v<T>) {
+    return unsafe_value_move(result);
+  }
+};
+
+template <typename E>
+struct Awaiter<void, E> {
+  Result<void, E>& result;
+
+  bool await_ready() const noexcept { return result.is_ok(); }
+
+  template <typename Promise>
+  void await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+    handle.promise().return_err(unsafe_err_move(result));
+    handle.promise().short_circuit();
+  }
+
+  void await_resume() const noexcept {}
+};
+
+template <typename E>
+struct AwaitTransform {
+  /// short-circuits the coroutine if `result` is an `Err`, else evaluates to
+  /// its value. `F` must be convertible to `E`.
+  template <typename U, typename F>
+  Awaiter<U, F> await_transform(Result<U, F>&& result) const noexcept {
+    static_assert(std::is_constructible_v<E, F&&>,
+                  "the awaited 'Result<T, F>''s error type 'F' can not be "
+                  "converted to the coroutine's error type 'E'");
+    return Awaiter<U, F>{result};
+  }
+};
+
+template <typename T, typename E>
+struct Promise : coroutine::PromiseBase<Promise<T, E>, Result<T, E>>,
+                 AwaitTransform<E> {
+  Result<T, E> make_return_object() { return Result<T, E>{*this}; }
+
+  void return_value(Ok<T>&& ok) {
+    this->return_object_->storage_.construct_value(std::move(ok.value()));
+  }
+
+  void return_value(Err<E>&& err) {
+    this->return_object_->storage_.construct_err(std::move(err.value()));
+  }
+
+  template <typename U,
+            std::enable_if_t<std::is_constructible_v<T, U&&>, int> = 0>
+  void return_value(U&& value) {
+    this->return_object_->storage_.construct_value(std::forward<U>(value));
+  }
+
+  template <typename F>
+  void return_err(F&& err) {
+    this->return_object_->storage_.construct_err(std::forward<F>(err));
+  }
+};
+
+template <typename E>
+struct Promise<void, E>
+    : coroutine::PromiseBase<Promise<void, E>, Result<void, E>>,
+      AwaitTransform<E> {
+  Result<void, E> make_return_object() { return Result<void, E>{*this}; }
+
+  void return_value(Ok<void>&&) noexcept {}
+
+  void return_value(Err<E>&& err) {
+    this->return_object_->storage_.construct(std::move(err.value()));
+  }
+
+  template <typename F>
+  void return_err(F&& err) {
+    this->return_object_->storage_.construct(std::forward<F>(err));
+  }
+};
+
+}  // namespace result
+
+namespace option {
+
+template <typename T>
+struct Awaiter {
+  Option<T>& option;
+
+  bool await_ready() const noexcept { return option.is_some(); }
+
+  template <typename Promise>
+  void await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+    // the return object is already a `None`
+    handle.promise().short_circuit();
+  }
+
+  T await_resume() noexcept(std::is_nothrow_move_constructible_v<T>) {
+    return unsafe_value_move(option);
+  }
+};
+
+template <typename T>
+struct Promise : coroutine::PromiseBase<Promise<T>, Option<T>> {
+  Option<T> make_return_object() { return Option<T>{*this}; }
+
+  void return_value(NoneType const&) noexcept {}
+
+  void return_value(Some<T>&& some) {
+    this->return_object_->storage_.construct(std::move(some.value()));
+  }
+
+  template <typename U,
+            std::enable_if_t<std::is_constructible_v<T, U&&>, int> = 0>
+  void return_value(U&& value) {
+    this->return_object_->storage_.construct(std::forward<U>(value));
+  }
+
+  /// short-circuits the coroutine if `option` is a `None`, else evaluates to
+  /// its value.
+  template <typename U>
+  Awaiter<U> await_transform(Option<U>&& option) const noexcept {
+    return Awaiter<U>{option};
+  }
+};
+
+}  // namespace option
+}  // namespace internal
+
+STX_END_NAMESPACE
+
+//! Makes functions returning `Result<T, E>` coroutines whenever they use
+//! `co_await` or `co_return`. `co_await` on an r-value `Result` short-circuits
+//! the coroutine with its error if it is an `Err`, else it evaluates to its
+//! value. The coroutine returns with `co_return`, just as it would with
+//! `return`.
+//!
+//! # Examples
+//!
+//! ``` cpp
+//! auto add(string_view a, string_view b) -> Result<int, Error> {
+//!   co_return co_await parse_int(a) + co_await parse_int(b);
+//! }
+//!
+//! auto check(string_view a) -> Result<void, Error> {
+//!   int x = co_await parse_int(a);
+//!   if (x < 0) co_return Err(Error::Negative);
+//!   co_return Ok();
+//! }
+//! ```
+//!
+//! # Exceptions
+//!
+//! Exceptions must not escape the coroutine, `std::terminate` is called
+//! otherwise.
+//!
+template <typename T, typename E, typename... Args>
+struct std::coroutine_traits<stx::Result<T, E>, Args...> {
+  using promise_type = stx::internal::result::Promise<T, E>;
+};
+
+//! Makes functions returning `Option<T>` coroutines whenever they use
+//! `co_await` or `co_return`. `co_await` on an r-value `Option` short-circuits
+//! the coroutine with `None`, else it evaluates to its value.
+//!
+//! # Examples
+//!
+//! ``` cpp
+//! auto first_even(Span<int const> a) -> Option<int> {
+//!   int x = co_await a.at(0).copied();
+//!   co_return x % 2 == 0 ? Some(std::move(x)) : None;
+//! }
+//! ```
+//!
+template <typename T, typename... Args>
+struct std::coroutine_traits<stx::Option<T>, Args...> {
+  using promise_type = stx::internal::option::Promise<T>;
+};
+
+#endif
@@ -0,0 +1,277 @@
+/**
+ * @file dyn_error.h
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-11
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "stx/config.h"
+#include "stx/internal/option_result.h"
+#include "stx/option.h"
+#include "stx/report.h"
+
+STX_BEGIN_NAMESPACE
+
+#ifndef STX_DYN_ERROR_INLINE_SIZE
+constexpr size_t kDynErrorInlineSize = 32;
+#else
+constexpr size_t kDynErrorInlineSize = STX_DYN_ERROR_INLINE_SIZE;
+#endif
+
+constexpr size_t kDynErrorAlignment =
+    alignof(void*) > alignof(int64_t) ? alignof(void*) : alignof(int64_t);
+
+namespace internal {
+namespace dyn_error {
+
+// the operations on the type-erased error, `move` and `destroy` are null for
+// trivially copyable and destructible errors, which are copied bytewise
+struct VTable {
+  FixedReport (*report)(void const* error) noexcept;
+  void (*move)(void* dst, void* src) noexcept;
+  void (*destroy)(void* error) noexcept;
+};
+
+template <typename E>
+FixedReport report(void const* error) noexcept {
+  return FixedReport((report_query >> *static_cast<E const*>(error)).what());
+}
+
+template <typename E>
+void move(void* dst, void* src) noexcept {
+  new (dst) E(std::move(*static_cast<E*>(src)));
+}
+
+template <typename E>
+void destroy(void* error) noexcept {
+  static_cast<E*>(error)->~E();
+}
+
+template <typename E>
+inline constexpr VTable vtable{
+    &report<E>, std::is_trivially_copyable_v<E> ? nullptr : &move<E>,
+    std::is_trivially_destructible_v<E> ? nullptr : &destroy<E>};
+
+}  // namespace dyn_error
+}  // namespace internal
+
+struct DynError;
+
+/// checks if `E` can be held by a `DynError`: it fits in the inline storage
+/// and is nothrow move-constructible
+template <typename E>
+constexpr bool is_dyn_error_compatible =
+    !std::is_same_v<E, DynError> && std::is_object_v<E> &&
+    !std::is_const_v<E> && !std::is_volatile_v<E> &&
+    sizeof(E) <= kDynErrorInlineSize &&
+    alignof(E) <= kDynErrorAlignment &&
+    std::is_nothrow_move_constructible_v<E>;
+
+//! A type-erased error, holding any error type that fits in its inline storage
+//! (`kDynErrorInlineSize` bytes, configurable via `STX_DYN_ERROR_INLINE_SIZE`).
+//!
+//! `DynError` is the error type of application-level code, which propagates
+//! the errors of several libraries without handling them individually. It
+//! never allocates: the error is stored inline alongside a pointer to a static
+//! table of its report, move and destroy operations. Errors that are
+//! trivially copyable and destructible are moved bytewise without an indirect
+//! call.
+//!
+//! Any error fitting in the inline storage implicitly converts into a
+//! `DynError`, `TRY_OK` thus propagates them into a `Result<T, DynError>`.
+//! The error's `report_query` overload is used to report it, but only when
+//! `report()` is called (i.e. when `unwrap()` panics).
+//!
+//! # Examples
+//!
+//! ``` cpp
+//! auto load_config(std::string_view path) -> Result<Config, DynError> {
+//!   TRY_OK(file, open(path));              // Result<File, IoError>
+//!   TRY_OK(text, read_to_string(file));    // Result<std::string, IoError>
+//!   TRY_OK(config, parse_toml(text));      // Result<Config, ParseError>
+//!   return Ok(std::move(config));
+//! }
+//!
+//! load_config("app.toml").match(
+//!     [](Config config) { ... },
+//!     [](DynError error) { log(error.report().what()); });
+//! ```
+//!
+struct DynError {
+  /// holds `error`
+  template <typename E,
+            std::enable_if_t<is_dyn_error_compatible<std::remove_cv_t<
+                                 std::remove_reference_t<E>>>,
+                             int> = 0>
+  DynError(E&& error) noexcept(
+      std::is_nothrow_constructible_v<
+          std::remove_cv_t<std::remove_reference_t<E>>, E&&>)
+      : vtable_{&internal::dyn_error::vtable<
+            std::remove_cv_t<std::remove_reference_t<E>>>} {
+    construct<std::remove_cv_t<std::remove_reference_t<E>>>(
+        std::forward<E>(error));
+  }
+
+  /// constructs the error `E` in-place from `args`
+  template <typename E, typename... Args,
+            std::enable_if_t<is_dyn_error_compatible<E>, int> = 0>
+  explicit DynError(std::in_place_type_t<E>, Args&&... args) noexcept(
+      std::is_nothrow_constructible_v<E, Args&&...>)
+      : vtable_{&internal::dyn_error::vtable<E>} {
+    construct<E>(std::forward<Args>(args)...);
+  }
+
+  DynError(DynError&& other) noexcept : vtable_{other.vtable_} {
+    move_from(other);
+  }
+
+  DynError& operator=(DynError&& other) noexcept {
+    if (this != &other) {
+      destroy();
+      vtable_ = other.vtable_;
+      move_from(other);
+    }
+    return *this;
+  }
+
+  DynError(DynError const&) = delete;
+  DynError& operator=(DynError const&) = delete;
+
+  ~DynError() noexcept { destroy(); }
+
+  /// Reports the held error via its `report_query` overload.
+  ///
+  /// # Examples
+  ///
+  /// Basic usage:
+  ///
+  /// ``` cpp
+  /// DynError error = IoError::EoF;
+  /// ASSERT_EQ(error.report().what(), "End of File");
+  /// ```
+  [[nodiscard]] FixedReport report() const noexcept {
+    return vtable_->report(storage_);
+  }
+
+  /// Returns `true` if the held error is of type `E`.
+  ///
+  /// # Examples
+  ///
+  /// Basic usage:
+  ///
+  /// ``` cpp
+  /// DynError error = IoError::EoF;
+  /// ASSERT_TRUE(error.is<IoError>());
+  /// ASSERT_FALSE(error.is<ParseError>());
+  /// ```
+  template <typename E>
+  [[nodiscard]] bool is() const noexcept {
+    return vtable_ == &internal::dyn_error::vtable<E>;
+  }
+
+  /// Returns a constant reference to the held error if it is of type `E`,
+  /// else returns `None`.
+  ///
+  /// # Examples
+  ///
+  /// Basic usage:
+  ///
+  /// ``` cpp
+  /// DynError error = IoError::EoF;
+  /// ASSERT_EQ(error.downcast<IoError>(), Some(IoError::EoF));
+  /// ASSERT_EQ(error.downcast<ParseError>(), None);
+  /// ```
+  template <typename E>
+  [[nodiscard]] auto downcast() const& noexcept -> Option<ConstRef<E>> {
+    if (is<E>()) {
+      return Some<ConstRef<E>>(ConstRef<E>(
+          *std::launder(reinterpret_cast<E const*>(storage_))));
+    } else {
+      return None;
+    }
+  }
+
+  template <typename E>
+  [[deprecated(
+      "calling DynError::downcast() on an r-value, and therefore binding a "
+      "reference to an object that is marked to be moved")]]  //
+  [[nodiscard]] auto
+  downcast() const&& noexcept->Option<ConstRef<E>> = delete;
+
+  /// Moves the held error out if it is of type `E`, else returns `None`.
+  template <typename E>
+  [[nodiscard]] auto take() && noexcept -> Option<E> {
+    if (is<E>()) {
+      return Some<E>(std::move(*std::launder(reinterpret_cast<E*>(storage_))));
+    } else {
+      return None;
+    }
+  }
+
+ private:
+  template <typename E, typename... Args>
+  void construct(Args&&... args) {
+    new (static_cast<void*>(storage_)) E(std::forward<Args>(args)...);
+  }
+
+  void move_from(DynError& other) noexcept {
+    if (vtable_->move == nullptr) {
+      std::memcpy(storage_, other.storage_, kDynErrorInlineSize);
+    } else {
+      vtable_->move(storage_, other.storage_);
+    }
+  }
+
+  void destroy() noexcept {
+    if (vtable_->destroy != nullptr) vtable_->destroy(storage_);
+  }
+
+  internal::dyn_error::VTable const* vtable_;
+  alignas(kDynErrorAlignment) unsigned char storage_[kDynErrorInlineSize];
+};
+
+/// `Err<F>` converts into a `Result<T, DynError>` if `F` fits in the
+/// `DynError`
+template <typename F>
+struct error_widening<DynError, F> {
+  static constexpr bool value = is_dyn_error_compatible<F>;
+};
+
+[[nodiscard]] inline FixedReport operator>>(ReportQuery,
+                                            DynError const& error) noexcept {
+  return error.report();
+}
+
+STX_END_NAMESPACE
@@ -0,0 +1,247 @@
+/**
+ * @file error_code.h
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-10
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <cerrno>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#include "stx/config.h"
+#include "stx/internal/option_result.h"
+#include "stx/niche.h"
+#include "stx/report.h"
+
+STX_BEGIN_NAMESPACE
+
+/// Static descriptor of a family of error values, i.e. POSIX `errno` values.
+///
+/// Categories are identified by their address and must thus have static
+/// storage duration, preferably as an `inline constexpr` variable.
+///
+/// # Examples
+///
+/// ``` cpp
+/// enum class DbError { Locked = 1, Corrupt = 2 };
+///
+/// inline std::string_view db_error_message(int64_t value) noexcept {
+///   switch (static_cast<DbError>(value)) {
+///     case DbError::Locked:
+///       return "database is locked";
+///     case DbError::Corrupt:
+///       return "database is corrupt";
+///     default:
+///       return "unknown database error";
+///   }
+/// }
+///
+/// inline constexpr ErrorCategory db_error_category{"db", db_error_message};
+///
+/// template <>
+/// struct stx::error_code_traits<DbError> {
+///   static constexpr ErrorCategory const* category = &db_error_category;
+/// };
+/// ```
+struct ErrorCategory {
+  /// name of the category, printed before the error messages
+  std::string_view name;
+
+  /// message describing the error `value`. The message is only read until
+  /// the next call to `message` on the calling thread.
+  std::string_view (*message)(int64_t value) noexcept;
+};
+
+/// Customization point associating an error enum with its `ErrorCategory`,
+/// the enum then implicitly converts into an `ErrorCode` and `TRY_OK`
+/// propagates it into a `Result<T, ErrorCode>`.
+///
+/// A specialization must provide:
+///
+/// - `static constexpr ErrorCategory const* category;`: the enum's category,
+/// the enumerators' values are the error values.
+///
+template <typename E>
+struct error_code_traits {};
+
+template <typename E, typename = void>
+constexpr bool has_error_category = false;
+
+template <typename E>
+constexpr bool has_error_category<
+    E, std::void_t<decltype(error_code_traits<E>::category)>> = true;
+
+namespace internal {
+inline std::string_view errno_message(int64_t value) noexcept {
+  return std::strerror(static_cast<int>(value));
+}
+}  // namespace internal
+
+/// category of the POSIX `errno` values
+inline constexpr ErrorCategory errno_category{"errno",
+                                              internal::errno_message};
+
+//! An error value and its category, similar to `std::error_code`.
+//!
+//! `ErrorCode` is trivially copyable and two words wide: a pointer to the
+//! static `ErrorCategory` and the integer value. Unlike `std::error_code`, it
+//! has no virtual dispatch and no empty state: the category pointer is never
+//! null. The null category is thus a niche, `Result<T, ErrorCode>` stores a
+//! trivially copyable value of up to 8 bytes in place of the error value and
+//! is passed in two registers.
+//!
+//! The message is only looked up and formatted when the error is reported
+//! (i.e. when `unwrap()` panics).
+//!
+//! # Examples
+//!
+//! ``` cpp
+//! auto read_some(int fd, Span<uint8_t> buffer) -> Result<int64_t, ErrorCode> {
+//!   ssize_t size = ::read(fd, buffer.data(), buffer.size());
+//!   if (size < 0) return Err(ErrorCode::from_errno());
+//!   return Ok(static_cast<int64_t>(size));
+//! }
+//! ```
+//!
+struct ErrorCode {
+  constexpr ErrorCode(ErrorCategory const& category, int64_t value) noexcept
+      : category_{&category}, value_{value} {}
+
+  /// converts an error enum with an `ErrorCategory` (see
+  /// `error_code_traits`)
+  template <typename E, std::enable_if_t<has_error_category<E>, int> = 0>
+  constexpr ErrorCode(E error) noexcept
+      : category_{error_code_traits<E>::category},
+        value_{static_cast<int64_t>(error)} {}
+
+  /// the current `errno` value
+  [[nodiscard]] static ErrorCode from_errno() noexcept {
+    return ErrorCode(errno_category, errno);
+  }
+
+  [[nodiscard]] constexpr ErrorCategory const& category() const noexcept {
+    return *category_;
+  }
+
+  [[nodiscard]] constexpr int64_t value() const noexcept { return value_; }
+
+  /// Returns the message describing the error, see `ErrorCategory::message`.
+  ///
+  /// # Examples
+  ///
+  /// Basic usage:
+  ///
+  /// ``` cpp
+  /// ErrorCode error{errno_category, ENOENT};
+  /// ASSERT_EQ(error.message(), "No such file or directory");
+  /// ```
+  [[nodiscard]] std::string_view message() const noexcept {
+    return category_->message(value_);
+  }
+
+  /// Returns `true` if the error is of category `error_code_traits<E>` and
+  /// has `error`'s value.
+  ///
+  /// # Examples
+  ///
+  /// Basic usage:
+  ///
+  /// ``` cpp
+  /// ErrorCode error = DbError::Locked;
+  /// ASSERT_TRUE(error.is(DbError::Locked));
+  /// ASSERT_FALSE(error.is(DbError::Corrupt));
+  /// ```
+  template <typename E, std::enable_if_t<has_error_category<E>, int> = 0>
+  [[nodiscard]] constexpr bool is(E error) const noexcept {
+    return *this == ErrorCode(error);
+  }
+
+  [[nodiscard]] constexpr bool operator==(ErrorCode const& cmp) const noexcept {
+    return category_ == cmp.category_ && value_ == cmp.value_;
+  }
+
+  [[nodiscard]] constexpr bool operator!=(ErrorCode const& cmp) const noexcept {
+    return !(*this == cmp);
+  }
+
+ private:
+  ErrorCategory const* category_;
+  int64_t value_;
+};
+
+/// the null category pointer represents the niche, it is confined to the
+/// first word. The error value's word is free for a packed `Result` value.
+template <>
+struct niche_traits<ErrorCode> {
+  static constexpr bool available = true;
+
+  static constexpr size_t niche_bytes = sizeof(ErrorCategory const*);
+
+  static void set_none(ErrorCode* slot) noexcept {
+    std::memset(static_cast<void*>(slot), 0, niche_bytes);
+  }
+
+  static bool is_none(ErrorCode const* slot) noexcept {
+    ErrorCategory const* category;
+    std::memcpy(&category, static_cast<void const*>(slot), niche_bytes);
+    return category == nullptr;
+  }
+};
+
+/// `Err<E>` converts into a `Result<T, ErrorCode>` if `E` has an
+/// `ErrorCategory`.
+template <typename E>
+struct error_widening<ErrorCode, E> {
+  static constexpr bool value = has_error_category<E>;
+};
+
+/// formats the category's name, message and the error value, i.e. `"errno: No
+/// such file or directory (2)"`
+[[nodiscard]] inline FixedReport operator>>(ReportQuery,
+                                            ErrorCode const& error) noexcept {
+  std::string_view const name = error.category().name;
+  std::string_view const message = error.message();
+  // one more character than the report holds, so it marks longer messages
+  // as truncated
+  char buffer[kReportReserveSize + 2];
+  int const size = std::snprintf(
+      buffer, sizeof(buffer), "%.*s: %.*s (%" PRIi64 ")",
+      static_cast<int>(name.size()), name.data(),
+      static_cast<int>(message.size()), message.data(), error.value());
+  if (size < 0) return FixedReport(kFormatError, kFormatErrorSize);
+  size_t const length = static_cast<size_t>(size) < sizeof(buffer)
+                            ? static_cast<size_t>(size)
+                            : sizeof(buffer) - 1;
+  return FixedReport(std::string_view(buffer, length));
+}
+
+STX_END_NAMESPACE
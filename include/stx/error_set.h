@@ -0,0 +1,599 @@
+/**
+ * @file error_set.h
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-09
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "stx/config.h"
+#include "stx/internal/storage.h"
+#include "stx/option.h"
+#include "stx/result.h"
+
+STX_BEGIN_NAMESPACE
+
+template <typename... E>
+struct ErrorSet;
+
+namespace internal {
+namespace error_set {
+
+template <typename F, typename... E>
+constexpr size_t find() noexcept {
+  constexpr bool matches[] = {std::is_same_v<F, E>..., false};
+  size_t i = 0;
+  while (i < sizeof...(E) && !matches[i]) i++;
+  return i;
+}
+
+// index of `F` in `E...`, `sizeof...(E)` if `F` is not a member
+template <typename F, typename... E>
+constexpr size_t index_of = find<F, E...>();
+
+template <typename... E>
+constexpr bool is_unique() noexcept {
+  constexpr size_t indices[] = {index_of<E, E...>...};
+  for (size_t i = 0; i < sizeof...(E); i++) {
+    if (indices[i] != i) return false;
+  }
+  return true;
+}
+
+// `Set` is an `ErrorSet` whose members are all members of `E...`
+template <typename Set, typename... E>
+constexpr bool is_subset = false;
+
+template <typename... F, typename... E>
+constexpr bool is_subset<ErrorSet<F...>, E...> =
+    ((index_of<F, E...> < sizeof...(E)) && ...);
+
+// `Set`'s members are the leading members of `E...`, in the same order. The
+// indices are thus the same in both sets.
+template <typename Set, typename... E>
+constexpr bool is_prefix = false;
+
+template <typename... F, typename... E>
+constexpr bool is_prefix<ErrorSet<F...>, E...> =
+    is_subset<ErrorSet<F...>, E...> &&
+    std::is_same_v<std::index_sequence<index_of<F, E...>...>,
+                   std::index_sequence_for<F...>>;
+
+template <size_t N>
+using tag_type = std::conditional_t<(N <= 256), uint8_t, uint16_t>;
+
+template <typename R, typename Fn, size_t I>
+R visit_at(Fn& fn) {
+  return fn(std::integral_constant<size_t, I>{});
+}
+
+template <size_t I, size_t N, typename Fn>
+STX_FORCE_INLINE decltype(auto) visit_branches(size_t index, Fn& fn) {
+  if constexpr (I + 1 == N) {
+    return fn(std::integral_constant<size_t, I>{});
+  } else {
+    if (index == I) return fn(std::integral_constant<size_t, I>{});
+    return visit_branches<I + 1, N>(index, fn);
+  }
+}
+
+// calls `fn` with the `index`-th member's `std::integral_constant` index.
+// Small sets are dispatched by comparing the index, which the compiler lowers
+// to a branch or a jump table with the calls inlined, larger ones through a
+// table of function pointers.
+template <typename Fn, size_t... I>
+STX_FORCE_INLINE decltype(auto) visit(size_t index, Fn& fn,
+                                      std::index_sequence<I...>) {
+  if constexpr (sizeof...(I) <= 8) {
+    return visit_branches<0, sizeof...(I)>(index, fn);
+  } else {
+    using R = decltype(fn(std::integral_constant<size_t, 0>{}));
+    static constexpr R (*table[])(Fn&) = {&visit_at<R, Fn, I>...};
+    return table[index](fn);
+  }
+}
+
+// uninitialized storage for the members, the active member is tracked by the
+// enclosing storage's index
+template <bool TriviallyDestructible, typename... E>
+union Members {
+  constexpr Members() noexcept : none_{} {}
+
+  char none_;
+};
+
+template <typename First, typename... Rest>
+union Members<true, First, Rest...> {
+  constexpr Members() noexcept : none_{} {}
+
+  template <size_t I>
+  constexpr auto& get() noexcept {
+    if constexpr (I == 0) {
+      return first_;
+    } else {
+      return rest_.template get<I - 1>();
+    }
+  }
+
+  template <size_t I>
+  constexpr auto const& get() const noexcept {
+    if constexpr (I == 0) {
+      return first_;
+    } else {
+      return rest_.template get<I - 1>();
+    }
+  }
+
+  char none_;
+  First first_;
+  Members<true, Rest...> rest_;
+};
+
+template <typename First, typename... Rest>
+union Members<false, First, Rest...> {
+  constexpr Members() noexcept : none_{} {}
+
+  ~Members() noexcept {}
+
+  template <size_t I>
+  constexpr auto& get() noexcept {
+    if constexpr (I == 0) {
+      return first_;
+    } else {
+      return rest_.template get<I - 1>();
+    }
+  }
+
+  template <size_t I>
+  constexpr auto const& get() const noexcept {
+    if constexpr (I == 0) {
+      return first_;
+    } else {
+      return rest_.template get<I - 1>();
+    }
+  }
+
+  char none_;
+  First first_;
+  Members<false, Rest...> rest_;
+};
+
+// the members are held in a union alongside their index, the `Storage` layers
+// decide whether the copies and moves go through `construct_from` and
+// `assign_from`.
+template <typename... E>
+struct Base {
+  template <size_t I>
+  using member = std::tuple_element_t<I, std::tuple<E...>>;
+
+  explicit Base(uninit_t) noexcept : members_{}, index_{0} {}
+
+  template <size_t I, typename... Args>
+  explicit Base(std::in_place_index_t<I>, Args&&... args)
+      : members_{}, index_{0} {
+    construct<I>(std::forward<Args>(args)...);
+  }
+
+  template <size_t I>
+  [[nodiscard]] member<I>& get() noexcept {
+    return members_.template get<I>();
+  }
+
+  template <size_t I>
+  [[nodiscard]] member<I> const& get() const noexcept {
+    return members_.template get<I>();
+  }
+
+  template <size_t I, typename... Args>
+  void construct(Args&&... args) {
+    new (static_cast<void*>(std::addressof(get<I>())))
+        member<I>(std::forward<Args>(args)...);
+    index_ = static_cast<tag_type<sizeof...(E)>>(I);
+  }
+
+  template <typename Fn>
+  decltype(auto) visit(Fn&& fn) const {
+    return error_set::visit(index_, fn, std::index_sequence_for<E...>{});
+  }
+
+  Members<(std::is_trivially_destructible_v<E> && ...), E...> members_;
+  tag_type<sizeof...(E)> index_;
+};
+
+template <typename... E>
+struct Ops : Base<E...> {
+  using Base<E...>::Base;
+
+  void construct_from(Ops const& rhs) {
+    rhs.visit([&](auto i) {
+      constexpr size_t I = decltype(i)::value;
+      this->template construct<I>(rhs.template get<I>());
+    });
+  }
+
+  void construct_from(Ops&& rhs) {
+    rhs.visit([&](auto i) {
+      constexpr size_t I = decltype(i)::value;
+      this->template construct<I>(std::move(rhs.template get<I>()));
+    });
+  }
+
+  void assign_from(Ops const& rhs) {
+    if (this->index_ == rhs.index_) {
+      rhs.visit([&](auto i) {
+        constexpr size_t I = decltype(i)::value;
+        this->template get<I>() = rhs.template get<I>();
+      });
+    } else {
+      reset();
+      construct_from(rhs);
+    }
+  }
+
+  void assign_from(Ops&& rhs) {
+    if (this->index_ == rhs.index_) {
+      rhs.visit([&](auto i) {
+        constexpr size_t I = decltype(i)::value;
+        this->template get<I>() = std::move(rhs.template get<I>());
+      });
+    } else {
+      reset();
+      construct_from(std::move(rhs));
+    }
+  }
+
+  void reset() noexcept {
+    if constexpr (!(std::is_trivially_destructible_v<E> && ...)) {
+      this->visit([&](auto i) {
+        constexpr size_t I = decltype(i)::value;
+        using M = typename Base<E...>::template member<I>;
+        this->template get<I>().~M();
+      });
+    }
+  }
+};
+
+template <typename... E>
+using Storage = DtorLayer<
+    MoveAssignLayer<
+        CopyAssignLayer<
+            MoveCtorLayer<
+                CopyCtorLayer<Ops<E...>,
+                              (std::is_trivially_copy_constructible_v<E> &&
+                               ...)>,
+                (std::is_trivially_move_constructible_v<E> && ...)>,
+            ((std::is_trivially_copy_constructible_v<E> &&
+              std::is_trivially_copy_assignable_v<E> &&
+              std::is_trivially_destructible_v<E>)&&...)>,
+        ((std::is_trivially_move_constructible_v<E> &&
+          std::is_trivially_move_assignable_v<E> &&
+          std::is_trivially_destructible_v<E>)&&...)>,
+    (std::is_trivially_destructible_v<E> && ...)>;
+
+}  // namespace error_set
+}  // namespace internal
+
+//! A closed set of error types, holding exactly one of `E...`.
+//!
+//! `ErrorSet` is the error type of a function composing several layers that
+//! each report their own error type (typically an enum). Each member is
+//! stored inline (no allocation) alongside the index of the active member, the
+//! index is a `uint8_t` for up to 256 members. An `ErrorSet` of trivially
+//! copyable members is trivially copyable.
+//!
+//! Any member `F`, or a narrower `ErrorSet` whose members all belong to this
+//! one, implicitly converts into the `ErrorSet`. `Err<F>` thus converts into a
+//! `Result<T, ErrorSet<E...>>`, and `TRY_OK` propagates errors of the
+//! narrower types without a `map_err`. Widening a member costs its move and
+//! the index write, widening a set whose members are the leading members of
+//! this one (i.e. `ErrorSet<A, B>` into `ErrorSet<A, B, C>`) keeps the index
+//! as is.
+//!
+//! # Examples
+//!
+//! ``` cpp
+//! enum class IoError { Closed, TimedOut };
+//! enum class ParseError { Truncated, BadChecksum };
+//!
+//! auto read_frame(Socket&) -> Result<Frame, IoError>;
+//! auto parse_frame(Frame&&) -> Result<Message, ParseError>;
+//!
+//! auto receive(Socket& socket)
+//!     -> Result<Message, ErrorSet<IoError, ParseError>> {
+//!   TRY_OK(frame, read_frame(socket));
+//!   TRY_OK(message, parse_frame(std::move(frame)));
+//!   return Ok(std::move(message));
+//! }
+//!
+//! receive(socket).match(
+//!     [](Message message) { ... },
+//!     [](ErrorSet<IoError, ParseError> error) {
+//!       std::move(error).match([](IoError io) { ... },
+//!                              [](ParseError parse) { ... });
+//!     });
+//! ```
+//!
+template <typename... E>
+struct ErrorSet {
+  static_assert(sizeof...(E) > 0, "'ErrorSet' must have at least one member");
+  static_assert(sizeof...(E) <= 65536,
+                "'ErrorSet' can't have more than 65536 members");
+  static_assert((!is_reference<E> && ...),
+                "Cannot use a reference as a member of 'ErrorSet<E...>'");
+  static_assert((movable<E> && ...),
+                "The members of 'ErrorSet<E...>' must be movable");
+  static_assert(internal::error_set::is_unique<E...>(),
+                "The members of 'ErrorSet<E...>' must be distinct");
+
+  /// type of the index of the active member
+  using tag_type = internal::error_set::tag_type<sizeof...(E)>;
+
+  /// number of members
+  static constexpr size_t size = sizeof...(E);
+
+  /// index of the member `F`, `size` if `F` is not a member
+  template <typename F>
+  static constexpr size_t index_of = internal::error_set::index_of<F, E...>;
+
+  /// checks if `F` is a member
+  template <typename F>
+  static constexpr bool contains = index_of<F> < size;
+
+  /// holds `error`
+  template <typename F,
+            std::enable_if_t<contains<std::remove_cv_t<
+                                 std::remove_reference_t<F>>>,
+                             int> = 0>
+  ErrorSet(F&& error)
+      : storage_{std::in_place_index<
+                     index_of<std::remove_cv_t<std::remove_reference_t<F>>>>,
+                 std::forward<F>(error)} {}
+
+  /// constructs the member `F` in-place from `args`
+  template <typename F, typename... Args,
+            std::enable_if_t<contains<F>, int> = 0>
+  explicit ErrorSet(std::in_place_type_t<F>, Args&&... args)
+      : storage_{std::in_place_index<index_of<F>>,
+                 std::forward<Args>(args)...} {}
+
+  /// widens a narrower `ErrorSet` whose members are all members of this one
+  template <typename... F,
+            std::enable_if_t<
+                !std::is_same_v<ErrorSet<F...>, ErrorSet> &&
+                    internal::error_set::is_subset<ErrorSet<F...>, E...>,
+                int> = 0>
+  ErrorSet(ErrorSet<F...>&& other) : storage_{internal::uninit} {
+    if constexpr ((std::is_trivially_copyable_v<F> && ...)) {
+      constexpr tag_type indices[] = {static_cast<tag_type>(index_of<F>)...};
+      std::memcpy(static_cast<void*>(&storage_.members_),
+                  &other.storage_.members_, sizeof(other.storage_.members_));
+      if constexpr (internal::error_set::is_prefix<ErrorSet<F...>, E...>) {
+        storage_.index_ = other.storage_.index_;
+      } else {
+        storage_.index_ = indices[other.storage_.index_];
+      }
+    } else {
+      other.storage_.visit([&](auto i) {
+        constexpr size_t I = decltype(i)::value;
+        using M = typename ErrorSet<F...>::template member<I>;
+        storage_.template construct<index_of<M>>(
+            std::move(other.storage_.template get<I>()));
+      });
+    }
+  }
+
+  ErrorSet(ErrorSet const&) = default;
+  ErrorSet(ErrorSet&&) = default;
+  ErrorSet& operator=(ErrorSet const&) = default;
+  ErrorSet& operator=(ErrorSet&&) = default;
+
+  /// Returns the index of the held member.
+  ///
+  /// # Examples
+  ///
+  /// Basic usage:
+  ///
+  /// ``` cpp
+  /// ErrorSet<IoError, ParseError> error = ParseError::Truncated;
+  /// ASSERT_EQ(error.index(), 1);
+  /// ```
+  [[nodiscard]] size_t index() const noexcept {
+    return storage_.index_;
+  }
+
+  /// Returns `true` if the held member is of type `F`.
+  ///
+  /// # Examples
+  ///
+  /// Basic usage:
+  ///
+  /// ``` cpp
+  /// ErrorSet<IoError, ParseError> error = ParseError::Truncated;
+  /// ASSERT_TRUE(error.is<ParseError>());
+  /// ASSERT_FALSE(error.is<IoError>());
+  /// ```
+  template <typename F>
+  [[nodiscard]] bool is() const noexcept {
+    static_assert(contains<F>, "'F' is not a member of the 'ErrorSet'");
+    return storage_.index_ == index_of<F>;
+  }
+
+  /// Returns a constant reference to the held member if it is of type `F`,
+  /// else returns `None`.
+  ///
+  /// # Examples
+  ///
+  /// Basic usage:
+  ///
+  /// ``` cpp
+  /// ErrorSet<IoError, ParseError> error = ParseError::Truncated;
+  /// ASSERT_EQ(error.get<ParseError>(), Some(ParseError::Truncated));
+  /// ASSERT_EQ(error.get<IoError>(), None);
+  /// ```
+  template <typename F>
+  [[nodiscard]] auto get() const& noexcept -> Option<ConstRef<F>> {
+    static_assert(contains<F>, "'F' is not a member of the 'ErrorSet'");
+    if (is<F>()) {
+      return Some<ConstRef<F>>(
+          ConstRef<F>(storage_.template get<index_of<F>>()));
+    } else {
+      return None;
+    }
+  }
+
+  template <typename F>
+  [[deprecated(
+      "calling ErrorSet::get() on an r-value, and therefore binding a "
+      "reference to an object that is marked to be moved")]]  //
+  [[nodiscard]] auto
+  get() const&& noexcept->Option<ConstRef<F>> = delete;
+
+  /// Moves the held member out if it is of type `F`, else returns `None`.
+  template <typename F>
+  [[nodiscard]] auto take() && -> Option<F> {
+    static_assert(contains<F>, "'F' is not a member of the 'ErrorSet'");
+    if (is<F>()) {
+      return Some<F>(std::move(storage_.template get<index_of<F>>()));
+    } else {
+      return None;
+    }
+  }
+
+  /// Calls the function argument matching the held member, in the order of
+  /// the members. A single function argument is called for any member.
+  ///
+  /// The call is dispatched through a jump table on the member index.
+  ///
+  /// # Examples
+  ///
+  /// Basic usage:
+  ///
+  /// ``` cpp
+  /// ErrorSet<IoError, ParseError> error = ParseError::Truncated;
+  /// auto retry = std::move(error).match(
+  ///     [](IoError io) { return io == IoError::TimedOut; },
+  ///     [](ParseError) { return false; });
+  /// ASSERT_FALSE(retry);
+  /// ```
+  template <typename... Fn>
+  [[nodiscard]] decltype(auto) match(Fn&&... fns) && {
+    static_assert(sizeof...(Fn) == 1 || sizeof...(Fn) == size,
+                  "'match' takes one function argument per member or a "
+                  "single function argument for all of them");
+    auto handlers = std::forward_as_tuple(std::forward<Fn>(fns)...);
+    return storage_.visit([&](auto i) -> decltype(auto) {
+      constexpr size_t I = decltype(i)::value;
+      return std::get<(sizeof...(Fn) == 1 ? 0 : I)>(std::move(handlers))(
+          std::move(storage_.template get<I>()));
+    });
+  }
+
+  template <typename... Fn>
+  [[nodiscard]] decltype(auto) match(Fn&&... fns) & {
+    static_assert(sizeof...(Fn) == 1 || sizeof...(Fn) == size,
+                  "'match' takes one function argument per member or a "
+                  "single function argument for all of them");
+    auto handlers = std::forward_as_tuple(std::forward<Fn>(fns)...);
+    return storage_.visit([&](auto i) -> decltype(auto) {
+      constexpr size_t I = decltype(i)::value;
+      return std::get<(sizeof...(Fn) == 1 ? 0 : I)>(std::move(handlers))(
+          storage_.template get<I>());
+    });
+  }
+
+  template <typename... Fn>
+  [[nodiscard]] decltype(auto) match(Fn&&... fns) const& {
+    static_assert(sizeof...(Fn) == 1 || sizeof...(Fn) == size,
+                  "'match' takes one function argument per member or a "
+                  "single function argument for all of them");
+    auto handlers = std::forward_as_tuple(std::forward<Fn>(fns)...);
+    return storage_.visit([&](auto i) -> decltype(auto) {
+      constexpr size_t I = decltype(i)::value;
+      return std::get<(sizeof...(Fn) == 1 ? 0 : I)>(std::move(handlers))(
+          storage_.template get<I>());
+    });
+  }
+
+  [[nodiscard]] bool operator==(ErrorSet const& cmp) const {
+    static_assert((equality_comparable<E> && ...));
+    if (storage_.index_ != cmp.storage_.index_) return false;
+    return storage_.visit([&](auto i) {
+      constexpr size_t I = decltype(i)::value;
+      return storage_.template get<I>() == cmp.storage_.template get<I>();
+    });
+  }
+
+  [[nodiscard]] bool operator!=(ErrorSet const& cmp) const {
+    return !(*this == cmp);
+  }
+
+  /// compares against a member
+  template <typename F, std::enable_if_t<contains<F>, int> = 0>
+  [[nodiscard]] bool operator==(F const& cmp) const {
+    static_assert(equality_comparable<F>);
+    return is<F>() && storage_.template get<index_of<F>>() == cmp;
+  }
+
+  template <typename F, std::enable_if_t<contains<F>, int> = 0>
+  [[nodiscard]] bool operator!=(F const& cmp) const {
+    return !(*this == cmp);
+  }
+
+ private:
+  template <size_t I>
+  using member = std::tuple_element_t<I, std::tuple<E...>>;
+
+  internal::error_set::Storage<E...> storage_;
+
+  template <typename... F>
+  friend struct ErrorSet;
+};
+
+template <typename... E>
+struct is_trivially_relocatable<ErrorSet<E...>>
+    : std::bool_constant<(trivially_relocatable<E> && ...)> {};
+
+/// `Err<F>` converts into a `Result<T, ErrorSet<E...>>` if `F` is a member or
+/// a narrower `ErrorSet`.
+template <typename... E, typename F>
+struct error_widening<ErrorSet<E...>, F> {
+  static constexpr bool value =
+      ErrorSet<E...>::template contains<F> ||
+      (!std::is_same_v<F, ErrorSet<E...>> &&
+       internal::error_set::is_subset<F, E...>);
+};
+
+STX_END_NAMESPACE
@@ -0,0 +1,265 @@
+/**
+ * @file executor.h
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-20
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "stx/config.h"
+#include "stx/option.h"
+#include "stx/panic.h"
+#include "stx/result.h"
+
+#if defined(STX_NO_STD_THREAD_MUTEX)
+#error "`stx/executor.h` requires std::thread and std::mutex"
+#endif
+
+STX_BEGIN_NAMESPACE
+
+/// The errors of `Executor::submit()`.
+enum class SubmitError : uint8_t {
+  /// the queue the task would be pushed to is full
+  QueueFull,
+  /// the submitting thread is panicking
+  Panicking
+};
+
+class Executor;
+
+namespace internal {
+namespace executor {
+
+// A submitted task. It is referenced by the executor until it has run and by
+// its `TaskHandle`, the last reference frees it.
+struct Job {
+  enum : uint32_t {
+    // the task has run
+    kDone = 1U << 0,
+    // a thread is parked on `state` waiting for the task
+    kWaiting = 1U << 1,
+    // one reference
+    kRef = 1U << 2
+  };
+
+  /// runs the task
+  void (*run)(Job& job) noexcept;
+  /// frees the job
+  void (*free)(Job& job) noexcept;
+  std::string_view name;
+  std::atomic<uint32_t> state{2 * kRef};
+
+  STX_EXPORT void complete() noexcept;
+  STX_EXPORT void wait() noexcept;
+
+  void release() noexcept {
+    if (state.fetch_sub(kRef, std::memory_order_acq_rel) / kRef == 1) {
+      free(*this);
+    }
+  }
+};
+
+template <typename F>
+struct JobImpl : Job {
+  explicit JobImpl(std::string_view task_name, F&& fn) : fn_{std::move(fn)} {
+    name = task_name;
+    run = [](Job& job) noexcept {
+      auto& self = static_cast<JobImpl&>(job);
+      std::move(self.fn_)();
+    };
+    free = [](Job& job) noexcept { delete &static_cast<JobImpl&>(job); };
+  }
+
+  F fn_;
+};
+
+/// panic helper for the methods of a moved-from `TaskHandle`
+[[noreturn]] STX_COLD STX_NOINLINE inline void no_handle() noexcept {
+  panic("called a method on a moved-from `TaskHandle`");
+}
+
+}  // namespace executor
+}  // namespace internal
+
+/// A reference to a submitted task, used to wait for it.
+class TaskHandle {
+ public:
+  TaskHandle(TaskHandle&& other) noexcept
+      : job_{std::exchange(other.job_, nullptr)} {}
+
+  TaskHandle& operator=(TaskHandle&& other) noexcept {
+    if (this != &other) {
+      if (job_ != nullptr) job_->release();
+      job_ = std::exchange(other.job_, nullptr);
+    }
+    return *this;
+  }
+
+  TaskHandle(TaskHandle const&) = delete;
+  TaskHandle& operator=(TaskHandle const&) = delete;
+
+  ~TaskHandle() {
+    if (job_ != nullptr) job_->release();
+  }
+
+  /// the name the task was submitted with
+  [[nodiscard]] std::string_view name() const noexcept {
+    STX_EXPECTS(job_ != nullptr, internal::executor::no_handle());
+    return job_->name;
+  }
+
+  /// Returns `true` if the task has run.
+  [[nodiscard]] bool is_done() const noexcept {
+    STX_EXPECTS(job_ != nullptr, internal::executor::no_handle());
+    return (job_->state.load(std::memory_order_acquire) &
+            internal::executor::Job::kDone) != 0;
+  }
+
+  /// Blocks until the task has run.
+  void wait() const noexcept {
+    STX_EXPECTS(job_ != nullptr, internal::executor::no_handle());
+    job_->wait();
+  }
+
+ private:
+  explicit TaskHandle(internal::executor::Job* job) noexcept : job_{job} {}
+
+  internal::executor::Job* job_;
+
+  friend class Executor;
+};
+
+//! A work-stealing thread pool.
+//!
+//! Every worker owns a bounded Chase-Lev deque: tasks submitted by a worker
+//! are pushed to and popped from the bottom of its deque without
+//! synchronization with the other workers, idle workers steal from the top of
+//! the other workers' deques. Tasks submitted by other threads go through a
+//! shared bounded injection queue. Idle workers park on a futex.
+//!
+//! `submit()` doesn't throw or block when the queue is full, it returns
+//! `SubmitError::QueueFull` instead.
+//!
+//! # Panics
+//!
+//! A task that panics is recorded against the worker running it: before the
+//! panic hook is called, the worker ID and the task's name are reported to
+//! stderr and are queried from a panic hook with `this_worker::id()` and
+//! `this_worker::task_name()`.
+//!
+//! # Examples
+//!
+//! ``` cpp
+//! Executor executor{4};
+//!
+//! TRY_OK(handle, executor.submit("resize", [&] { resize(image); }));
+//! handle.wait();
+//! ```
+//!
+class Executor {
+ public:
+  /// default capacity of each worker's deque and of the injection queue
+  static constexpr size_t kDefaultQueueCapacity = 4096;
+
+  /// starts `num_workers` worker threads, whose deques and the injection
+  /// queue hold up to `queue_capacity` tasks (rounded up to a power of two).
+  STX_EXPORT explicit Executor(size_t num_workers,
+                               size_t queue_capacity = kDefaultQueueCapacity);
+
+  Executor(Executor const&) = delete;
+  Executor& operator=(Executor const&) = delete;
+  Executor(Executor&&) = delete;
+  Executor& operator=(Executor&&) = delete;
+
+  /// runs the submitted tasks and joins the workers.
+  STX_EXPORT ~Executor();
+
+  [[nodiscard]] size_t num_workers() const noexcept { return num_workers_; }
+
+  /// Submits `task` to be run by one of the workers. A task submitted by a
+  /// worker is pushed to the worker's deque, else to the injection queue.
+  ///
+  /// `name` identifies the task in panic reports and must outlive the task.
+  ///
+  /// Returns a handle to the task, `SubmitError::QueueFull` if the queue is
+  /// full, or `SubmitError::Panicking` if the calling thread is panicking.
+  ///
+  /// # Examples
+  ///
+  /// Basic usage:
+  ///
+  /// ``` cpp
+  /// auto handle = executor.submit("flush", [&] { log.flush(); });
+  /// if (handle.is_err()) log.flush();  // run it inline
+  /// ```
+  template <typename F>
+  [[nodiscard]] Result<TaskHandle, SubmitError> submit(std::string_view name,
+                                                       F&& task) {
+    static_assert(std::is_invocable_v<std::decay_t<F>&&>,
+                  "the task must be callable without arguments");
+    auto* job = new internal::executor::JobImpl<std::decay_t<F>>{
+        name, std::decay_t<F>{std::forward<F>(task)}};
+    if (auto error = push(job); error.is_some()) {
+      // both references
+      job->free(*job);
+      return Err<SubmitError>(std::move(error).unwrap());
+    }
+    return Ok(TaskHandle{job});
+  }
+
+  /// Blocks until all of the submitted tasks, including the tasks they
+  /// submit, have run. It must not be called from a task.
+  STX_EXPORT void wait_idle() noexcept;
+
+ private:
+  struct State;
+
+  STX_EXPORT Option<SubmitError> push(internal::executor::Job* job) noexcept;
+
+  size_t num_workers_;
+  std::unique_ptr<State> state_;
+};
+
+namespace this_worker {
+
+/// the ID of the calling thread if it is a worker of an `Executor`
+[[nodiscard]] STX_EXPORT Option<size_t> id() noexcept;
+
+/// the name of the task the calling worker is running
+[[nodiscard]] STX_EXPORT Option<std::string_view> task_name() noexcept;
+
+}  // namespace this_worker
+
+STX_END_NAMESPACE
@@ -0,0 +1,544 @@
+/**
+ * @file future.h
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-20
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "stx/config.h"
+#include "stx/internal/futex.h"
+#include "stx/panic.h"
+#include "stx/panic/hook.h"
+#include "stx/result.h"
+
+STX_BEGIN_NAMESPACE
+
+/// The errors a `Future` resolves to when its `Promise` is not fulfilled.
+enum class FutureError : uint8_t {
+  /// the producer panicked while computing the value
+  Panicked,
+  /// the `Promise` was destroyed without being fulfilled
+  BrokenPromise
+};
+
+template <typename T, typename E>
+class FutureSlot;
+
+template <typename T, typename E>
+class Promise;
+
+template <typename T, typename E>
+class Future;
+
+/// the two ends of a `FutureSlot`
+template <typename T, typename E>
+struct FuturePair {
+  Promise<T, E> promise;
+  Future<T, E> future;
+};
+
+namespace internal {
+namespace future {
+
+// the bits of a slot's state word
+enum : uint32_t {
+  // the result has been constructed
+  kReady = 1U << 0,
+  // at least one thread is parked on the word
+  kWaiting = 1U << 1,
+  // a continuation has been attached
+  kContinuation = 1U << 2,
+  // the `Promise` is alive
+  kPromise = 1U << 3,
+  // the `Future`, or its continuation, is alive
+  kFuture = 1U << 4,
+  // both ends
+  kEnds = kPromise | kFuture,
+  // the last end is waking the threads parked on the word, the slot must not
+  // be destroyed or reused until it is cleared
+  kReleasing = 1U << 5
+};
+
+/// size of the inline storage of a continuation
+constexpr size_t kContinuationSize = 4 * sizeof(void*);
+
+/// number of times `Future::get()` checks the state before parking
+constexpr size_t kSpinCount = 64;
+
+/// panic helper for `make_future()` on a slot whose ends are still alive
+[[noreturn]] STX_COLD STX_NOINLINE inline void slot_in_use() noexcept {
+  panic("called `make_future()` on a `FutureSlot` that is in use");
+}
+
+/// panic helper for the methods of a moved-from `Future`
+[[noreturn]] STX_COLD STX_NOINLINE inline void no_future() noexcept {
+  panic("called a method on a moved-from `Future`");
+}
+
+/// panic helper for `Promise::fulfill()` on a moved-from promise
+[[noreturn]] STX_COLD STX_NOINLINE inline void no_promise() noexcept {
+  panic("called `Promise::fulfill()` on a moved-from `Promise`");
+}
+
+}  // namespace future
+}  // namespace internal
+
+//! The shared state of a `Promise<T, E>` and a `Future<T, E>`.
+//!
+//! The slot holds a single atomic word (the state, also used to park the
+//! waiting threads), the inline storage of the `Result<T, E>` and the inline
+//! storage of a continuation. A caller-provided slot is thus a handoff between
+//! threads that never allocates; `make_future<T, E>()` allocates the slot
+//! instead.
+//!
+//! The slot must outlive its promise and future. Its destructor waits for them
+//! to release it, a thread returning from `Future::get()` can thus destroy the
+//! slot while the producer is still returning from `Promise::fulfill()`. A
+//! slot can be reused once its promise and future are gone.
+//!
+//! # Examples
+//!
+//! ``` cpp
+//! FutureSlot<Response, ErrorSet<IoError, FutureError>> slot;
+//! auto [promise, future] = make_future(slot);
+//!
+//! std::thread producer{[promise = std::move(promise)]() mutable {
+//!   std::move(promise).fulfill_with([] { return fetch(); });
+//! }};
+//!
+//! TRY_OK(response, std::move(future).get());
+//! ```
+//!
+template <typename T, typename E>
+class FutureSlot {
+ public:
+  static_assert(std::is_constructible_v<E, FutureError>,
+                "the error type of a 'Future' must be constructible from "
+                "'FutureError'");
+
+  FutureSlot() noexcept : word_{0} {}
+
+  FutureSlot(FutureSlot const&) = delete;
+  FutureSlot& operator=(FutureSlot const&) = delete;
+  FutureSlot(FutureSlot&&) = delete;
+  FutureSlot& operator=(FutureSlot&&) = delete;
+
+  ~FutureSlot() {
+    uint32_t word = word_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < internal::future::kSpinCount &&
+                       (word & internal::future::kEnds) != 0;
+         i++) {
+      word = word_.load(std::memory_order_acquire);
+    }
+
+    // parks until the last end is released
+    while ((word & internal::future::kEnds) != 0) {
+      if ((word & internal::future::kWaiting) == 0 &&
+          !word_.compare_exchange_weak(word, word | internal::future::kWaiting,
+                                       std::memory_order_acquire)) {
+        continue;
+      }
+      internal::futex::wait(word_, word | internal::future::kWaiting);
+      word = word_.load(std::memory_order_acquire);
+    }
+
+    word = settle(word);
+    if ((word & internal::future::kReady) != 0) result().~Result();
+  }
+
+ private:
+  using Deleter = void (*)(FutureSlot* slot) noexcept;
+
+  FutureSlot(uint32_t word, Deleter deleter) noexcept
+      : word_{word}, deleter_{deleter} {}
+
+  /// the result, constructed once the slot is ready
+  Result<T, E>& result() noexcept {
+    return *std::launder(reinterpret_cast<Result<T, E>*>(result_));
+  }
+
+  /// constructs the result in place from `args` and publishes it
+  template <typename... Args>
+  void resolve(Args&&... args) noexcept {
+    new (result_) Result<T, E>(std::forward<Args>(args)...);
+    publish();
+  }
+
+  /// marks the constructed result ready and wakes the waiters or runs the
+  /// continuation
+  void publish() noexcept {
+    uint32_t const previous =
+        word_.fetch_or(internal::future::kReady, std::memory_order_acq_rel);
+    if ((previous & internal::future::kWaiting) != 0) {
+      internal::futex::wake_all(word_);
+    }
+    if ((previous & internal::future::kContinuation) != 0) {
+      run_continuation();
+    }
+    release(internal::future::kPromise);
+  }
+
+  void run_continuation() noexcept {
+    invoke_(continuation_, std::move(result()));
+    release(internal::future::kFuture);
+  }
+
+  /// releases the end `bit`. the last end frees an allocated slot, or wakes
+  /// the destructor of a caller-provided slot.
+  void release(uint32_t bit) noexcept {
+    // read before the release, the owner can destroy a caller-provided slot
+    // as soon as its last end is released
+    Deleter const deleter = deleter_;
+    if (deleter != nullptr) {
+      uint32_t const previous =
+          word_.fetch_and(~bit, std::memory_order_acq_rel);
+      if ((previous & internal::future::kEnds & ~bit) == 0) deleter(this);
+      return;
+    }
+
+    // the last end wakes the parked threads while holding `kReleasing`, which
+    // keeps the destructor from returning until the word is no longer used
+    uint32_t word = word_.load(std::memory_order_relaxed);
+    uint32_t next = 0;
+    do {
+      next = word & ~bit;
+      if ((next & internal::future::kEnds) == 0 &&
+          (next & internal::future::kWaiting) != 0) {
+        next |= internal::future::kReleasing;
+      }
+    } while (!word_.compare_exchange_weak(word, next, std::memory_order_acq_rel,
+                                          std::memory_order_relaxed));
+
+    if ((next & internal::future::kReleasing) != 0) {
+      internal::futex::wake_all(word_);
+      word_.fetch_and(~internal::future::kReleasing, std::memory_order_release);
+    }
+  }
+
+  /// waits for the last end to be done waking the parked threads, returns
+  /// the state word
+  uint32_t settle(uint32_t word) noexcept {
+    while ((word & internal::future::kReleasing) != 0) {
+      std::this_thread::yield();
+      word = word_.load(std::memory_order_acquire);
+    }
+    return word;
+  }
+
+  std::atomic<uint32_t> word_;
+
+  // frees a slot allocated by `make_future()`, `nullptr` for a
+  // caller-provided slot
+  Deleter deleter_ = nullptr;
+
+  alignas(Result<T, E>) unsigned char result_[sizeof(Result<T, E>)];
+
+  // calls the continuation with the result and destroys it
+  void (*invoke_)(void* continuation, Result<T, E>&& result) noexcept =
+      nullptr;
+  alignas(std::max_align_t) unsigned char
+      continuation_[internal::future::kContinuationSize];
+
+  friend class Promise<T, E>;
+  friend class Future<T, E>;
+
+  template <typename U, typename F>
+  friend FuturePair<U, F> make_future(FutureSlot<U, F>& slot);
+
+  template <typename U, typename F>
+  friend FuturePair<U, F> make_future();
+};
+
+//! The producing end of a `FutureSlot`, fulfilled once with a `Result<T, E>`.
+//!
+//! A promise destroyed without being fulfilled resolves its future to
+//! `FutureError::BrokenPromise`, or `FutureError::Panicked` if the thread is
+//! panicking.
+//!
+template <typename T, typename E>
+class Promise {
+ public:
+  Promise(Promise&& other) noexcept
+      : slot_{std::exchange(other.slot_, nullptr)} {}
+
+  Promise& operator=(Promise&& other) noexcept {
+    if (this != &other) {
+      abandon();
+      slot_ = std::exchange(other.slot_, nullptr);
+    }
+    return *this;
+  }
+
+  Promise(Promise const&) = delete;
+  Promise& operator=(Promise const&) = delete;
+
+  ~Promise() { abandon(); }
+
+  /// Resolves the future to `result`, waking the threads waiting on it or
+  /// running its continuation on the calling thread.
+  void fulfill(Result<T, E>&& result) && noexcept {
+    STX_EXPECTS(slot_ != nullptr, internal::future::no_promise());
+    std::exchange(slot_, nullptr)->resolve(std::move(result));
+  }
+
+  /// Resolves the future to the result of `producer()`.
+  ///
+  /// If `producer` panics, the future is resolved to `FutureError::Panicked`
+  /// before the panic hook is called. The threads waiting on the future thus
+  /// don't hang if the panic hook halts the thread instead of aborting.
+  template <typename F>
+  void fulfill_with(F&& producer) && {
+    static_assert(std::is_invocable_r_v<Result<T, E>, F&&>);
+    STX_EXPECTS(slot_ != nullptr, internal::future::no_promise());
+    {
+      ScopedPanicGuard guard{
+          [](void* context) noexcept {
+            Promise& promise = *static_cast<Promise*>(context);
+            if (promise.slot_ != nullptr) {
+              std::exchange(promise.slot_, nullptr)
+                  ->resolve(Err<E>(E(FutureError::Panicked)));
+            }
+          },
+          this};
+      // constructed in place: the producer's result is never moved
+      new (slot_->result_) Result<T, E>(std::forward<F>(producer)());
+    }
+    std::exchange(slot_, nullptr)->publish();
+  }
+
+ private:
+  explicit Promise(FutureSlot<T, E>* slot) noexcept : slot_{slot} {}
+
+  void abandon() noexcept {
+    if (slot_ != nullptr) {
+      std::exchange(slot_, nullptr)
+          ->resolve(Err<E>(E(this_thread::is_panicking()
+                                 ? FutureError::Panicked
+                                 : FutureError::BrokenPromise)));
+    }
+  }
+
+  FutureSlot<T, E>* slot_;
+
+  template <typename U, typename F>
+  friend FuturePair<U, F> make_future(FutureSlot<U, F>& slot);
+
+  template <typename U, typename F>
+  friend FuturePair<U, F> make_future();
+};
+
+//! The consuming end of a `FutureSlot`, resolved once to a `Result<T, E>`.
+//!
+//! The result is taken by blocking in `get()`, which parks the thread on the
+//! slot's state word (a futex on Linux), or by attaching a continuation with
+//! `then()`.
+//!
+template <typename T, typename E>
+class Future {
+ public:
+  Future(Future&& other) noexcept
+      : slot_{std::exchange(other.slot_, nullptr)} {}
+
+  Future& operator=(Future&& other) noexcept {
+    if (this != &other) {
+      if (slot_ != nullptr) slot_->release(internal::future::kFuture);
+      slot_ = std::exchange(other.slot_, nullptr);
+    }
+    return *this;
+  }
+
+  Future(Future const&) = delete;
+  Future& operator=(Future const&) = delete;
+
+  ~Future() {
+    if (slot_ != nullptr) slot_->release(internal::future::kFuture);
+  }
+
+  /// Returns `true` if the promise has been fulfilled, `get()` then returns
+  /// without blocking.
+  [[nodiscard]] bool is_ready() const noexcept {
+    STX_EXPECTS(slot_ != nullptr, internal::future::no_future());
+    return (slot_->word_.load(std::memory_order_acquire) &
+            internal::future::kReady) != 0;
+  }
+
+  /// Blocks until the promise is fulfilled and returns the result.
+  ///
+  /// # Examples
+  ///
+  /// Basic usage:
+  ///
+  /// ``` cpp
+  /// FutureSlot<int, FutureError> slot;
+  /// auto [promise, future] = make_future(slot);
+  /// std::move(promise).fulfill(Ok(42));
+  /// ASSERT_EQ(std::move(future).get(), Ok(42));
+  /// ```
+  [[nodiscard]] Result<T, E> get() && noexcept {
+    STX_EXPECTS(slot_ != nullptr, internal::future::no_future());
+    FutureSlot<T, E>& slot = *std::exchange(slot_, nullptr);
+    std::atomic<uint32_t>& word = slot.word_;
+
+    uint32_t state = word.load(std::memory_order_acquire);
+    for (size_t i = 0;
+         i < internal::future::kSpinCount &&
+         (state & internal::future::kReady) == 0;
+         i++) {
+      state = word.load(std::memory_order_acquire);
+    }
+
+    while ((state & internal::future::kReady) == 0) {
+      if ((state & internal::future::kWaiting) == 0 &&
+          !word.compare_exchange_weak(state,
+                                      state | internal::future::kWaiting,
+                                      std::memory_order_acquire)) {
+        continue;
+      }
+      internal::futex::wait(word, state | internal::future::kWaiting);
+      state = word.load(std::memory_order_acquire);
+    }
+
+    Result<T, E> result{std::move(slot.result())};
+    slot.release(internal::future::kFuture);
+    return result;
+  }
+
+  /// Calls `continuation(Result<T, E>&&)` once the promise is fulfilled: on
+  /// the thread fulfilling the promise, or on the calling thread if it
+  /// already is.
+  ///
+  /// The continuation is stored inline in the slot and must fit in
+  /// `4 * sizeof(void*)` bytes.
+  ///
+  /// # Examples
+  ///
+  /// Basic usage:
+  ///
+  /// ``` cpp
+  /// std::move(future).then([&log](Result<int, FutureError>&& result) {
+  ///   log.push(std::move(result));
+  /// });
+  /// ```
+  template <typename F>
+  void then(F&& continuation) && noexcept {
+    using Fn = std::decay_t<F>;
+    static_assert(sizeof(Fn) <= internal::future::kContinuationSize &&
+                      alignof(Fn) <= alignof(std::max_align_t),
+                  "the continuation must fit in 'kContinuationSize' bytes");
+    static_assert(std::is_invocable_v<Fn&&, Result<T, E>&&>);
+    STX_EXPECTS(slot_ != nullptr, internal::future::no_future());
+
+    FutureSlot<T, E>& slot = *std::exchange(slot_, nullptr);
+    new (slot.continuation_) Fn{std::forward<F>(continuation)};
+    slot.invoke_ = [](void* storage, Result<T, E>&& result) noexcept {
+      Fn& fn = *std::launder(static_cast<Fn*>(storage));
+      std::move(fn)(std::move(result));
+      fn.~Fn();
+    };
+
+    uint32_t const previous = slot.word_.fetch_or(
+        internal::future::kContinuation, std::memory_order_acq_rel);
+    if ((previous & internal::future::kReady) != 0) slot.run_continuation();
+  }
+
+  /// Chains a continuation transforming the result: `next` is resolved to
+  /// `transform(Result<T, E>&&)` once this future is.
+  ///
+  /// # Examples
+  ///
+  /// Basic usage:
+  ///
+  /// ``` cpp
+  /// FutureSlot<int, FutureError> slot;
+  /// FutureSlot<string, FutureError> next;
+  /// auto [promise, future] = make_future(slot);
+  ///
+  /// Future<string, FutureError> text = std::move(future).then(
+  ///     next, [](Result<int, FutureError>&& result) {
+  ///       return std::move(result).map([](int x) { return to_string(x); });
+  ///     });
+  /// ```
+  template <typename U, typename F>
+  [[nodiscard]] Future<U, E> then(FutureSlot<U, E>& next,
+                                  F&& transform) && noexcept {
+    auto [promise, future] = make_future(next);
+    std::move(*this).then(
+        [promise = std::move(promise),
+         transform = std::forward<F>(transform)](
+            Result<T, E>&& result) mutable noexcept {
+          std::move(promise).fulfill(
+              Result<U, E>{std::move(transform)(std::move(result))});
+        });
+    return std::move(future);
+  }
+
+ private:
+  explicit Future(FutureSlot<T, E>* slot) noexcept : slot_{slot} {}
+
+  FutureSlot<T, E>* slot_;
+
+  template <typename U, typename F>
+  friend FuturePair<U, F> make_future(FutureSlot<U, F>& slot);
+
+  template <typename U, typename F>
+  friend FuturePair<U, F> make_future();
+};
+
+/// Creates the promise and future of `slot`, which must outlive them. The slot
+/// must not be in use.
+template <typename T, typename E>
+[[nodiscard]] FuturePair<T, E> make_future(FutureSlot<T, E>& slot) {
+  uint32_t const word =
+      slot.settle(slot.word_.load(std::memory_order_acquire));
+  STX_EXPECTS((word & internal::future::kEnds) == 0,
+              internal::future::slot_in_use());
+  if ((word & internal::future::kReady) != 0) slot.result().~Result();
+  slot.word_.store(internal::future::kPromise | internal::future::kFuture,
+                   std::memory_order_relaxed);
+  return FuturePair<T, E>{Promise<T, E>{&slot}, Future<T, E>{&slot}};
+}
+
+/// Creates a promise and a future sharing an allocated slot, which is freed
+/// once both are gone.
+template <typename T, typename E>
+[[nodiscard]] FuturePair<T, E> make_future() {
+  auto* slot = new FutureSlot<T, E>{
+      internal::future::kEnds,
+      [](FutureSlot<T, E>* allocated) noexcept { delete allocated; }};
+  return FuturePair<T, E>{Promise<T, E>{slot}, Future<T, E>{slot}};
+}
+
+STX_END_NAMESPACE
@@ -0,0 +1,155 @@
+/**
+ * @file bitmask.h
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-18
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "stx/config.h"
+
+// Scans over packed bitmasks, one bit per element.
+//
+// The containers storing the state of their elements out of line
+// (`ResultVec`, `OptionVec`, ...) keep one bit per element in an array of
+// 64-bit words. The scans below process a whole word, 64 elements, per
+// iteration: counting uses a population count, searching and iterating the
+// set bits use a count of trailing zeros.
+//
+// The bits past the last element of the last word are always clear.
+
+STX_BEGIN_NAMESPACE
+
+namespace internal {
+namespace bitmask {
+
+constexpr size_t kWordBits = 64;
+
+constexpr size_t words_for(size_t bits) noexcept {
+  return (bits + kWordBits - 1) / kWordBits;
+}
+
+// x86 only has a population count instruction from SSE4.2 on, the builtin
+// is otherwise a call into the compiler's runtime. The SWAR count below is
+// inlined and vectorized by the compiler when counting a whole bitmask.
+inline size_t popcount(uint64_t word) noexcept {
+#if STX_HAS_BUILTIN(popcountll) && \
+    (defined(__POPCNT__) || !(STX_ARCH_X86 || STX_ARCH_X86_64))
+  return static_cast<size_t>(__builtin_popcountll(word));
+#else
+  word = word - ((word >> 1) & 0x5555555555555555ULL);
+  word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+  word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return static_cast<size_t>((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+// `word` must not be 0
+inline size_t count_trailing_zeros(uint64_t word) noexcept {
+#if STX_HAS_BUILTIN(ctzll)
+  return static_cast<size_t>(__builtin_ctzll(word));
+#else
+  size_t count = 0;
+  for (; (word & 1) == 0; word >>= 1) count++;
+  return count;
+#endif
+}
+
+inline bool get(uint64_t const* words, size_t index) noexcept {
+  return (words[index / kWordBits] >> (index % kWordBits)) & 1;
+}
+
+inline void set(uint64_t* words, size_t index) noexcept {
+  words[index / kWordBits] |= uint64_t{1} << (index % kWordBits);
+}
+
+inline void clear(uint64_t* words, size_t index) noexcept {
+  words[index / kWordBits] &= ~(uint64_t{1} << (index % kWordBits));
+}
+
+// number of set bits in the first `bits` bits
+inline size_t count(uint64_t const* words, size_t bits) noexcept {
+  size_t total = 0;
+  size_t const num_words = words_for(bits);
+  for (size_t i = 0; i < num_words; i++) total += popcount(words[i]);
+  return total;
+}
+
+// index of the first clear bit in the first `bits` bits, or `bits` if all
+// of them are set
+inline size_t find_first_clear(uint64_t const* words, size_t bits) noexcept {
+  size_t const num_words = words_for(bits);
+  for (size_t i = 0; i < num_words; i++) {
+    if (words[i] != ~uint64_t{0}) {
+      size_t const index = i * kWordBits + count_trailing_zeros(~words[i]);
+      return index < bits ? index : bits;
+    }
+  }
+  return bits;
+}
+
+// index of the first set bit in the first `bits` bits, or `bits` if none is
+inline size_t find_first_set(uint64_t const* words, size_t bits) noexcept {
+  size_t const num_words = words_for(bits);
+  for (size_t i = 0; i < num_words; i++) {
+    if (words[i] != 0) return i * kWordBits + count_trailing_zeros(words[i]);
+  }
+  return bits;
+}
+
+// calls `fn(index)` for each set bit in the first `bits` bits, in order
+template <typename Fn>
+void for_each_set(uint64_t const* words, size_t bits, Fn&& fn) {
+  size_t const num_words = words_for(bits);
+  for (size_t i = 0; i < num_words; i++) {
+    for (uint64_t word = words[i]; word != 0; word &= word - 1) {
+      fn(i * kWordBits + count_trailing_zeros(word));
+    }
+  }
+}
+
+// calls `fn(index)` for each clear bit in the first `bits` bits, in order
+template <typename Fn>
+void for_each_clear(uint64_t const* words, size_t bits, Fn&& fn) {
+  size_t const num_words = words_for(bits);
+  for (size_t i = 0; i < num_words; i++) {
+    uint64_t word = ~words[i];
+    if (i == num_words - 1 && bits % kWordBits != 0) {
+      word &= (uint64_t{1} << (bits % kWordBits)) - 1;
+    }
+    for (; word != 0; word &= word - 1) {
+      fn(i * kWordBits + count_trailing_zeros(word));
+    }
+  }
+}
+
+}  // namespace bitmask
+}  // namespace internal
+
+STX_END_NAMESPACE
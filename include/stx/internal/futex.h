@@ -0,0 +1,60 @@
+/**
+ * @file futex.h
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-20
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "stx/config.h"
+
+STX_BEGIN_NAMESPACE
+
+namespace internal {
+namespace futex {
+
+// Parking of threads on a 32-bit atomic word. This uses the `futex` system
+// call on Linux and C++20's `std::atomic::wait` elsewhere (or yields the
+// thread if it is unavailable).
+
+/// Blocks the calling thread while `word` holds `expected`. The thread can
+/// wake up spuriously, the caller is expected to check the word again.
+STX_EXPORT void wait(std::atomic<uint32_t>& word, uint32_t expected) noexcept;
+
+/// Wakes one of the threads blocked on `word`.
+STX_EXPORT void wake_one(std::atomic<uint32_t>& word) noexcept;
+
+/// Wakes all of the threads blocked on `word`.
+STX_EXPORT void wake_all(std::atomic<uint32_t>& word) noexcept;
+
+}  // namespace futex
+}  // namespace internal
+
+STX_END_NAMESPACE
@@ -32,6 +32,9 @@
 #include <utility>
 
 #include "stx/internal/panic_helpers.h"
+#include "stx/internal/select.h"
+#include "stx/internal/storage.h"
+#include "stx/relocation.h"
 
 // Why so long? Option and Result depend on each other. I don't know of a
 // way to break the cyclic dependency, primarily because they are templated
@@ -298,6 +301,43 @@ struct [[nodiscard]] Ok {
   friend struct Result;
 };
 
+//! success variant for `Result<void, E>`, it carries no value.
+//!
+//! ```cpp
+//! Result<void, int> a = Ok();
+//! ```
+//!
+//! # Constexpr ?
+//!
+//! C++ 17 and above
+//!
+template <>
+struct [[nodiscard]] Ok<void> {
+  using value_type = void;
+
+  constexpr Ok() noexcept = default;
+
+  [[nodiscard]] constexpr bool operator==(Ok<void> const&) const noexcept {
+    return true;
+  }
+
+  [[nodiscard]] constexpr bool operator!=(Ok<void> const&) const noexcept {
+    return false;
+  }
+
+  template <typename U>
+  [[nodiscard]] constexpr bool operator==(Err<U> const&) const noexcept {
+    return false;
+  }
+
+  template <typename U>
+  [[nodiscard]] constexpr bool operator!=(Err<U> const&) const noexcept {
+    return true;
+  }
+};
+
+Ok()->Ok<void>;
+
 //! error-value variant for `Result<T, E>` wrapping the contained error value of
 //! type `E`
 //!
@@ -383,6 +423,33 @@ struct [[nodiscard]] Err {
   friend struct Result;
 };
 
+//! tag type for constructing the error of a `Result<T, E>` in-place
+//!
+//! # Constexpr ?
+//!
+//! C++ 17 and above
+//!
+struct ErrInPlaceType {
+  explicit constexpr ErrInPlaceType() noexcept = default;
+};
+
+/// tag for constructing the error of a `Result<T, E>` in-place. The value is
+/// constructed in-place with `std::in_place`.
+constexpr ErrInPlaceType const err_in_place{};
+
+//! Customization point allowing an `Err<F>` to implicitly convert into a
+//! `Result<T, E>` with a wider error type `E`. i.e. for `TRY_OK` to propagate
+//! a narrower error from a function returning `Result<T, E>` without a
+//! `map_err`.
+//!
+//! A specialization must provide `static constexpr bool value = true;` and
+//! `E` must be constructible from an r-value `F`. See `ErrorSet`.
+//!
+template <typename E, typename F>
+struct error_widening {
+  static constexpr bool value = false;
+};
+
 // JUST LOOK AWAY
 
 namespace internal {
@@ -393,6 +460,10 @@ namespace option {
 template <typename Tp>
 inline Tp&& unsafe_value_move(Option<Tp>&);
 
+// coroutine promise of `Option`-returning coroutines, see `stx/coroutine.h`
+template <typename Tp>
+struct Promise;
+
 }  // namespace option
 }  // namespace internal
 
@@ -438,12 +509,19 @@ inline Tp&& unsafe_value_move(Option<Tp>&);
 //!
 //! C++ 20 and above
 //!
+//! # Layout
+//!
+//! If `T` has a niche (see `niche_traits`), the niche represents `None` and
+//! no discriminant is stored. i.e. `Option<Ref<T>>` and `Option<T*>` use the
+//! null pointer to represent `None` and are thus pointer-sized, `Span::at`
+//! returns its result in a single register. As a consequence, `Some` can not
+//! contain a null pointer: `Option<int*>(Some<int*>(nullptr))` is `None`.
+//!
 template <typename T>
 struct [[nodiscard]] Option {
  public:
   using value_type = T;
 
-  static_assert(movable<T>, "Value type 'T' for 'Option<T>' must be movable");
   static_assert(
       !is_reference<T>,
       "Cannot use a reference for value type 'T' of 'Option<T>' , To prevent "
@@ -451,75 +529,40 @@ struct [[nodiscard]] Option {
       "type wrappers like std::reference_wrapper (stx::Ref) or any of the "
       "`stx::ConstRef` or `stx::MutRef` specialized aliases instead");
 
-  constexpr Option() noexcept : is_none_(true) {}
+  constexpr Option() noexcept : storage_{} {}
 
   constexpr Option(Some<T> && some)
-      : storage_value_(std::move(some.value_)), is_none_(false) {}
+      : storage_{std::in_place, std::move(some.value_)} {}
 
   constexpr Option(Some<T> const& some)
-      : storage_value_(some.value()), is_none_(false) {
-    static_assert(copy_constructible<T>);
-  }
-
-  constexpr Option(NoneType const&) noexcept : is_none_(true) {}
-
-  // constexpr?
-  // placement-new!
-  // we can't make this constexpr as of C++ 20
-  Option(Option && rhs) : is_none_(rhs.is_none_) {
-    if (rhs.is_some()) {
-      new (&storage_value_) T(std::move(rhs.storage_value_));
-    }
-  }
-
-  Option& operator=(Option&& rhs) {
-    // contained object is destroyed as appropriate in the parent scope
-    if (is_some() && rhs.is_some()) {
-      std::swap(storage_value_, rhs.storage_value_);
-    } else if (is_some() && rhs.is_none()) {
-      // we let the ref'd `rhs` destroy the object instead
-      new (&rhs.storage_value_) T(std::move(storage_value_));
-      storage_value_.~T();
-      is_none_ = true;
-      rhs.is_none_ = false;
-    } else if (is_none() && rhs.is_some()) {
-      new (&storage_value_) T(std::move(rhs.storage_value_));
-      rhs.storage_value_.~T();
-      rhs.is_none_ = true;
-      is_none_ = false;
-    }
-
-    return *this;
-  }
-
-  Option(Option const& rhs) : is_none_(rhs.is_none_) {
+      : storage_{std::in_place, some.value()} {
     static_assert(copy_constructible<T>);
-    if (rhs.is_some()) {
-      new (&storage_value_) T(rhs.storage_value_);
-    }
   }
 
-  Option& operator=(Option const& rhs) {
-    static_assert(copy_constructible<T>);
-
-    if (is_some() && rhs.is_some()) {
-      storage_value_ = rhs.storage_value_;
-    } else if (is_some() && rhs.is_none()) {
-      storage_value_.~T();
-      is_none_ = true;
-    } else if (is_none() && rhs.is_some()) {
-      new (&storage_value_) T(rhs.storage_value_);
-      is_none_ = false;
-    }
-
-    return *this;
-  }
+  constexpr Option(NoneType const&) noexcept : storage_{} {}
 
-  STX_OPTION_CONSTEXPR ~Option() noexcept {
-    if (is_some()) {
-      storage_value_.~T();
-    }
-  }
+  /// constructs the value in-place from `args`, without any intermediate
+  /// `Some<T>` or move. `T` need not be movable.
+  ///
+  /// # Examples
+  ///
+  /// Basic usage:
+  ///
+  /// ``` cpp
+  /// Option<vector<int>> x{std::in_place, 3, 0};
+  /// ASSERT_EQ(x, Some(vector{0, 0, 0}));
+  /// ```
+  template <typename... Args,
+            std::enable_if_t<std::is_constructible_v<T, Args&&...>, int> = 0>
+  constexpr explicit Option(std::in_place_t, Args && ... args)
+      : storage_{std::in_place, std::forward<Args>(args)...} {}
+
+  // the special member functions are trivial whenever `T`'s are
+  Option(Option &&) = default;
+  Option& operator=(Option&&) = default;
+  Option(Option const&) = default;
+  Option& operator=(Option const&) = default;
+  STX_OPTION_CONSTEXPR ~Option() noexcept = default;
 
   template <typename U>
   [[nodiscard]] constexpr bool operator==(Option<U> const& cmp) const {
@@ -602,7 +645,9 @@ struct [[nodiscard]] Option {
   /// Option<int> y = None;
   /// ASSERT_TRUE(y.is_none());
   /// ```
-  [[nodiscard]] constexpr bool is_none() const noexcept { return is_none_; }
+  [[nodiscard]] constexpr bool is_none() const noexcept {
+    return storage_.is_none();
+  }
 
   [[nodiscard]] operator bool() const noexcept { return is_some(); }
 
@@ -676,8 +721,9 @@ struct [[nodiscard]] Option {
   ///
   /// ASSERT_EQ(x, Some(2));
   /// ```
-  [[nodiscard]] T& value()& noexcept {
-    if (is_none()) internal::option::no_lref();
+  [[nodiscard]] T& value(
+      [[maybe_unused]] CallerLocation const& location = {})& noexcept {
+    STX_EXPECTS(is_some(), internal::option::no_lref(location));
     return value_ref_();
   }
 
@@ -698,8 +744,9 @@ struct [[nodiscard]] Option {
   ///
   /// ASSERT_EQ(y, 9);
   /// ```
-  [[nodiscard]] T const& value() const& noexcept {
-    if (is_none()) internal::option::no_lref();
+  [[nodiscard]] T const& value(
+      [[maybe_unused]] CallerLocation const& location = {}) const& noexcept {
+    STX_EXPECTS(is_some(), internal::option::no_lref(location));
     return value_cref_();
   }
 
@@ -793,12 +840,12 @@ struct [[nodiscard]] Option {
   ///                                                          // the world is
   ///                                                          // ending
   /// ```
-  [[nodiscard]] auto expect(std::string_view const& msg)&&->T {
-    if (is_some()) {
-      return std::move(value_ref_());
-    } else {
-      internal::option::expect_value_failed(msg);
-    }
+  [[nodiscard]] auto expect(
+      std::string_view const& msg,
+      [[maybe_unused]] CallerLocation const& location = {})&&->T {
+    STX_EXPECTS(is_some(),
+                internal::option::expect_value_failed(msg, location));
+    return std::move(value_ref_());
   }
 
   /// Moves the value out of the `Option<T>` if it is in the variant state of
@@ -823,12 +870,37 @@ struct [[nodiscard]] Option {
   /// Option<string> y = None;
   /// ASSERT_DEATH(move(y).unwrap());
   /// ```
-  [[nodiscard]] auto unwrap()&&->T {
-    if (is_some()) {
-      return std::move(value_ref_());
-    } else {
-      internal::option::no_value();
-    }
+  [[nodiscard]] auto unwrap(
+      [[maybe_unused]] CallerLocation const& location = {})&&->T {
+    STX_EXPECTS(is_some(), internal::option::no_value(location));
+    return std::move(value_ref_());
+  }
+
+  /// Moves the value out of the `Option<T>` without checking that it is in
+  /// the variant state of `Some<T>`.
+  ///
+  /// This is meant for hot paths where the `Option` is already known to be
+  /// `Some`. The check is only performed when `STX_ENABLE_DEBUG_ASSERTIONS` is
+  /// defined, otherwise the optimizer assumes the value is present.
+  ///
+  /// # Safety
+  ///
+  /// Calling this on a `None` is undefined behaviour in builds without debug
+  /// assertions and panics otherwise.
+  ///
+  /// # Examples
+  ///
+  /// Basic usage:
+  ///
+  /// ``` cpp
+  /// Option x = Some("air"s);
+  /// ASSERT_EQ(move(x).unwrap_unchecked(), "air");
+  /// ```
+  [[nodiscard]] auto unwrap_unchecked(
+      [[maybe_unused]] CallerLocation const& location = {})&&->T {
+    STX_DEBUG_EXPECTS(is_some(),
+                      internal::option::no_value_unchecked(location));
+    return std::move(value_ref_());
   }
 
   /// Returns the contained value or an alternative: `alt`.
@@ -837,6 +909,10 @@ struct [[nodiscard]] Option {
   /// the result of a function call, it is recommended to use `unwrap_or_else`,
   /// which is lazily evaluated.
   ///
+  /// For small trivially copyable `T`, the value or `alt` is selected without
+  /// branching, the cost doesn't depend on how predictable the `Option`'s
+  /// state is.
+  ///
   ///
   /// # Examples
   ///
@@ -847,6 +923,11 @@ struct [[nodiscard]] Option {
   /// ASSERT_EQ(make_none<string>().unwrap_or("bike"), "bike");
   /// ```
   [[nodiscard]] constexpr auto unwrap_or(T && alt)&&->T {
+    if constexpr (internal::is_selectable<T>) {
+      if (!STX_IS_CONSTANT_EVALUATED()) {
+        return internal::select(is_some(), value_cref_(), alt);
+      }
+    }
     if (is_some()) {
       return std::move(value_ref_());
     } else {
@@ -1270,8 +1351,7 @@ struct [[nodiscard]] Option {
   [[nodiscard]] constexpr auto take()->Option {
     if (is_some()) {
       auto some = Some<T>(std::move(value_ref_()));
-      value_ref_().~T();
-      is_none_ = true;
+      storage_.destroy();
       return some;
     } else {
       return None;
@@ -1303,8 +1383,7 @@ struct [[nodiscard]] Option {
       std::swap(replacement, value_ref_());
       return Some<T>(std::move(replacement));
     } else {
-      new (&storage_value_) T(std::forward<T&&>(replacement));
-      is_none_ = false;
+      storage_.construct(std::forward<T&&>(replacement));
       return None;
     }
   }
@@ -1336,12 +1415,37 @@ struct [[nodiscard]] Option {
       std::swap(copy, value_ref_());
       return Some<T>(std::move(copy));
     } else {
-      new (&storage_value_) T(replacement);
-      is_none_ = false;
+      storage_.construct(replacement);
       return None;
     }
   }
 
+  /// Destroys the contained value if present and constructs a new one
+  /// in-place from `args`, returning a reference to it. `T` need not be
+  /// movable.
+  ///
+  /// If the construction throws, the option is left as a `None`.
+  ///
+  /// # Examples
+  ///
+  /// Basic usage:
+  ///
+  /// ``` cpp
+  /// Option<vector<int>> x = None;
+  /// x.emplace(2, 5);
+  /// ASSERT_EQ(x, Some(vector{5, 5}));
+  ///
+  /// x.emplace(1, 6).push_back(7);
+  /// ASSERT_EQ(x, Some(vector{6, 7}));
+  /// ```
+  template <typename... Args>
+  auto emplace(Args && ... args)->T& {
+    static_assert(std::is_constructible_v<T, Args&&...>);
+    if (is_some()) storage_.destroy();
+    storage_.construct(std::forward<Args>(args)...);
+    return value_ref_();
+  }
+
   /// Returns a copy of the option and its contents.
   ///
   /// # Examples
@@ -1382,10 +1486,11 @@ struct [[nodiscard]] Option {
   /// ASSERT_DEATH(divide(0.0, 1.0).expect_none());
   /// ASSERT_NO_THROW(divide(1.0, 0.0).expect_none());
   /// ```
-  void expect_none(std::string_view const& msg)&& {
-    if (is_some()) {
-      internal::option::expect_none_failed(msg);
-    }
+  void expect_none(
+      std::string_view const& msg,
+      [[maybe_unused]] CallerLocation const& location = {})&& {
+    STX_EXPECTS(is_none(),
+                internal::option::expect_none_failed(msg, location));
   }
 
   /// Unwraps an option, expecting `None` and returning nothing.
@@ -1408,10 +1513,9 @@ struct [[nodiscard]] Option {
   /// ASSERT_DEATH(divide(0.0, 1.0).unwrap_none());
   /// ASSERT_NO_THROW(divide(1.0, 0.0).unwrap_none());
   /// ```
-  void unwrap_none()&& {
-    if (is_some()) {
-      internal::option::no_none();
-    }
+  void unwrap_none(
+      [[maybe_unused]] CallerLocation const& location = {})&& {
+    STX_EXPECTS(is_none(), internal::option::no_none(location));
   }
 
   /// Returns the contained value or a default of T
@@ -1434,6 +1538,12 @@ struct [[nodiscard]] Option {
   /// ```
   [[nodiscard]] constexpr auto unwrap_or_default()&&->T {
     static_assert(default_constructible<T>);
+    if constexpr (internal::is_selectable<T>) {
+      if (!STX_IS_CONSTANT_EVALUATED()) {
+        T const alt{};
+        return internal::select(is_some(), value_cref_(), alt);
+      }
+    }
     if (is_some()) {
       return std::move(value_ref_());
     } else {
@@ -1509,20 +1619,25 @@ struct [[nodiscard]] Option {
   }
 
  private:
-  union {
-    T storage_value_;
-  };
+  internal::option::Storage<T> storage_;
 
-  bool is_none_;
-
-  [[nodiscard]] constexpr T& value_ref_() { return storage_value_; }
+  [[nodiscard]] constexpr T& value_ref_() { return storage_.value(); }
 
   [[nodiscard]] constexpr T const& value_cref_() const {
-    return storage_value_;
+    return storage_.value();
   }
 
   template <typename Tp>
   friend Tp&& internal::option::unsafe_value_move(Option<Tp>&);
+
+  // return object of a coroutine, the coroutine's promise writes the value
+  // into it
+  explicit Option(internal::option::Promise<T>& promise) noexcept
+      : storage_{} {
+    promise.bind(*this);
+  }
+
+  friend struct internal::option::Promise<T>;
 };
 
 template <typename U, typename T>
@@ -1566,6 +1681,10 @@ inline Tp&& unsafe_value_move(Result<Tp, Er>&);
 template <typename Tp, typename Er>
 inline Er&& unsafe_err_move(Result<Tp, Er>&);
 
+// coroutine promise of `Result`-returning coroutines, see `stx/coroutine.h`
+template <typename Tp, typename Er>
+struct Promise;
+
 }  // namespace result
 }  // namespace internal
 
@@ -1630,6 +1749,27 @@ inline Er&& unsafe_err_move(Result<Tp, Er>&);
 //!
 //! C++ 20 and above
 //!
+//! # Layout
+//!
+//! If one of `T` and `E` is an empty type and the other has a niche (see
+//! `niche_traits`), the niche represents the variant holding the empty type
+//! and no discriminant is stored. i.e. `sizeof(Result<int*, Empty>) ==
+//! sizeof(int*)`, and `Ok<int*>(nullptr)` reads as `Err`.
+//!
+//! If `T` is a pointer to a type aligned to 2 bytes or more and `E` is a small
+//! trivially copyable type (i.e. an error enum), the discriminant is stored in
+//! the pointer's always-clear lowest bit and the error is packed next to it.
+//! i.e. `sizeof(Result<Node*, ErrorEnum>) == sizeof(Node*)` and the `Result`
+//! is passed in a single register. The layout depends on the pointee's
+//! alignment, which is unknown for incomplete types, the pointee type should
+//! thus be complete wherever the `Result` is used.
+//!
+//! If `E`'s niche is confined to its leading bytes (see
+//! `niche_traits::niche_bytes`) and a trivially copyable `T` fits in the rest,
+//! the niche represents `Ok` and the value is packed after it. i.e.
+//! `sizeof(Result<int64_t, ErrorCode>) == sizeof(ErrorCode)` and the `Result`
+//! is passed in two registers.
+//!
 //! # Note
 //!
 //! `Result` unlike `Option` is a value-forwarding type. It doesn't have copy
@@ -1641,10 +1781,6 @@ inline Er&& unsafe_err_move(Result<Tp, Er>&);
 template <typename T, typename E>
 struct [[nodiscard]] Result {
  public:
-  static_assert(movable<T>,
-                "Value type 'T' for 'Result<T, E>' must be movable");
-  static_assert(movable<E>,
-                "Error type 'E' for 'Result<T, E>' must be movable");
   static_assert(
       !is_reference<T>,
       "Cannot use a reference for value type 'T' of 'Result<T, E>', To prevent "
@@ -1662,53 +1798,59 @@ struct [[nodiscard]] Result {
   using error_type = E;
 
   constexpr Result(Ok<T> && result)
-      : storage_value_(std::forward<T>(result.value_)), is_ok_(true) {}
+      : storage_{std::in_place_index<0>, std::forward<T>(result.value_)} {}
 
   constexpr Result(Err<E> && err)
-      : storage_err_(std::forward<E>(err.value_)), is_ok_(false) {}
+      : storage_{std::in_place_index<1>, std::forward<E>(err.value_)} {}
 
-  // not possible as constexpr yet:
-  // 1 - we need to check which variant is present
-  // 2 - the union will be default-constructed (empty) and we thus need to call
-  // placement-new in the constructor block
-  Result(Result && rhs) : is_ok_(rhs.is_ok_) {
-    if (rhs.is_ok()) {
-      new (&storage_value_) T(std::move(rhs.storage_value_));
-    } else {
-      new (&storage_err_) E(std::move(rhs.storage_err_));
-    }
-  }
+  /// widens the error of `err` into `E`, see `error_widening`.
+  template <typename F,
+            std::enable_if_t<error_widening<E, F>::value, int> = 0>
+  constexpr Result(Err<F> && err)
+      : storage_{std::in_place_index<1>, std::move(err.value_)} {}
 
-  Result& operator=(Result&& rhs) {
-    if (is_ok() && rhs.is_ok()) {
-      std::swap(value_ref_(), rhs.value_ref_());
-    } else if (is_ok() && rhs.is_err()) {
-      // we need to place a new value in here (discarding old value)
-      storage_value_.~T();
-      new (&storage_err_) E(std::move(rhs.storage_err_));
-      is_ok_ = false;
-    } else if (is_err() && rhs.is_ok()) {
-      storage_err_.~E();
-      new (&storage_value_) T(std::move(rhs.storage_value_));
-      is_ok_ = true;
-    } else {
-      // both are errs
-      std::swap(err_ref_(), rhs.err_ref_());  // NOLINT
-    }
-    return *this;
-  }
+  /// constructs the value in-place from `args`, without any intermediate
+  /// `Ok<T>` or move. `T` need not be movable.
+  ///
+  /// # Examples
+  ///
+  /// Basic usage:
+  ///
+  /// ``` cpp
+  /// Result<vector<int>, string> x{std::in_place, 3, 0};
+  /// ASSERT_EQ(x, Ok(vector{0, 0, 0}));
+  /// ```
+  template <typename... Args,
+            std::enable_if_t<std::is_constructible_v<T, Args&&...>, int> = 0>
+  constexpr explicit Result(std::in_place_t, Args && ... args)
+      : storage_{std::in_place_index<0>, std::forward<Args>(args)...} {}
+
+  /// constructs the error in-place from `args`, without any intermediate
+  /// `Err<E>` or move. `E` need not be movable.
+  ///
+  /// # Examples
+  ///
+  /// Basic usage:
+  ///
+  /// ``` cpp
+  /// Result<int, string> x{err_in_place, 3, 'x'};
+  /// ASSERT_EQ(x, Err("xxx"s));
+  /// ```
+  template <typename... Args,
+            std::enable_if_t<std::is_constructible_v<E, Args&&...>, int> = 0>
+  constexpr explicit Result(ErrInPlaceType, Args && ... args)
+      : storage_{std::in_place_index<1>, std::forward<Args>(args)...} {}
+
+  // the move operations and destructor are trivial whenever `T`'s and `E`'s
+  // are
+  Result(Result &&) = default;
+  Result& operator=(Result&&) = default;
 
   Result() = delete;
   Result(Result const& rhs) = delete;
   Result& operator=(Result const& rhs) = delete;
 
-  STX_RESULT_CONSTEXPR ~Result() noexcept {
-    if (is_ok()) {
-      storage_value_.~T();
-    } else {
-      storage_err_.~E();
-    }
-  };
+  STX_RESULT_CONSTEXPR ~Result() noexcept = default;
 
   template <typename U>
   [[nodiscard]] constexpr bool operator==(Ok<U> const& cmp) const {
@@ -1792,7 +1934,9 @@ struct [[nodiscard]] Result {
   /// Result<int, string_view> y = Err("Some error message"sv);
   /// ASSERT_FALSE(y.is_ok());
   /// ```
-  [[nodiscard]] constexpr bool is_ok() const noexcept { return is_ok_; }
+  [[nodiscard]] constexpr bool is_ok() const noexcept {
+    return storage_.is_ok();
+  }
 
   /// Returns `true` if the result is `Err<T>`.
   ///
@@ -1937,8 +2081,9 @@ struct [[nodiscard]] Result {
   ///
   /// ASSERT_EQ(result, Ok(97));
   /// ```
-  [[nodiscard]] T& value()& noexcept {
-    if (is_err()) internal::result::no_lref(err_cref_());
+  [[nodiscard]] T& value(
+      [[maybe_unused]] CallerLocation const& location = {})& noexcept {
+    STX_EXPECTS(is_ok(), internal::result::no_lref(err_cref_(), location));
     return value_ref_();
   }
 
@@ -1959,8 +2104,9 @@ struct [[nodiscard]] Result {
   ///
   /// ASSERT_EQ(value, 6);
   /// ```
-  [[nodiscard]] T const& value() const& noexcept {
-    if (is_err()) internal::result::no_lref(err_cref_());
+  [[nodiscard]] T const& value(
+      [[maybe_unused]] CallerLocation const& location = {}) const& noexcept {
+    STX_EXPECTS(is_ok(), internal::result::no_lref(err_cref_(), location));
     return value_cref_();
   }
 
@@ -1987,8 +2133,9 @@ struct [[nodiscard]] Result {
   ///
   /// ASSERT_EQ(result, Err(46));
   /// ```
-  [[nodiscard]] E& err_value()& noexcept {
-    if (is_ok()) internal::result::no_err_lref();
+  [[nodiscard]] E& err_value(
+      [[maybe_unused]] CallerLocation const& location = {})& noexcept {
+    STX_EXPECTS(is_err(), internal::result::no_err_lref(location));
     return err_ref_();
   }
 
@@ -2009,8 +2156,9 @@ struct [[nodiscard]] Result {
   ///
   /// ASSERT_EQ(err, 9);
   /// ```
-  [[nodiscard]] E const& err_value() const& noexcept {
-    if (is_ok()) internal::result::no_err_lref();
+  [[nodiscard]] E const& err_value(
+      [[maybe_unused]] CallerLocation const& location = {}) const& noexcept {
+    STX_EXPECTS(is_err(), internal::result::no_err_lref(location));
     return err_cref_();
   }
 
@@ -2431,6 +2579,11 @@ struct [[nodiscard]] Result {
   /// ASSERT_EQ(move(y).unwrap_or(move(alt_b)), 2);
   /// ```
   [[nodiscard]] constexpr auto unwrap_or(T && alt)&&->T {
+    if constexpr (internal::is_selectable<T>) {
+      if (!STX_IS_CONSTANT_EVALUATED()) {
+        return internal::select(is_ok(), value_cref_(), alt);
+      }
+    }
     if (is_ok()) {
       return std::move(value_ref_());
     } else {
@@ -2479,10 +2632,34 @@ struct [[nodiscard]] Result {
   /// Result<int, string_view> x = Err("emergency failure"sv);
   /// ASSERT_DEATH(move(x).unwrap());
   /// ```
-  [[nodiscard]] auto unwrap()&&->T {
-    if (is_err()) {
-      internal::result::no_value(err_cref_());
-    }
+  [[nodiscard]] auto unwrap(
+      [[maybe_unused]] CallerLocation const& location = {})&&->T {
+    STX_EXPECTS(is_ok(), internal::result::no_value(err_cref_(), location));
+    return std::move(value_ref_());
+  }
+
+  /// Moves the value out of the `Result<T, E>` without checking that it is in
+  /// the variant state of `Ok<T>`.
+  ///
+  /// The check is only performed when `STX_ENABLE_DEBUG_ASSERTIONS` is
+  /// defined, otherwise the optimizer assumes the value is present.
+  ///
+  /// # Safety
+  ///
+  /// Calling this on an `Err` is undefined behaviour in builds without debug
+  /// assertions and panics otherwise.
+  ///
+  /// # Examples
+  ///
+  /// Basic usage:
+  ///
+  /// ``` cpp
+  /// ASSERT_EQ(make_ok<int, string_view>(2).unwrap_unchecked(), 2);
+  /// ```
+  [[nodiscard]] auto unwrap_unchecked(
+      [[maybe_unused]] CallerLocation const& location = {})&&->T {
+    STX_DEBUG_EXPECTS(
+        is_ok(), internal::result::no_value_unchecked(err_cref_(), location));
     return std::move(value_ref_());
   }
 
@@ -2501,10 +2678,11 @@ struct [[nodiscard]] Result {
   /// Result<int, string_view> x = Err("emergency failure"sv);
   /// ASSERT_DEATH(move(x).expect("Testing expect"));
   /// ```
-  [[nodiscard]] auto expect(std::string_view const& msg)&&->T {
-    if (is_err()) {
-      internal::result::expect_value_failed(msg, err_cref_());
-    }
+  [[nodiscard]] auto expect(
+      std::string_view const& msg,
+      [[maybe_unused]] CallerLocation const& location = {})&&->T {
+    STX_EXPECTS(is_ok(), internal::result::expect_value_failed(
+                             msg, err_cref_(), location));
     return std::move(value_ref_());
   }
 
@@ -2527,10 +2705,34 @@ struct [[nodiscard]] Result {
   /// Result<int, string_view> y = Err("emergency failure"sv);
   /// ASSERT_EQ(move(y).unwrap_err(), "emergency failure");
   /// ```
-  [[nodiscard]] auto unwrap_err()&&->E {
-    if (is_ok()) {
-      internal::result::no_err();
-    }
+  [[nodiscard]] auto unwrap_err(
+      [[maybe_unused]] CallerLocation const& location = {})&&->E {
+    STX_EXPECTS(is_err(), internal::result::no_err(location));
+    return std::move(err_ref_());
+  }
+
+  /// Moves the error out of the `Result<T, E>` without checking that it is in
+  /// the variant state of `Err<E>`.
+  ///
+  /// The check is only performed when `STX_ENABLE_DEBUG_ASSERTIONS` is
+  /// defined, otherwise the optimizer assumes the error is present.
+  ///
+  /// # Safety
+  ///
+  /// Calling this on an `Ok` is undefined behaviour in builds without debug
+  /// assertions and panics otherwise.
+  ///
+  /// # Examples
+  ///
+  /// Basic usage:
+  ///
+  /// ``` cpp
+  /// ASSERT_EQ(make_err<int, string_view>("oops"sv).unwrap_err_unchecked(),
+  ///           "oops"sv);
+  /// ```
+  [[nodiscard]] auto unwrap_err_unchecked(
+      [[maybe_unused]] CallerLocation const& location = {})&&->E {
+    STX_DEBUG_EXPECTS(is_err(), internal::result::no_err_unchecked(location));
     return std::move(err_ref_());
   }
 
@@ -2552,10 +2754,10 @@ struct [[nodiscard]] Result {
   ///                                                         // expect_err:
   ///                                                         // 10"
   /// ```
-  [[nodiscard]] auto expect_err(std::string_view const& msg)&&->E {
-    if (is_ok()) {
-      internal::result::expect_err_failed(msg);
-    }
+  [[nodiscard]] auto expect_err(
+      std::string_view const& msg,
+      [[maybe_unused]] CallerLocation const& location = {})&&->E {
+    STX_EXPECTS(is_err(), internal::result::expect_err_failed(msg, location));
     return std::move(err_ref_());
   }
 
@@ -2581,6 +2783,12 @@ struct [[nodiscard]] Result {
   /// ```
   [[nodiscard]] constexpr auto unwrap_or_default()&&->T {
     static_assert(default_constructible<T>);
+    if constexpr (internal::is_selectable<T>) {
+      if (!STX_IS_CONSTANT_EVALUATED()) {
+        T const alt{};
+        return internal::select(is_ok(), value_cref_(), alt);
+      }
+    }
     if (is_ok()) {
       return std::move(value_ref_());
     } else {
@@ -2658,6 +2866,74 @@ struct [[nodiscard]] Result {
     }
   }
 
+  /// Destroys the contained value or error and constructs a new value
+  /// in-place from `args`, returning a reference to it. `T` need not be
+  /// movable.
+  ///
+  /// If constructing `T` from `args` can throw, the value is constructed
+  /// before the old content is destroyed and then moved in, which requires
+  /// `T` to be nothrow move-constructible.
+  ///
+  /// # Examples
+  ///
+  /// Basic usage:
+  ///
+  /// ``` cpp
+  /// Result<vector<int>, string> x = Err("oops"s);
+  /// x.emplace(2, 5);
+  /// ASSERT_EQ(x, Ok(vector{5, 5}));
+  /// ```
+  template <typename... Args>
+  auto emplace(Args && ... args)->T& {
+    static_assert(std::is_constructible_v<T, Args&&...>);
+    if constexpr (std::is_nothrow_constructible_v<T, Args&&...>) {
+      storage_.destroy();
+      storage_.construct_value(std::forward<Args>(args)...);
+    } else {
+      static_assert(std::is_nothrow_move_constructible_v<T>,
+                    "'T' must be nothrow constructible from the arguments or "
+                    "nothrow move-constructible");
+      T value(std::forward<Args>(args)...);
+      storage_.destroy();
+      storage_.construct_value(std::move(value));
+    }
+    return value_ref_();
+  }
+
+  /// Destroys the contained value or error and constructs a new error
+  /// in-place from `args`, returning a reference to it. `E` need not be
+  /// movable.
+  ///
+  /// If constructing `E` from `args` can throw, the error is constructed
+  /// before the old content is destroyed and then moved in, which requires
+  /// `E` to be nothrow move-constructible.
+  ///
+  /// # Examples
+  ///
+  /// Basic usage:
+  ///
+  /// ``` cpp
+  /// Result<int, string> x = Ok(2);
+  /// x.emplace_err(3, 'x');
+  /// ASSERT_EQ(x, Err("xxx"s));
+  /// ```
+  template <typename... Args>
+  auto emplace_err(Args && ... args)->E& {
+    static_assert(std::is_constructible_v<E, Args&&...>);
+    if constexpr (std::is_nothrow_constructible_v<E, Args&&...>) {
+      storage_.destroy();
+      storage_.construct_err(std::forward<Args>(args)...);
+    } else {
+      static_assert(std::is_nothrow_move_constructible_v<E>,
+                    "'E' must be nothrow constructible from the arguments or "
+                    "nothrow move-constructible");
+      E err(std::forward<Args>(args)...);
+      storage_.destroy();
+      storage_.construct_err(std::move(err));
+    }
+    return err_ref_();
+  }
+
   /// Returns a copy of the result and its contents.
   ///
   /// # Examples
@@ -2681,23 +2957,18 @@ struct [[nodiscard]] Result {
   }
 
  private:
-  union {
-    T storage_value_;
-    E storage_err_;
-  };
-
-  bool is_ok_;
+  internal::result::Storage<T, E> storage_;
 
-  [[nodiscard]] constexpr T& value_ref_() noexcept { return storage_value_; }
+  [[nodiscard]] constexpr T& value_ref_() noexcept { return storage_.value(); }
 
   [[nodiscard]] constexpr T const& value_cref_() const noexcept {
-    return storage_value_;
+    return storage_.value();
   }
 
-  [[nodiscard]] constexpr E& err_ref_() noexcept { return storage_err_; }
+  [[nodiscard]] constexpr E& err_ref_() noexcept { return storage_.err(); }
 
   [[nodiscard]] constexpr E const& err_cref_() const noexcept {
-    return storage_err_;
+    return storage_.err();
   }
 
   template <typename Tp, typename Er>
@@ -2705,6 +2976,16 @@ struct [[nodiscard]] Result {
 
   template <typename Tp, typename Er>
   friend Er&& internal::result::unsafe_err_move(Result<Tp, Er>&);
+
+  // return object of a coroutine. it is left uninitialized until the
+  // coroutine's promise writes the value or error into it, which happens
+  // before it is handed to the caller
+  explicit Result(internal::result::Promise<T, E>& promise) noexcept
+      : storage_{internal::uninit} {
+    promise.bind(*this);
+  }
+
+  friend struct internal::result::Promise<T, E>;
 };
 
 template <typename U, typename T, typename E>
@@ -2731,28 +3012,466 @@ template <typename F, typename T, typename E>
   return result != cmp;
 }
 
-/*********************    HELPER FUNCTIONS    *********************/
+//! ### `Result` of an operation that only reports success or failure.
+//!
+//! The `Ok` variant carries no value, `Result<void, E>` is thus only as large
+//! as `E` and its discriminant (or as large as `E` if `E` has a niche, see
+//! `niche_traits`).
+//!
+//! ``` cpp
+//! auto check = [](int fd) -> Result<void, int> {
+//!   if (fd < 0) return Err(-1);
+//!   return Ok();
+//! };
+//!
+//! ASSERT_EQ(check(2), Ok());
+//! ASSERT_EQ(check(-2), Err(-1));
+//! ```
+//!
+//! # Constexpr ?
+//!
+//! C++ 20 and above
+//!
+template <typename E>
+struct [[nodiscard]] Result<void, E> {
+ public:
+  static_assert(
+      !is_reference<E>,
+      "Cannot use a reference for error type 'E' of 'Result<void, E>', To "
+      "prevent "
+      "subtleties use "
+      "type wrappers like std::reference_wrapper (stx::Ref) or any of the "
+      "`stx::ConstRef` or `stx::MutRef` specialized aliases instead");
 
-/// Helper function to construct an `Option<T>` with a `Some<T>` value.
-/// if the template parameter is not specified, it is auto-deduced from the
-/// parameter's value.
-///
-/// # Examples
-///
-/// Basic usage:
-///
-///
-/// ``` cpp
-/// // these are some of the various ways to construct on Option<T> with a
-/// // Some<T> value
-/// Option g = Some(9);
-/// Option h = Some<int>(9);
-/// Option<int> i = Some(9);
-/// auto j = Option(Some(9));
-/// auto k = Option<int>(Some<int>(9));
-/// auto l = Option<int>(Some(9));
-/// // ... and a few more
-///
+  using value_type = void;
+  using error_type = E;
+
+  constexpr Result(Ok<void>&&) noexcept : storage_{} {}
+
+  constexpr Result(Err<E> && err)
+      : storage_{std::in_place, std::forward<E>(err.value_)} {}
+
+  /// widens the error of `err` into `E`, see `error_widening`.
+  template <typename F,
+            std::enable_if_t<error_widening<E, F>::value, int> = 0>
+  constexpr Result(Err<F> && err)
+      : storage_{std::in_place, std::move(err.value_)} {}
+
+  /// constructs the error in-place from `args`, without any intermediate
+  /// `Err<E>` or move. `E` need not be movable.
+  template <typename... Args,
+            std::enable_if_t<std::is_constructible_v<E, Args&&...>, int> = 0>
+  constexpr explicit Result(ErrInPlaceType, Args && ... args)
+      : storage_{std::in_place, std::forward<Args>(args)...} {}
+
+  Result(Result &&) = default;
+  Result& operator=(Result&&) = default;
+
+  Result() = delete;
+  Result(Result const& rhs) = delete;
+  Result& operator=(Result const& rhs) = delete;
+
+  STX_RESULT_CONSTEXPR ~Result() noexcept = default;
+
+  [[nodiscard]] constexpr bool operator==(Ok<void> const&) const noexcept {
+    return is_ok();
+  }
+
+  [[nodiscard]] constexpr bool operator!=(Ok<void> const&) const noexcept {
+    return is_err();
+  }
+
+  template <typename F>
+  [[nodiscard]] constexpr bool operator==(Err<F> const& cmp) const {
+    static_assert(equality_comparable<E, F>);
+    if (is_ok()) {
+      return false;
+    } else {
+      return err_cref_() == cmp.value();
+    }
+  }
+
+  template <typename F>
+  [[nodiscard]] constexpr bool operator!=(Err<F> const& cmp) const {
+    static_assert(equality_comparable<E, F>);
+    if (is_ok()) {
+      return true;
+    } else {
+      return err_cref_() != cmp.value();
+    }
+  }
+
+  template <typename F>
+  [[nodiscard]] constexpr bool operator==(Result<void, F> const& cmp) const {
+    static_assert(equality_comparable<E, F>);
+    if (is_ok() && cmp.is_ok()) {
+      return true;
+    } else if (is_err() && cmp.is_err()) {
+      return err_cref_() == cmp.err_cref_();
+    } else {
+      return false;
+    }
+  }
+
+  template <typename F>
+  [[nodiscard]] constexpr bool operator!=(Result<void, F> const& cmp) const {
+    return !(*this == cmp);
+  }
+
+  /// Returns `true` if the result is `Ok`.
+  [[nodiscard]] constexpr bool is_ok() const noexcept {
+    return storage_.is_none();
+  }
+
+  /// Returns `true` if the result is `Err`.
+  [[nodiscard]] constexpr bool is_err() const noexcept { return !is_ok(); }
+
+  [[nodiscard]] operator bool() const noexcept { return is_ok(); }
+
+  /// Returns `true` if the result is an `Err` value containing the given
+  /// value.
+  template <typename ErrCmp>
+  [[nodiscard]] constexpr bool contains_err(ErrCmp const& cmp) const {
+    static_assert(equality_comparable<E, ErrCmp>);
+    if (is_err()) {
+      return err_cref_() == cmp;
+    } else {
+      return false;
+    }
+  }
+
+  /// Converts from `Result<void, E>` to `Option<E>`, discarding the success
+  /// value.
+  [[nodiscard]] constexpr auto err() && -> Option<E> {
+    if (is_err()) {
+      return Some<E>(std::move(err_ref_()));
+    } else {
+      return None;
+    }
+  }
+
+  /// Calls `op` if the result is `Ok`, wrapping its return value in an `Ok`
+  /// (`Ok()` if `op` returns nothing), otherwise returns the `Err` value of
+  /// itself.
+  ///
+  /// # Examples
+  ///
+  /// Basic usage:
+  ///
+  /// ``` cpp
+  /// Result<void, int> x = Ok();
+  /// ASSERT_EQ(move(x).map([]() { return 2; }), Ok(2));
+  ///
+  /// Result<void, int> y = Err(-1);
+  /// ASSERT_EQ(move(y).map([]() { return 2; }), Err(-1));
+  /// ```
+  template <typename Fn>
+  [[nodiscard]] constexpr auto map(Fn && op)&&->Result<invoke_result<Fn&&>, E> {
+    static_assert(invocable<Fn&&>);
+    if (is_ok()) {
+      if constexpr (std::is_void_v<invoke_result<Fn&&>>) {
+        std::forward<Fn&&>(op)();
+        return Ok<void>{};
+      } else {
+        return Ok<invoke_result<Fn&&>>(std::forward<Fn&&>(op)());
+      }
+    } else {
+      return Err<E>(std::move(err_ref_()));
+    }
+  }
+
+  /// Maps a `Result<void, E>` to `Result<void, F>` by applying a function to a
+  /// contained `Err` value, leaving an `Ok` value untouched.
+  template <typename Fn>
+  [[nodiscard]] constexpr auto map_err(
+      Fn && op)&&->Result<void, invoke_result<Fn&&, E&&>> {
+    static_assert(invocable<Fn&&, E&&>);
+    if (is_ok()) {
+      return Ok<void>{};
+    } else {
+      return Err<invoke_result<Fn&&, E&&>>(
+          std::forward<Fn&&>(op)(std::move(err_ref_())));
+    }
+  }
+
+  /// Returns `res` if the result is `Ok`, otherwise returns the `Err` value
+  /// of itself.
+  template <typename U, typename F>
+  [[nodiscard]] constexpr auto AND(Result<U, F> && res)&&->Result<U, F> {
+    static_assert(convertible<E&&, F>);
+    if (is_ok()) {
+      return std::forward<Result<U, F>&&>(res);
+    } else {
+      return Err<F>(std::move(static_cast<F>(std::move(err_ref_()))));
+    }
+  }
+
+  /// Calls `op` if the result is `Ok`, otherwise returns the `Err` value of
+  /// itself.
+  ///
+  /// This function can be used for control flow based on `Result` values.
+  ///
+  /// # Examples
+  ///
+  /// Basic usage:
+  ///
+  /// ``` cpp
+  /// auto open = [](int fd) -> Result<void, int> {
+  ///   if (fd < 0) return Err(move(fd));
+  ///   return Ok();
+  /// };
+  ///
+  /// ASSERT_EQ(open(1).and_then([]() { return 8; }), Ok(8));
+  /// ASSERT_EQ(open(-1).and_then([]() { return 8; }), Err(-1));
+  /// ```
+  template <typename Fn>
+  [[nodiscard]] constexpr auto and_then(
+      Fn && op)&&->Result<invoke_result<Fn&&>, E> {
+    return std::move(*this).map(std::forward<Fn&&>(op));
+  }
+
+  /// Calls `op` if the result is `Err`, otherwise returns `Ok()`.
+  template <typename Fn>
+  [[nodiscard]] constexpr auto or_else(Fn && op)&&->invoke_result<Fn&&, E&&> {
+    static_assert(invocable<Fn&&, E&&>);
+    if (is_ok()) {
+      return Ok<void>{};
+    } else {
+      return std::forward<Fn&&>(op)(std::move(err_ref_()));
+    }
+  }
+
+  /// Checks that the result is `Ok`.
+  ///
+  /// # Panics
+  ///
+  /// Panics if the value is an `Err`, with a panic message provided by the
+  /// `Err`'s value.
+  void unwrap(
+      [[maybe_unused]] CallerLocation const& location = {}) && {
+    STX_EXPECTS(is_ok(), internal::result::no_value(err_cref_(), location));
+  }
+
+  /// Checks that the result is `Ok`.
+  ///
+  /// # Panics
+  ///
+  /// Panics if the value is an `Err`, with a panic message including the
+  /// passed message, and the content of the `Err`.
+  ///
+  /// # Examples
+  ///
+  /// Basic usage:
+  ///
+  /// ``` cpp
+  /// Result<void, string_view> x = Err("emergency failure"sv);
+  /// ASSERT_DEATH(move(x).expect("Testing expect"));
+  /// ```
+  void expect(
+      std::string_view const& msg,
+      [[maybe_unused]] CallerLocation const& location = {}) && {
+    STX_EXPECTS(is_ok(), internal::result::expect_value_failed(
+                             msg, err_cref_(), location));
+  }
+
+  /// Unwraps a result, yielding the content of an `Err`.
+  ///
+  /// # Panics
+  ///
+  /// Panics if the value is an `Ok`.
+  [[nodiscard]] auto unwrap_err(
+      [[maybe_unused]] CallerLocation const& location = {})&&->E {
+    STX_EXPECTS(is_err(), internal::result::no_err(location));
+    return std::move(err_ref_());
+  }
+
+  /// Moves the error out of the `Result<T, E>` without checking that it is in
+  /// the variant state of `Err<E>`.
+  ///
+  /// The check is only performed when `STX_ENABLE_DEBUG_ASSERTIONS` is
+  /// defined, otherwise the optimizer assumes the error is present.
+  ///
+  /// # Safety
+  ///
+  /// Calling this on an `Ok` is undefined behaviour in builds without debug
+  /// assertions and panics otherwise.
+  ///
+  /// # Examples
+  ///
+  /// Basic usage:
+  ///
+  /// ``` cpp
+  /// ASSERT_EQ(make_err<int, string_view>("oops"sv).unwrap_err_unchecked(),
+  ///           "oops"sv);
+  /// ```
+  [[nodiscard]] auto unwrap_err_unchecked(
+      [[maybe_unused]] CallerLocation const& location = {})&&->E {
+    STX_DEBUG_EXPECTS(is_err(), internal::result::no_err_unchecked(location));
+    return std::move(err_ref_());
+  }
+
+  /// Unwraps a result, yielding the content of an `Err`.
+  ///
+  /// # Panics
+  ///
+  /// Panics if the value is an `Ok`, with a panic message including the
+  /// passed message.
+  [[nodiscard]] auto expect_err(
+      std::string_view const& msg,
+      [[maybe_unused]] CallerLocation const& location = {})&&->E {
+    STX_EXPECTS(is_err(), internal::result::expect_err_failed(msg, location));
+    return std::move(err_ref_());
+  }
+
+  /// Calls the parameter `ok_fn` (with no argument) if this result is an
+  /// `Ok`, else calls `err_fn` with the error.
+  ///
+  /// # Examples
+  ///
+  /// Basic usage:
+  ///
+  /// ``` cpp
+  /// Result<void, string_view> x = Err("404 Not Found"sv);
+  /// auto code = move(x).match([]() { return 200; },
+  ///                           [](string_view) { return 404; });
+  /// ASSERT_EQ(code, 404);
+  /// ```
+  template <typename OkFn, typename ErrFn>
+  [[nodiscard]] constexpr auto match(
+      OkFn && ok_fn, ErrFn && err_fn)&&->invoke_result<OkFn&&> {
+    static_assert(invocable<OkFn&&>);
+    static_assert(invocable<ErrFn&&, E&&>);
+
+    if (is_ok()) {
+      return std::forward<OkFn&&>(ok_fn)();
+    } else {
+      return std::forward<ErrFn&&>(err_fn)(std::move(err_ref_()));
+    }
+  }
+
+  template <typename OkFn, typename ErrFn>
+  [[nodiscard]] constexpr auto match(
+      OkFn && ok_fn, ErrFn && err_fn)&->invoke_result<OkFn&&> {
+    static_assert(invocable<OkFn&&>);
+    static_assert(invocable<ErrFn&&, E&>);
+
+    if (is_ok()) {
+      return std::forward<OkFn&&>(ok_fn)();
+    } else {
+      return std::forward<ErrFn&&>(err_fn)(err_ref_());
+    }
+  }
+
+  template <typename OkFn, typename ErrFn>
+  [[nodiscard]] constexpr auto match(OkFn && ok_fn, ErrFn && err_fn)
+      const&->invoke_result<OkFn&&> {
+    static_assert(invocable<OkFn&&>);
+    static_assert(invocable<ErrFn&&, E const&>);
+
+    if (is_ok()) {
+      return std::forward<OkFn&&>(ok_fn)();
+    } else {
+      return std::forward<ErrFn&&>(err_fn)(err_cref_());
+    }
+  }
+
+  /// Destroys the contained error if present, leaving an `Ok` in its place.
+  ///
+  /// # Examples
+  ///
+  /// Basic usage:
+  ///
+  /// ``` cpp
+  /// Result<void, string> x = Err("oops"s);
+  /// x.emplace();
+  /// ASSERT_EQ(x, Ok());
+  /// ```
+  void emplace() noexcept {
+    if (is_err()) storage_.destroy();
+  }
+
+  /// Destroys the contained error if present and constructs a new one
+  /// in-place from `args`, returning a reference to it. `E` need not be
+  /// movable.
+  ///
+  /// If the construction throws, the result is left as an `Ok`.
+  ///
+  /// # Examples
+  ///
+  /// Basic usage:
+  ///
+  /// ``` cpp
+  /// Result<void, string> x = Ok();
+  /// x.emplace_err(3, 'x');
+  /// ASSERT_EQ(x, Err("xxx"s));
+  /// ```
+  template <typename... Args>
+  auto emplace_err(Args && ... args)->E& {
+    static_assert(std::is_constructible_v<E, Args&&...>);
+    if (is_err()) storage_.destroy();
+    storage_.construct(std::forward<Args>(args)...);
+    return err_ref_();
+  }
+
+  /// Returns a copy of the result and its contents.
+  [[nodiscard]] constexpr auto clone() const->Result<void, E> {
+    static_assert(copy_constructible<E>);
+
+    if (is_ok()) {
+      return Ok<void>{};
+    } else {
+      return Err<E>(std::move(E(err_cref_())));
+    }
+  }
+
+ private:
+  // `None` represents the `Ok` variant
+  internal::option::Storage<E> storage_;
+
+  [[nodiscard]] constexpr E& err_ref_() noexcept { return storage_.value(); }
+
+  [[nodiscard]] constexpr E const& err_cref_() const noexcept {
+    return storage_.value();
+  }
+
+  template <typename Tp, typename Er>
+  friend struct Result;
+
+  template <typename Tp, typename Er>
+  friend Er&& internal::result::unsafe_err_move(Result<Tp, Er>&);
+
+  // return object of a coroutine, the coroutine's promise writes the error
+  // into it
+  explicit Result(internal::result::Promise<void, E>& promise) noexcept
+      : storage_{} {
+    promise.bind(*this);
+  }
+
+  friend struct internal::result::Promise<void, E>;
+};
+
+/*********************    HELPER FUNCTIONS    *********************/
+
+/// Helper function to construct an `Option<T>` with a `Some<T>` value.
+/// if the template parameter is not specified, it is auto-deduced from the
+/// parameter's value.
+///
+/// # Examples
+///
+/// Basic usage:
+///
+///
+/// ``` cpp
+/// // these are some of the various ways to construct on Option<T> with a
+/// // Some<T> value
+/// Option g = Some(9);
+/// Option h = Some<int>(9);
+/// Option<int> i = Some(9);
+/// auto j = Option(Some(9));
+/// auto k = Option<int>(Some<int>(9));
+/// auto l = Option<int>(Some(9));
+/// // ... and a few more
+///
 /// // to make it easier and less verbose:
 /// auto m = make_some(9); // 'm' is of type Option<int>
 /// ASSERT_EQ(m, Some(9));
@@ -2771,6 +3490,29 @@ template <typename T>
   return Some<T>(std::forward<T>(value));
 }
 
+/// Helper function to construct an `Option<T>` with its value constructed
+/// in-place from `args`, the value is neither moved nor copied.
+/// note that the value parameter `T` must be specified.
+///
+/// # Examples
+///
+/// Basic usage:
+///
+/// ``` cpp
+/// auto m = make_some_in_place<vector<int>>(3, 0); // 'm' = Option<vector<int>>
+/// ASSERT_EQ(m, Some(vector{0, 0, 0}));
+/// ```
+///
+/// # Constexpr ?
+///
+/// C++ 20 and above
+///
+template <typename T, typename... Args>
+[[nodiscard]] STX_FORCE_INLINE constexpr auto make_some_in_place(
+    Args&&... args) -> Option<T> {
+  return Option<T>(std::in_place, std::forward<Args>(args)...);
+}
+
 /// Helper function to construct an `Option<T>` with a `None` value.
 /// note that the value parameter `T` must be specified.
 ///
@@ -2839,6 +3581,44 @@ template <typename T, typename E>
   return Ok<T>(std::forward<T>(value));
 }
 
+/// Helper function to construct a `Result<T, E>` with its value constructed
+/// in-place from `args`, the value is neither moved nor copied.
+///
+/// # Examples
+///
+/// Basic usage:
+///
+/// ``` cpp
+/// auto a = make_ok_in_place<string, int>(3, 'x'); // 'a' = Result<string, int>
+/// ASSERT_EQ(a, Ok("xxx"s));
+/// ```
+///
+/// # Constexpr ?
+///
+/// C++ 20 and above
+///
+template <typename T, typename E, typename... Args>
+[[nodiscard]] STX_FORCE_INLINE constexpr auto make_ok_in_place(Args&&... args)
+    -> Result<T, E> {
+  return Result<T, E>(std::in_place, std::forward<Args>(args)...);
+}
+
+/// Helper function to construct a `Result<void, E>` with an `Ok` value.
+///
+/// # Examples
+///
+/// Basic usage:
+///
+/// ``` cpp
+/// auto a = make_ok<void, string>(); // 'a' = Result<void, string>
+/// ASSERT_EQ(a, Ok());
+/// ```
+template <typename T, typename E,
+          typename = std::enable_if_t<std::is_void_v<T>>>
+[[nodiscard]] STX_FORCE_INLINE constexpr auto make_ok() -> Result<void, E> {
+  return Ok<void>{};
+}
+
 /// Helper function to construct a `Result<T, E>` with an `Err<E>` value.
 /// if the template parameter `E` is not specified, it is auto-deduced from the
 /// parameter's value.
@@ -2874,6 +3654,28 @@ template <typename T, typename E>
   return Err<E>(std::forward<E>(err));
 }
 
+/// Helper function to construct a `Result<T, E>` with its error constructed
+/// in-place from `args`, the error is neither moved nor copied.
+///
+/// # Examples
+///
+/// Basic usage:
+///
+/// ``` cpp
+/// auto a = make_err_in_place<int, string>(3, 'x'); // 'a' = Result<int, string>
+/// ASSERT_EQ(a, Err("xxx"s));
+/// ```
+///
+/// # Constexpr ?
+///
+/// C++ 20 and above
+///
+template <typename T, typename E, typename... Args>
+[[nodiscard]] STX_FORCE_INLINE constexpr auto make_err_in_place(Args&&... args)
+    -> Result<T, E> {
+  return Result<T, E>(err_in_place, std::forward<Args>(args)...);
+}
+
 /// Helper function to construct a `Some` containing a `std::reference_wrapper`
 /// (stx::Ref)
 ///
@@ -2949,6 +3751,22 @@ STX_FORCE_INLINE auto err_ref(E& value) noexcept {
   return Err<Ref<E>>(std::forward<E&>(value));
 }
 
+// the storages hold their payloads by value, alongside a trivially copyable
+// discriminant if any. They are thus trivially relocatable if their payloads
+// are.
+
+template <typename T>
+struct is_trivially_relocatable<Option<T>> : is_trivially_relocatable<T> {};
+
+template <typename T, typename E>
+struct is_trivially_relocatable<Result<T, E>>
+    : std::bool_constant<trivially_relocatable<T> &&
+                         trivially_relocatable<E>> {};
+
+template <typename E>
+struct is_trivially_relocatable<Result<void, E>>
+    : is_trivially_relocatable<E> {};
+
 STX_END_NAMESPACE
 
 // Error propagation macros
@@ -35,39 +35,47 @@ STX_BEGIN_NAMESPACE
 
 namespace internal {
 
-// Forced inline functions basically function like macros.
+// The helpers are out-of-line and cold so that the panic paths (report and
+// `begin_panic` call) stay out of the hot code of every `unwrap()`/`expect()`
+// call site, leaving only a branch and a call. The caller's `SourceLocation`
+// is captured by the default argument of the public method and passed along.
 
 namespace option {
 
 /// panic helper for `Option<T>::expect()` when no value is present
-[[noreturn]] STX_FORCE_INLINE void expect_value_failed(
-    std::string_view const& msg,
-    SourceLocation const& location = SourceLocation::current()) noexcept {
+[[noreturn]] STX_COLD STX_NOINLINE inline void expect_value_failed(
+    std::string_view const& msg, SourceLocation const& location) noexcept {
   panic(msg, location);
 }
 
 /// panic helper for `Option<T>::expect_none()` when a value is present
-[[noreturn]] STX_FORCE_INLINE void expect_none_failed(
-    std::string_view const& msg,
-    SourceLocation const& location = SourceLocation::current()) noexcept {
+[[noreturn]] STX_COLD STX_NOINLINE inline void expect_none_failed(
+    std::string_view const& msg, SourceLocation const& location) noexcept {
   panic(msg, location);
 }
 
 /// panic helper for `Option<T>::unwrap()` when no value is present
-[[noreturn]] STX_FORCE_INLINE void no_value(
-    SourceLocation const& location = SourceLocation::current()) noexcept {
+[[noreturn]] STX_COLD STX_NOINLINE inline void no_value(
+    SourceLocation const& location) noexcept {
   panic("called `Option::unwrap()` on a `None` value", location);
 }
 
+/// panic helper for `Option<T>::unwrap_unchecked()` when no value is present
+/// and debug assertions are enabled
+[[noreturn]] STX_COLD STX_NOINLINE inline void no_value_unchecked(
+    SourceLocation const& location) noexcept {
+  panic("called `Option::unwrap_unchecked()` on a `None` value", location);
+}
+
 /// panic helper for `Option<T>::value()` when no value is present
-[[noreturn]] STX_FORCE_INLINE void no_lref(
-    SourceLocation const& location = SourceLocation::current()) noexcept {
+[[noreturn]] STX_COLD STX_NOINLINE inline void no_lref(
+    SourceLocation const& location) noexcept {
   panic("called `Option::value()` on a `None` value", location);
 }
 
 /// panic helper for `Option<T>::unwrap_none()` when a value is present
-[[noreturn]] STX_FORCE_INLINE void no_none(
-    SourceLocation const& location = SourceLocation::current()) noexcept {
+[[noreturn]] STX_COLD STX_NOINLINE inline void no_none(
+    SourceLocation const& location) noexcept {
   panic("called `Option::unwrap_none()` on a `Some` value", location);
 }
 
@@ -77,48 +85,75 @@ namespace result {
 
 /// panic helper for `Result<T, E>::expect()` when no value is present
 template <typename T>
-[[noreturn]] STX_FORCE_INLINE void expect_value_failed(
+[[noreturn]] STX_COLD STX_NOINLINE inline void expect_value_failed(
     std::string_view const& msg, T const& err,
-    SourceLocation const& location = SourceLocation::current()) noexcept {
+    SourceLocation const& location) noexcept {
   panic(msg, err, location);
 }
 
 /// panic helper for `Result<T, E>::expect_err()` when a value is present
-[[noreturn]] STX_FORCE_INLINE void expect_err_failed(
-    std::string_view const& msg,
-    SourceLocation const& location = SourceLocation::current()) noexcept {
+[[noreturn]] STX_COLD STX_NOINLINE inline void expect_err_failed(
+    std::string_view const& msg, SourceLocation const& location) noexcept {
   panic(msg, location);
 }
 
 /// panic helper for `Result<T, E>::unwrap()` when no value is present
 template <typename T>
-[[noreturn]] STX_FORCE_INLINE void no_value(
-    T const& err,
-    SourceLocation const& location = SourceLocation::current()) noexcept {
+[[noreturn]] STX_COLD STX_NOINLINE inline void no_value(
+    T const& err, SourceLocation const& location) noexcept {
   panic("called `Result::unwrap()` on an `Err` value", err, location);
 }
 
+/// panic helper for `Result<T, E>::unwrap_unchecked()` when no value is
+/// present and debug assertions are enabled
+template <typename T>
+[[noreturn]] STX_COLD STX_NOINLINE inline void no_value_unchecked(
+    T const& err, SourceLocation const& location) noexcept {
+  panic("called `Result::unwrap_unchecked()` on an `Err` value", err, location);
+}
+
 /// panic helper for `Result<T, E>::value()` when no value is present
 template <typename T>
-[[noreturn]] STX_FORCE_INLINE void no_lref(
-    T const& err,
-    SourceLocation const& location = SourceLocation::current()) noexcept {
+[[noreturn]] STX_COLD STX_NOINLINE inline void no_lref(
+    T const& err, SourceLocation const& location) noexcept {
   panic("called `Result::value()` on an `Err` value", err, location);
 }
 
 /// panic helper for `Result<T, E>::unwrap_err()` when a value is present
-[[noreturn]] STX_FORCE_INLINE void no_err(
-    SourceLocation const& location = SourceLocation::current()) noexcept {
+[[noreturn]] STX_COLD STX_NOINLINE inline void no_err(
+    SourceLocation const& location) noexcept {
   panic("called `Result::unwrap_err()` on an `Ok` value", location);
 }
 
+/// panic helper for `Result<T, E>::unwrap_err_unchecked()` when a value is
+/// present and debug assertions are enabled
+[[noreturn]] STX_COLD STX_NOINLINE inline void no_err_unchecked(
+    SourceLocation const& location) noexcept {
+  panic("called `Result::unwrap_err_unchecked()` on an `Ok` value", location);
+}
+
 /// panic helper for `Result<T, E>::err_value()` when no value is present
-[[noreturn]] STX_FORCE_INLINE void no_err_lref(
-    SourceLocation const& location = SourceLocation::current()) noexcept {
+[[noreturn]] STX_COLD STX_NOINLINE inline void no_err_lref(
+    SourceLocation const& location) noexcept {
   panic("called `Result::err_value()` on an `Ok` value", location);
 }
 
 }  // namespace result
+
+namespace span {
+
+/// panic helper for `Span<T>::operator[]` when the index is out of bounds
+[[noreturn]] STX_COLD STX_NOINLINE inline void index_out_of_bounds() noexcept {
+  panic("`Span::operator[]` index out of bounds");
+}
+
+/// panic helper for `Span<T>::subspan()` when the subspan is out of bounds
+[[noreturn]] STX_COLD STX_NOINLINE inline void
+subspan_out_of_bounds() noexcept {
+  panic("`Span::subspan()` range out of bounds");
+}
+
+}  // namespace span
 }  // namespace internal
 
 STX_END_NAMESPACE
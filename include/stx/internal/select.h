@@ -0,0 +1,88 @@
+/**
+ * @file select.h
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-14
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+#include "stx/config.h"
+
+// Branchless selection between two objects.
+//
+// `Option` and `Result` combinators with an eagerly evaluated alternative
+// (i.e. `unwrap_or`) pick the contained value or the alternative with a
+// conditional jump, which the branch predictor gets wrong about half of the
+// time when the variant state is random. For small trivially copyable
+// payloads, they instead combine the object representations of both with a
+// mask derived from the variant state: the cost is a data dependency on the
+// state rather than a pipeline flush on every misprediction.
+//
+// Both objects are read. The unselected one may be an inactive union member
+// (i.e. the value of an `Option` in the `None` state), its bytes are masked
+// out and never reach the result.
+
+STX_BEGIN_NAMESPACE
+
+namespace internal {
+
+constexpr size_t kSelectMaxSize = 2 * sizeof(void*);
+
+template <typename T>
+constexpr bool is_selectable =
+    std::is_trivially_copyable_v<T> && std::is_copy_constructible_v<T> &&
+    sizeof(T) <= kSelectMaxSize;
+
+// returns `a` if `condition` is `true`, `b` otherwise. Unlike
+// `condition ? a : b`, the compiler can't turn the selection into a
+// conditional jump.
+template <typename T>
+[[nodiscard]] T select(bool condition, T const& a, T const& b) noexcept {
+  constexpr size_t kWords = (sizeof(T) + sizeof(uintptr_t) - 1) /
+                            sizeof(uintptr_t);
+  uintptr_t a_words[kWords] = {};
+  uintptr_t b_words[kWords] = {};
+  std::memcpy(a_words, std::addressof(a), sizeof(T));
+  std::memcpy(b_words, std::addressof(b), sizeof(T));
+  uintptr_t const mask =
+      static_cast<uintptr_t>(0) - static_cast<uintptr_t>(condition);
+  for (size_t i = 0; i < kWords; i++) {
+    b_words[i] = (a_words[i] & mask) | (b_words[i] & ~mask);
+  }
+  T result{b};
+  std::memcpy(std::addressof(result), b_words, sizeof(T));
+  return result;
+}
+
+}  // namespace internal
+
+STX_END_NAMESPACE
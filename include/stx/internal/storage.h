@@ -0,0 +1,823 @@
+/**
+ * @file storage.h
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-04-16
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "stx/common.h"
+#include "stx/niche.h"
+
+// Storage layouts for `Option<T>` and `Result<T, E>`.
+//
+// The storage owns the lifetime of the contained value. The layout-specific
+// base (`option::Base`, `result::Base`) only describes how the variant state
+// is represented, the special member functions are then stacked on top of it
+// as layers (`CopyCtorLayer`, ..., `DtorLayer`). Each layer is trivial
+// (implicitly defaulted) whenever the payloads allow it, `Option<T>` and
+// `Result<T, E>` are thus trivially copyable (and passed in registers)
+// whenever `T` and `E` are.
+//
+// Every `Option` base exposes the same interface:
+//
+// - `is_none()`: checks the variant state
+// - `value()`: accesses the contained value (unchecked)
+// - `construct(args...)`: constructs a value in-place, the storage must be in
+// the `None` state
+// - `destroy()`: destroys the contained value, the storage must be in the
+// `Some` state
+//
+// The tagged layout stores the value in a union alongside a separate `bool`
+// discriminant. The niche layout stores nothing but the value: the `None`
+// state is encoded by writing the value type's niche (see `niche_traits`) into
+// the value's storage.
+//
+// `Result` additionally has a pointer-tagged layout for pointer values with a
+// small trivially copyable error (i.e. an enum): the discriminant lives in the
+// pointer's lowest bit, which is always clear for an aligned pointer, and the
+// error is packed next to it, the whole `Result` is a single word.
+
+STX_BEGIN_NAMESPACE
+
+namespace internal {
+
+struct uninit_t {
+  explicit uninit_t() = default;
+};
+
+// storage constructed without a value, only used by the layers to construct
+// from another storage
+constexpr uninit_t uninit{};
+
+// uninitialized storage for a `T`, the lifetime of the value is managed by the
+// enclosing storage
+template <typename T, bool = std::is_trivially_destructible_v<T>>
+union Uninit {
+  constexpr Uninit() noexcept : none_{} {}
+
+  template <typename... Args>
+  constexpr explicit Uninit(std::in_place_t, Args&&... args)
+      : value_(std::forward<Args>(args)...) {}
+
+  char none_;
+  T value_;
+};
+
+template <typename T>
+union Uninit<T, false> {
+  constexpr Uninit() noexcept : none_{} {}
+
+  template <typename... Args>
+  constexpr explicit Uninit(std::in_place_t, Args&&... args)
+      : value_(std::forward<Args>(args)...) {}
+
+  STX_CXX20_DESTRUCTOR_CONSTEXPR ~Uninit() noexcept {}
+
+  char none_;
+  T value_;
+};
+
+// the layers below forward the special member functions to the base's
+// `construct_from`, `assign_from` and `reset` unless `Trivial` is true, in
+// which case they are implicitly defaulted and the base's (trivial) special
+// member functions are used.
+
+template <typename Base, bool Trivial>
+struct CopyCtorLayer : Base {
+  using Base::Base;
+};
+
+template <typename Base>
+struct CopyCtorLayer<Base, false> : Base {
+  using Base::Base;
+
+  CopyCtorLayer() = default;
+
+  CopyCtorLayer(CopyCtorLayer const& rhs) : Base{uninit} {
+    this->construct_from(static_cast<Base const&>(rhs));
+  }
+
+  CopyCtorLayer(CopyCtorLayer&&) = default;
+  CopyCtorLayer& operator=(CopyCtorLayer const&) = default;
+  CopyCtorLayer& operator=(CopyCtorLayer&&) = default;
+};
+
+template <typename Base, bool Trivial>
+struct MoveCtorLayer : Base {
+  using Base::Base;
+};
+
+template <typename Base>
+struct MoveCtorLayer<Base, false> : Base {
+  using Base::Base;
+
+  MoveCtorLayer() = default;
+  MoveCtorLayer(MoveCtorLayer const&) = default;
+
+  MoveCtorLayer(MoveCtorLayer&& rhs) : Base{uninit} {
+    this->construct_from(static_cast<Base&&>(rhs));
+  }
+
+  MoveCtorLayer& operator=(MoveCtorLayer const&) = default;
+  MoveCtorLayer& operator=(MoveCtorLayer&&) = default;
+};
+
+template <typename Base, bool Trivial>
+struct CopyAssignLayer : Base {
+  using Base::Base;
+};
+
+template <typename Base>
+struct CopyAssignLayer<Base, false> : Base {
+  using Base::Base;
+
+  CopyAssignLayer() = default;
+  CopyAssignLayer(CopyAssignLayer const&) = default;
+  CopyAssignLayer(CopyAssignLayer&&) = default;
+
+  CopyAssignLayer& operator=(CopyAssignLayer const& rhs) {
+    this->assign_from(static_cast<Base const&>(rhs));
+    return *this;
+  }
+
+  CopyAssignLayer& operator=(CopyAssignLayer&&) = default;
+};
+
+template <typename Base, bool Trivial>
+struct MoveAssignLayer : Base {
+  using Base::Base;
+};
+
+template <typename Base>
+struct MoveAssignLayer<Base, false> : Base {
+  using Base::Base;
+
+  MoveAssignLayer() = default;
+  MoveAssignLayer(MoveAssignLayer const&) = default;
+  MoveAssignLayer(MoveAssignLayer&&) = default;
+  MoveAssignLayer& operator=(MoveAssignLayer const&) = default;
+
+  MoveAssignLayer& operator=(MoveAssignLayer&& rhs) {
+    this->assign_from(static_cast<Base&&>(rhs));
+    return *this;
+  }
+};
+
+// outermost layer, a partially constructed storage is thus never destroyed
+// by it
+template <typename Base, bool Trivial>
+struct DtorLayer : Base {
+  using Base::Base;
+};
+
+template <typename Base>
+struct DtorLayer<Base, false> : Base {
+  using Base::Base;
+
+  DtorLayer() = default;
+  DtorLayer(DtorLayer const&) = default;
+  DtorLayer(DtorLayer&&) = default;
+  DtorLayer& operator=(DtorLayer const&) = default;
+  DtorLayer& operator=(DtorLayer&&) = default;
+
+  STX_CXX20_DESTRUCTOR_CONSTEXPR ~DtorLayer() noexcept { this->reset(); }
+};
+
+namespace option {
+
+template <typename T, bool HasNiche = niche_traits<T>::available>
+struct Base {
+  constexpr Base() noexcept : slot_{}, is_none_{true} {}
+
+  constexpr explicit Base(uninit_t) noexcept : Base{} {}
+
+  template <typename... Args>
+  constexpr explicit Base(std::in_place_t, Args&&... args)
+      : slot_{std::in_place, std::forward<Args>(args)...}, is_none_{false} {}
+
+  [[nodiscard]] constexpr bool is_none() const noexcept { return is_none_; }
+
+  [[nodiscard]] constexpr T& value() noexcept { return slot_.value_; }
+
+  [[nodiscard]] constexpr T const& value() const noexcept {
+    return slot_.value_;
+  }
+
+  template <typename... Args>
+  void construct(Args&&... args) {
+    new (&slot_.value_) T(std::forward<Args>(args)...);
+    is_none_ = false;
+  }
+
+  void destroy() noexcept {
+    slot_.value_.~T();
+    is_none_ = true;
+  }
+
+  Uninit<T> slot_;
+  bool is_none_;
+};
+
+template <typename T>
+struct Base<T, true> {
+  Base() noexcept : slot_{} { niche_traits<T>::set_none(&slot_.value_); }
+
+  explicit Base(uninit_t) noexcept : Base{} {}
+
+  template <typename... Args>
+  constexpr explicit Base(std::in_place_t, Args&&... args)
+      : slot_{std::in_place, std::forward<Args>(args)...} {}
+
+  [[nodiscard]] bool is_none() const noexcept {
+    return niche_traits<T>::is_none(&slot_.value_);
+  }
+
+  [[nodiscard]] constexpr T& value() noexcept { return slot_.value_; }
+
+  [[nodiscard]] constexpr T const& value() const noexcept {
+    return slot_.value_;
+  }
+
+  template <typename... Args>
+  void construct(Args&&... args) {
+    new (&slot_.value_) T(std::forward<Args>(args)...);
+  }
+
+  void destroy() noexcept {
+    slot_.value_.~T();
+    niche_traits<T>::set_none(&slot_.value_);
+  }
+
+  Uninit<T> slot_;
+};
+
+template <typename T>
+struct Ops : Base<T> {
+  using Base<T>::Base;
+
+  void construct_from(Ops const& rhs) {
+    if (!rhs.is_none()) {
+      this->construct(rhs.value());
+    }
+  }
+
+  void construct_from(Ops&& rhs) {
+    if (!rhs.is_none()) {
+      this->construct(std::move(rhs.value()));
+    }
+  }
+
+  void assign_from(Ops const& rhs) {
+    if (!this->is_none() && !rhs.is_none()) {
+      this->value() = rhs.value();
+    } else if (!this->is_none()) {
+      this->destroy();
+    } else if (!rhs.is_none()) {
+      this->construct(rhs.value());
+    }
+  }
+
+  void assign_from(Ops&& rhs) {
+    if (!this->is_none() && !rhs.is_none()) {
+      this->value() = std::move(rhs.value());
+    } else if (!this->is_none()) {
+      this->destroy();
+    } else if (!rhs.is_none()) {
+      this->construct(std::move(rhs.value()));
+    }
+  }
+
+  void reset() noexcept {
+    if (!this->is_none()) {
+      this->value().~T();
+    }
+  }
+};
+
+template <typename T>
+using Storage = DtorLayer<
+    MoveAssignLayer<
+        CopyAssignLayer<
+            MoveCtorLayer<
+                CopyCtorLayer<Ops<T>, std::is_trivially_copy_constructible_v<T>>,
+                std::is_trivially_move_constructible_v<T>>,
+            std::is_trivially_copy_constructible_v<T> &&
+                std::is_trivially_copy_assignable_v<T> &&
+                std::is_trivially_destructible_v<T>>,
+        std::is_trivially_move_constructible_v<T> &&
+            std::is_trivially_move_assignable_v<T> &&
+            std::is_trivially_destructible_v<T>>,
+    std::is_trivially_destructible_v<T>>;
+
+}  // namespace option
+
+namespace result {
+
+// a type with no state doesn't need storage when it is held by a `Result`,
+// it is materialized as an empty base instead.
+template <typename T, typename Other>
+constexpr bool is_stateless =
+    std::is_empty_v<T> && !std::is_final_v<T> &&
+    std::is_trivially_copyable_v<T> &&
+    std::is_trivially_default_constructible_v<T> &&
+    !std::is_base_of_v<T, Other>;
+
+template <typename T, typename = void>
+constexpr bool is_complete = false;
+
+template <typename T>
+constexpr bool is_complete<T, std::void_t<decltype(sizeof(T))>> = true;
+
+// alignment of the object a `T*` points to, `1` if it is unknown (`void`,
+// function and incomplete types)
+template <typename T, bool = is_complete<T>>
+constexpr size_t pointee_alignment = 1;
+
+template <typename T>
+constexpr size_t pointee_alignment<T, true> = alignof(T);
+
+// the error of a pointer-tagged `Result`, it overlays the pointer's lowest
+// byte with the discriminant and is packed right after it.
+template <typename E>
+struct TaggedErr {
+  template <typename... Args>
+  constexpr explicit TaggedErr(std::in_place_t, Args&&... args)
+      : tag_{1}, err_(std::forward<Args>(args)...) {}
+
+  unsigned char tag_;
+  E err_;
+};
+
+// a valid pointer to a `T` aligned to 2 bytes or more never has its lowest
+// bit set, an error small enough to fit in the rest of the pointer's word can
+// thus share its storage. Requires the pointer's lowest bits to be in its first
+// byte (little endian).
+template <typename T, typename E>
+constexpr bool is_pointer_taggable = false;
+
+template <typename T, typename E>
+constexpr bool is_pointer_taggable<T*, E> =
+    CFG(ENDIAN, LITTLE) && pointee_alignment<T> >= 2 &&
+    std::is_trivially_copyable_v<E> && std::is_trivially_destructible_v<E> &&
+    sizeof(TaggedErr<E>) <= sizeof(T*) && alignof(TaggedErr<E>) <= alignof(T*);
+
+// niche bytes of `E`, if `niche_traits<E>` confines its niche to the leading
+// `niche_bytes` of the error, `0` otherwise
+template <typename E, typename = void>
+constexpr size_t niche_bytes = 0;
+
+template <typename E>
+constexpr size_t
+    niche_bytes<E, std::void_t<decltype(niche_traits<E>::niche_bytes)>> =
+        niche_traits<E>::niche_bytes;
+
+// the value of a niche-packed `Result`, it skips the error's niche bytes and
+// overlays the error's remaining bytes.
+template <typename T, size_t NicheBytes>
+struct PackedValue {
+  template <typename... Args>
+  constexpr explicit PackedValue(std::in_place_t, Args&&... args)
+      : niche_{}, value_(std::forward<Args>(args)...) {}
+
+  unsigned char niche_[NicheBytes];
+  T value_;
+};
+
+// an error whose niche is confined to its leading bytes leaves its remaining
+// bytes unused while it holds the niche, a trivial value fitting in them can
+// share the error's storage.
+template <typename T, typename E, size_t NicheBytes = niche_bytes<E>>
+constexpr bool is_niche_packable =
+    NicheBytes != 0 && std::is_trivially_copyable_v<T> &&
+    std::is_trivially_destructible_v<T> && std::is_trivially_copyable_v<E> &&
+    std::is_trivially_destructible_v<E> &&
+    sizeof(PackedValue<T, NicheBytes>) <= sizeof(E) &&
+    alignof(PackedValue<T, NicheBytes>) <= alignof(E);
+
+template <typename T, typename E>
+constexpr bool is_niche_packable<T, E, 0> = false;
+
+enum class Layout : uint8_t {
+  // value and error in a union alongside a `bool` discriminant
+  Tagged,
+  // the value type's niche represents `Err`, the error type is stateless
+  ValueNiche,
+  // the error type's niche represents `Ok`, the value type is stateless
+  ErrNiche,
+  // the value is a pointer whose lowest bit is the discriminant, the error is
+  // packed next to it in the pointer's word
+  PointerTag,
+  // the error type's niche, confined to its leading bytes, represents `Ok`,
+  // the value is packed in the error's remaining bytes
+  ErrNichePacked
+};
+
+template <typename T, typename E>
+constexpr Layout layout =
+    (niche_traits<T>::available && is_stateless<E, T>)
+        ? Layout::ValueNiche
+        : ((niche_traits<E>::available && is_stateless<T, E>)
+               ? Layout::ErrNiche
+               : (is_pointer_taggable<T, E>
+                      ? Layout::PointerTag
+                      : (is_niche_packable<T, E> ? Layout::ErrNichePacked
+                                                 : Layout::Tagged)));
+
+template <typename T, typename E,
+          bool = std::is_trivially_destructible_v<T> &&
+                 std::is_trivially_destructible_v<E>>
+union UninitPair {
+  constexpr UninitPair() noexcept : none_{} {}
+
+  template <typename... Args>
+  constexpr explicit UninitPair(std::in_place_index_t<0>, Args&&... args)
+      : value_(std::forward<Args>(args)...) {}
+
+  template <typename... Args>
+  constexpr explicit UninitPair(std::in_place_index_t<1>, Args&&... args)
+      : err_(std::forward<Args>(args)...) {}
+
+  char none_;
+  T value_;
+  E err_;
+};
+
+template <typename T, typename E>
+union UninitPair<T, E, false> {
+  constexpr UninitPair() noexcept : none_{} {}
+
+  template <typename... Args>
+  constexpr explicit UninitPair(std::in_place_index_t<0>, Args&&... args)
+      : value_(std::forward<Args>(args)...) {}
+
+  template <typename... Args>
+  constexpr explicit UninitPair(std::in_place_index_t<1>, Args&&... args)
+      : err_(std::forward<Args>(args)...) {}
+
+  STX_CXX20_DESTRUCTOR_CONSTEXPR ~UninitPair() noexcept {}
+
+  char none_;
+  T value_;
+  E err_;
+};
+
+// Every `Result` base exposes the same interface:
+//
+// - `is_ok()`: checks the variant state
+// - `value()`, `err()`: accesses the value or error (unchecked)
+// - `construct_value(args...)`, `construct_err(args...)`: constructs a value
+// or error in-place, the storage must have been destroyed
+// - `destroy()`: destroys the contained value or error
+//
+template <typename T, typename E, Layout = layout<T, E>>
+struct Base {
+  constexpr explicit Base(uninit_t) noexcept : slot_{}, is_ok_{false} {}
+
+  template <typename... Args>
+  constexpr explicit Base(std::in_place_index_t<0>, Args&&... args)
+      : slot_{std::in_place_index<0>, std::forward<Args>(args)...},
+        is_ok_{true} {}
+
+  template <typename... Args>
+  constexpr explicit Base(std::in_place_index_t<1>, Args&&... args)
+      : slot_{std::in_place_index<1>, std::forward<Args>(args)...},
+        is_ok_{false} {}
+
+  [[nodiscard]] constexpr bool is_ok() const noexcept { return is_ok_; }
+
+  [[nodiscard]] constexpr T& value() noexcept { return slot_.value_; }
+
+  [[nodiscard]] constexpr T const& value() const noexcept {
+    return slot_.value_;
+  }
+
+  [[nodiscard]] constexpr E& err() noexcept { return slot_.err_; }
+
+  [[nodiscard]] constexpr E const& err() const noexcept { return slot_.err_; }
+
+  template <typename... Args>
+  void construct_value(Args&&... args) {
+    new (&slot_.value_) T(std::forward<Args>(args)...);
+    is_ok_ = true;
+  }
+
+  template <typename... Args>
+  void construct_err(Args&&... args) {
+    new (&slot_.err_) E(std::forward<Args>(args)...);
+    is_ok_ = false;
+  }
+
+  void destroy() noexcept {
+    if (is_ok_) {
+      slot_.value_.~T();
+    } else {
+      slot_.err_.~E();
+    }
+  }
+
+  UninitPair<T, E> slot_;
+  bool is_ok_;
+};
+
+template <typename T, typename E>
+struct Base<T, E, Layout::ValueNiche> : private E {
+  explicit Base(uninit_t) noexcept : E{}, slot_{} {
+    niche_traits<T>::set_none(&slot_.value_);
+  }
+
+  template <typename... Args>
+  constexpr explicit Base(std::in_place_index_t<0>, Args&&... args)
+      : E{}, slot_{std::in_place, std::forward<Args>(args)...} {}
+
+  template <typename... Args>
+  explicit Base(std::in_place_index_t<1>, Args&&... args)
+      : E(std::forward<Args>(args)...), slot_{} {
+    niche_traits<T>::set_none(&slot_.value_);
+  }
+
+  [[nodiscard]] bool is_ok() const noexcept {
+    return !niche_traits<T>::is_none(&slot_.value_);
+  }
+
+  [[nodiscard]] constexpr T& value() noexcept { return slot_.value_; }
+
+  [[nodiscard]] constexpr T const& value() const noexcept {
+    return slot_.value_;
+  }
+
+  [[nodiscard]] constexpr E& err() noexcept { return *this; }
+
+  [[nodiscard]] constexpr E const& err() const noexcept { return *this; }
+
+  template <typename... Args>
+  void construct_value(Args&&... args) {
+    new (&slot_.value_) T(std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  void construct_err(Args&&... args) {
+    new (static_cast<E*>(this)) E(std::forward<Args>(args)...);
+    niche_traits<T>::set_none(&slot_.value_);
+  }
+
+  void destroy() noexcept {
+    if (is_ok()) {
+      slot_.value_.~T();
+    }
+  }
+
+  Uninit<T> slot_;
+};
+
+template <typename T, typename E>
+struct Base<T, E, Layout::ErrNiche> : private T {
+  explicit Base(uninit_t) noexcept : T{}, slot_{} {
+    niche_traits<E>::set_none(&slot_.value_);
+  }
+
+  template <typename... Args>
+  explicit Base(std::in_place_index_t<0>, Args&&... args)
+      : T(std::forward<Args>(args)...), slot_{} {
+    niche_traits<E>::set_none(&slot_.value_);
+  }
+
+  template <typename... Args>
+  constexpr explicit Base(std::in_place_index_t<1>, Args&&... args)
+      : T{}, slot_{std::in_place, std::forward<Args>(args)...} {}
+
+  [[nodiscard]] bool is_ok() const noexcept {
+    return niche_traits<E>::is_none(&slot_.value_);
+  }
+
+  [[nodiscard]] constexpr T& value() noexcept { return *this; }
+
+  [[nodiscard]] constexpr T const& value() const noexcept { return *this; }
+
+  [[nodiscard]] constexpr E& err() noexcept { return slot_.value_; }
+
+  [[nodiscard]] constexpr E const& err() const noexcept {
+    return slot_.value_;
+  }
+
+  template <typename... Args>
+  void construct_value(Args&&... args) {
+    new (static_cast<T*>(this)) T(std::forward<Args>(args)...);
+    niche_traits<E>::set_none(&slot_.value_);
+  }
+
+  template <typename... Args>
+  void construct_err(Args&&... args) {
+    new (&slot_.value_) E(std::forward<Args>(args)...);
+  }
+
+  void destroy() noexcept {
+    if (!is_ok()) {
+      slot_.value_.~E();
+    }
+  }
+
+  Uninit<E> slot_;
+};
+
+template <typename T, typename E>
+struct Base<T, E, Layout::PointerTag> {
+  union Word {
+    template <typename... Args>
+    constexpr explicit Word(std::in_place_index_t<0>, Args&&... args)
+        : value_(std::forward<Args>(args)...) {}
+
+    template <typename... Args>
+    constexpr explicit Word(std::in_place_index_t<1>, Args&&... args)
+        : err_{std::in_place, std::forward<Args>(args)...} {}
+
+    T value_;
+    TaggedErr<E> err_;
+  };
+
+  constexpr explicit Base(uninit_t) noexcept
+      : slot_{std::in_place_index<0>, nullptr} {}
+
+  template <typename... Args>
+  constexpr explicit Base(std::in_place_index_t<0>, Args&&... args)
+      : slot_{std::in_place_index<0>, std::forward<Args>(args)...} {}
+
+  template <typename... Args>
+  constexpr explicit Base(std::in_place_index_t<1>, Args&&... args)
+      : slot_{std::in_place_index<1>, std::forward<Args>(args)...} {}
+
+  [[nodiscard]] bool is_ok() const noexcept {
+    unsigned char low;
+    std::memcpy(&low, static_cast<void const*>(&slot_), 1);
+    return (low & 1) == 0;
+  }
+
+  [[nodiscard]] constexpr T& value() noexcept { return slot_.value_; }
+
+  [[nodiscard]] constexpr T const& value() const noexcept {
+    return slot_.value_;
+  }
+
+  [[nodiscard]] constexpr E& err() noexcept { return slot_.err_.err_; }
+
+  [[nodiscard]] constexpr E const& err() const noexcept {
+    return slot_.err_.err_;
+  }
+
+  template <typename... Args>
+  void construct_value(Args&&... args) {
+    new (&slot_.value_) T(std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  void construct_err(Args&&... args) {
+    new (&slot_.err_) TaggedErr<E>(std::in_place, std::forward<Args>(args)...);
+  }
+
+  // both the pointer and the error are trivially destructible
+  void destroy() noexcept {}
+
+  Word slot_;
+};
+
+template <typename T, typename E>
+struct Base<T, E, Layout::ErrNichePacked> {
+  union Word {
+    constexpr Word() noexcept : none_{} {}
+
+    template <typename... Args>
+    constexpr explicit Word(std::in_place_index_t<0>, Args&&... args)
+        : value_{std::in_place, std::forward<Args>(args)...} {}
+
+    template <typename... Args>
+    constexpr explicit Word(std::in_place_index_t<1>, Args&&... args)
+        : err_(std::forward<Args>(args)...) {}
+
+    char none_;
+    PackedValue<T, niche_bytes<E>> value_;
+    E err_;
+  };
+
+  explicit Base(uninit_t) noexcept : slot_{} {
+    niche_traits<E>::set_none(&slot_.err_);
+  }
+
+  template <typename... Args>
+  explicit Base(std::in_place_index_t<0>, Args&&... args)
+      : slot_{std::in_place_index<0>, std::forward<Args>(args)...} {
+    niche_traits<E>::set_none(&slot_.err_);
+  }
+
+  template <typename... Args>
+  constexpr explicit Base(std::in_place_index_t<1>, Args&&... args)
+      : slot_{std::in_place_index<1>, std::forward<Args>(args)...} {}
+
+  [[nodiscard]] bool is_ok() const noexcept {
+    return niche_traits<E>::is_none(&slot_.err_);
+  }
+
+  [[nodiscard]] constexpr T& value() noexcept { return slot_.value_.value_; }
+
+  [[nodiscard]] constexpr T const& value() const noexcept {
+    return slot_.value_.value_;
+  }
+
+  [[nodiscard]] constexpr E& err() noexcept { return slot_.err_; }
+
+  [[nodiscard]] constexpr E const& err() const noexcept { return slot_.err_; }
+
+  template <typename... Args>
+  void construct_value(Args&&... args) {
+    new (&slot_.value_) PackedValue<T, niche_bytes<E>>(
+        std::in_place, std::forward<Args>(args)...);
+    niche_traits<E>::set_none(&slot_.err_);
+  }
+
+  template <typename... Args>
+  void construct_err(Args&&... args) {
+    new (&slot_.err_) E(std::forward<Args>(args)...);
+  }
+
+  // both the value and the error are trivially destructible
+  void destroy() noexcept {}
+
+  Word slot_;
+};
+
+template <typename T, typename E>
+struct Ops : Base<T, E> {
+  using Base<T, E>::Base;
+
+  void construct_from(Ops&& rhs) {
+    if (rhs.is_ok()) {
+      this->construct_value(std::move(rhs.value()));
+    } else {
+      this->construct_err(std::move(rhs.err()));
+    }
+  }
+
+  void assign_from(Ops&& rhs) {
+    if (this->is_ok() && rhs.is_ok()) {
+      this->value() = std::move(rhs.value());
+    } else if (!this->is_ok() && !rhs.is_ok()) {
+      this->err() = std::move(rhs.err());
+    } else if (rhs.is_ok()) {
+      this->destroy();
+      this->construct_value(std::move(rhs.value()));
+    } else {
+      this->destroy();
+      this->construct_err(std::move(rhs.err()));
+    }
+  }
+
+  void reset() noexcept { this->destroy(); }
+};
+
+// `Result` is not copyable, only the move operations are layered
+template <typename T, typename E>
+using Storage = DtorLayer<
+    MoveAssignLayer<
+        MoveCtorLayer<Ops<T, E>, std::is_trivially_move_constructible_v<T> &&
+                                     std::is_trivially_move_constructible_v<E>>,
+        std::is_trivially_move_constructible_v<T> &&
+            std::is_trivially_move_assignable_v<T> &&
+            std::is_trivially_destructible_v<T> &&
+            std::is_trivially_move_constructible_v<E> &&
+            std::is_trivially_move_assignable_v<E> &&
+            std::is_trivially_destructible_v<E>>,
+    std::is_trivially_destructible_v<T> && std::is_trivially_destructible_v<E>>;
+
+}  // namespace result
+}  // namespace internal
+
+STX_END_NAMESPACE
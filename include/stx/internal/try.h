@@ -75,7 +75,7 @@ STX_END_NAMESPACE
       "and r-value references ");                                              \
   decltype((result_expr))&& STX_ARG_UNIQUE_PLACEHOLDER = (result_expr);        \
                                                                                \
-  if (STX_ARG_UNIQUE_PLACEHOLDER.is_err())                                     \
+  if (STX_UNLIKELY(STX_ARG_UNIQUE_PLACEHOLDER.is_err()))                       \
     return ::stx::Err<typename std::remove_reference_t<decltype(               \
         (result_expr))>::error_type>(                                          \
         ::stx::internal::result::unsafe_err_move(STX_ARG_UNIQUE_PLACEHOLDER)); \
@@ -84,8 +84,23 @@ STX_END_NAMESPACE
       qualifier_identifier = ::stx::internal::result::unsafe_value_move(       \
           STX_ARG_UNIQUE_PLACEHOLDER);
 
-#define STX_TRY_SOME_IMPL_(STX_ARG_UNIQUE_PLACEHOLDER, qualifier_identifier, \
-                           option_expr)                                      \
+#define STX_TRY_OK_DISCARD_IMPL_(STX_ARG_UNIQUE_PLACEHOLDER, result_expr)      \
+  static_assert(!::std::is_const_v<decltype((result_expr))>,                   \
+                "the expression: ' " #result_expr                              \
+                " ' evaluates to a const and is not mutable");                 \
+  static_assert(                                                               \
+      !::std::is_lvalue_reference_v<decltype((result_expr))>,                  \
+      "the expression: ' " #result_expr                                        \
+      " ' evaluates to an l-value reference, 'TRY_OK' only accepts r-values "  \
+      "and r-value references ");                                              \
+  decltype((result_expr))&& STX_ARG_UNIQUE_PLACEHOLDER = (result_expr);        \
+                                                                               \
+  if (STX_UNLIKELY(STX_ARG_UNIQUE_PLACEHOLDER.is_err()))                       \
+    return ::stx::Err<typename std::remove_reference_t<decltype(               \
+        (result_expr))>::error_type>(                                          \
+        ::stx::internal::result::unsafe_err_move(STX_ARG_UNIQUE_PLACEHOLDER));
+
+#define STX_TRY_SOME_DISCARD_IMPL_(STX_ARG_UNIQUE_PLACEHOLDER, option_expr) \
   static_assert(!::std::is_const_v<decltype((option_expr))>,                 \
                 "the expression: ' " #option_expr                            \
                 " ' evaluates to a const and is not mutable");               \
@@ -96,21 +111,58 @@ STX_END_NAMESPACE
                 "and r-value references ");                                  \
   decltype((option_expr))&& STX_ARG_UNIQUE_PLACEHOLDER = (option_expr);      \
                                                                              \
-  if (STX_ARG_UNIQUE_PLACEHOLDER.is_none()) return ::stx::None;              \
+  if (STX_UNLIKELY(STX_ARG_UNIQUE_PLACEHOLDER.is_none()))                    \
+    return ::stx::None;
+
+#define STX_TRY_SOME_IMPL_(STX_ARG_UNIQUE_PLACEHOLDER, qualifier_identifier, \
+                           option_expr)                                      \
+  STX_TRY_SOME_DISCARD_IMPL_(STX_ARG_UNIQUE_PLACEHOLDER, option_expr)        \
                                                                              \
   typename std::remove_reference_t<decltype((option_expr))>::value_type      \
       qualifier_identifier = ::stx::internal::option::unsafe_value_move(     \
           STX_ARG_UNIQUE_PLACEHOLDER);
 
+#define STX_TRY_OK_REF_IMPL_(STX_ARG_UNIQUE_PLACEHOLDER, identifier,           \
+                             result_expr)                                      \
+  STX_TRY_OK_DISCARD_IMPL_(STX_ARG_UNIQUE_PLACEHOLDER, result_expr)            \
+                                                                               \
+  typename std::remove_reference_t<decltype((result_expr))>::value_type &&     \
+      identifier = ::stx::internal::result::unsafe_value_move(                 \
+          STX_ARG_UNIQUE_PLACEHOLDER);
+
+#define STX_TRY_SOME_REF_IMPL_(STX_ARG_UNIQUE_PLACEHOLDER, identifier,     \
+                               option_expr)                                \
+  STX_TRY_SOME_DISCARD_IMPL_(STX_ARG_UNIQUE_PLACEHOLDER, option_expr)      \
+                                                                           \
+  typename std::remove_reference_t<decltype((option_expr))>::value_type && \
+      identifier = ::stx::internal::option::unsafe_value_move(             \
+          STX_ARG_UNIQUE_PLACEHOLDER);
+
+#define STX_TRY_OK_2_(qualifier_identifier, result_expr)            \
+  STX_TRY_OK_IMPL_(                                                 \
+      STX_WITH_UNIQUE_SUFFIX_(STX_TRY_OK_PLACEHOLDER, __COUNTER__), \
+      qualifier_identifier, result_expr)
+
+#define STX_TRY_OK_1_(result_expr)                                  \
+  STX_TRY_OK_DISCARD_IMPL_(                                         \
+      STX_WITH_UNIQUE_SUFFIX_(STX_TRY_OK_PLACEHOLDER, __COUNTER__), \
+      result_expr)
+
+#define STX_TRY_EXPAND_(x) x
+#define STX_TRY_SELECT_(_1, _2, NAME, ...) NAME
+
 /// if `result_expr` is a `Result` containing an error, `TRY_OK` returns its
 /// `Err` value.
 ///
 /// `result_expr` must be an expression yielding an r-value (reference) of type
 /// `Result`
-#define TRY_OK(qualifier_identifier, result_expr)                   \
-  STX_TRY_OK_IMPL_(                                                 \
-      STX_WITH_UNIQUE_SUFFIX_(STX_TRY_OK_PLACEHOLDER, __COUNTER__), \
-      qualifier_identifier, result_expr)
+///
+/// - `TRY_OK(qualifier_identifier, result_expr)` binds the `Ok` value to
+/// `qualifier_identifier`
+/// - `TRY_OK(result_expr)` discards the `Ok` value, i.e. for `Result<void, E>`
+#define TRY_OK(...)                                            \
+  STX_TRY_EXPAND_(STX_TRY_SELECT_(__VA_ARGS__, STX_TRY_OK_2_,  \
+                                  STX_TRY_OK_1_)(__VA_ARGS__))
 
 /// if `option_expr` evaluates to an `Option` containing a `None`, `TRY_SOME`
 /// returns its `None` value.
@@ -121,3 +173,85 @@ STX_END_NAMESPACE
   STX_TRY_SOME_IMPL_(                                                 \
       STX_WITH_UNIQUE_SUFFIX_(STX_TRY_SOME_PLACEHOLDER, __COUNTER__), \
       qualifier_identifier, option_expr)
+
+/// if `result_expr` is a `Result` containing an error, `TRY_OK_REF` returns
+/// its `Err` value, else it binds an r-value reference to the `Ok` value to
+/// `identifier`.
+///
+/// Unlike `TRY_OK`, the value is not moved out of the `Result`. If
+/// `result_expr` yields a temporary, its lifetime is extended to that of
+/// `identifier`, which thus remains valid until the end of the enclosing
+/// scope. This avoids a move per propagation level for large values.
+///
+/// `result_expr` must be an expression yielding an r-value (reference) of type
+/// `Result`. `identifier` can't be cv-qualified.
+///
+/// # Examples
+///
+/// ``` cpp
+/// auto parse = [](Span<uint8_t const> bytes) -> Result<Message, Error> {
+///   TRY_OK_REF(header, parse_header(bytes));
+///   return Ok(Message{std::move(header), ...});
+/// };
+/// ```
+#define TRY_OK_REF(identifier, result_expr)                               \
+  STX_TRY_OK_REF_IMPL_(                                                   \
+      STX_WITH_UNIQUE_SUFFIX_(STX_TRY_OK_REF_PLACEHOLDER, __COUNTER__),   \
+      identifier, result_expr)
+
+/// if `option_expr` evaluates to an `Option` containing a `None`,
+/// `TRY_SOME_REF` returns its `None` value, else it binds an r-value reference
+/// to the contained value to `identifier`. See `TRY_OK_REF`.
+///
+/// `option_expr` must be an expression yielding an r-value (reference) of type
+/// `Option`. `identifier` can't be cv-qualified.
+#define TRY_SOME_REF(identifier, option_expr)                               \
+  STX_TRY_SOME_REF_IMPL_(                                                   \
+      STX_WITH_UNIQUE_SUFFIX_(STX_TRY_SOME_REF_PLACEHOLDER, __COUNTER__),   \
+      identifier, option_expr)
+
+#if CFG(COMPILER, GNUC)
+
+// `__extension__` silences the pedantic warnings about statement-expressions
+#define STX_TRY_OK_EXPR_IMPL_(STX_ARG_UNIQUE_PLACEHOLDER, result_expr) \
+  __extension__({                                                      \
+    STX_TRY_OK_DISCARD_IMPL_(STX_ARG_UNIQUE_PLACEHOLDER, result_expr)  \
+    ::stx::internal::result::unsafe_value_move(                        \
+        STX_ARG_UNIQUE_PLACEHOLDER);                                   \
+  })
+
+#define STX_TRY_SOME_EXPR_IMPL_(STX_ARG_UNIQUE_PLACEHOLDER, option_expr) \
+  __extension__({                                                        \
+    STX_TRY_SOME_DISCARD_IMPL_(STX_ARG_UNIQUE_PLACEHOLDER, option_expr)  \
+    ::stx::internal::option::unsafe_value_move(                          \
+        STX_ARG_UNIQUE_PLACEHOLDER);                                     \
+  })
+
+/// expression form of `TRY_OK` (GNU statement-expressions, GCC and Clang
+/// only). If `result_expr` is a `Result` containing an error, the enclosing
+/// function returns its `Err` value, else the expression evaluates to the
+/// `Ok` value (moved out of the `Result`).
+///
+/// `result_expr` must be an expression yielding an r-value (reference) of type
+/// `Result`
+///
+/// # Examples
+///
+/// ``` cpp
+/// auto add = [](string_view a, string_view b) -> Result<int, Error> {
+///   return Ok(TRY_OK_EXPR(parse_int(a)) + TRY_OK_EXPR(parse_int(b)));
+/// };
+/// ```
+#define TRY_OK_EXPR(result_expr)                                      \
+  STX_TRY_OK_EXPR_IMPL_(                                              \
+      STX_WITH_UNIQUE_SUFFIX_(STX_TRY_OK_EXPR_PLACEHOLDER, __COUNTER__), \
+      result_expr)
+
+/// expression form of `TRY_SOME` (GNU statement-expressions, GCC and Clang
+/// only). See `TRY_OK_EXPR`.
+#define TRY_SOME_EXPR(option_expr)                                        \
+  STX_TRY_SOME_EXPR_IMPL_(                                                \
+      STX_WITH_UNIQUE_SUFFIX_(STX_TRY_SOME_EXPR_PLACEHOLDER, __COUNTER__), \
+      option_expr)
+
+#endif
@@ -0,0 +1,166 @@
+/**
+ * @file niche.h
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-04-16
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <type_traits>
+
+#include "stx/config.h"
+
+STX_BEGIN_NAMESPACE
+
+//! Customization point describing a bit-pattern (a "niche") that can never be
+//! taken by a valid value of type `T`.
+//!
+//! `Option<T>` uses the niche to represent `None` instead of storing a
+//! separate discriminant, and `Result<T, E>` uses it to represent the
+//! alternative holding an empty error (or value) type. i.e.
+//! `sizeof(Option<T>) == sizeof(T)` whenever `niche_traits<T>::available` is
+//! `true`.
+//!
+//! A specialization must provide:
+//!
+//! - `static constexpr bool available = true;`
+//! - `static void set_none(T* slot) noexcept;`: writes the niche into `slot`,
+//! `slot` points to uninitialized storage for a `T`.
+//! - `static bool is_none(T const* slot) noexcept;`: checks if `slot` holds
+//! the niche. `slot` either holds a valid `T` or the niche.
+//!
+//! A specialization can also provide:
+//!
+//! - `static constexpr size_t niche_bytes;`: the niche is confined to the
+//! leading `niche_bytes` bytes of a `T`, `set_none` writes and `is_none` reads
+//! only those. A `Result<U, T>` of trivially copyable `U` and `T` then packs
+//! its value in the remaining bytes, i.e. `sizeof(Result<U, T>) == sizeof(T)`
+//! if the `U` fits in them.
+//!
+//! As a consequence, a `T` holding the niche can't be stored in the `Some`
+//! or `Ok` variant. It will be read back as `None` or `Err`.
+//!
+//! The specialization must be visible before the first instantiation of
+//! `Option<T>` or `Result<T, E>`, preferably in the header declaring `T`.
+//!
+//! Built-in niches are provided for pointers (the null pointer), `Ref<T>`
+//! (the all-zero bit-pattern) and `bool` (any byte other than `0` and `1`).
+//! Integral and enum types opt in via `sentinel_niche_traits`.
+//!
+//! # Examples
+//!
+//! ``` cpp
+//! enum class Slot : uint32_t { Invalid = UINT32_MAX };
+//!
+//! template <>
+//! struct stx::niche_traits<Slot>
+//!     : stx::sentinel_niche_traits<Slot, Slot::Invalid> {};
+//!
+//! static_assert(sizeof(Option<Slot>) == sizeof(Slot));
+//! ```
+//!
+template <typename T>
+struct niche_traits {
+  static constexpr bool available = false;
+};
+
+/// niche for integral and enum types with a sentinel value that is never used
+/// as a valid value, i.e. `-1` for file descriptors, `UINT32_MAX` for slot
+/// indices and an `Invalid` enumerator.
+template <typename T, T Sentinel>
+struct sentinel_niche_traits {
+  static_assert(std::is_integral_v<T> || std::is_enum_v<T>,
+                "'sentinel_niche_traits' only supports integral and enum types");
+
+  static constexpr bool available = true;
+
+  static constexpr T sentinel = Sentinel;
+
+  static void set_none(T* slot) noexcept { new (slot) T(Sentinel); }
+
+  static constexpr bool is_none(T const* slot) noexcept {
+    return *slot == Sentinel;
+  }
+};
+
+/// the null pointer represents the niche.
+template <typename T>
+struct niche_traits<T*> {
+  static constexpr bool available = true;
+
+  static void set_none(T** slot) noexcept { new (slot) T*(nullptr); }
+
+  static constexpr bool is_none(T* const* slot) noexcept {
+    return *slot == nullptr;
+  }
+};
+
+/// `std::reference_wrapper` is a non-null pointer on all the supported
+/// standard library implementations, the all-zero bit-pattern is thus never a
+/// valid reference.
+template <typename T>
+struct niche_traits<std::reference_wrapper<T>> {
+  static constexpr bool available =
+      sizeof(std::reference_wrapper<T>) == sizeof(uintptr_t);
+
+  static void set_none(std::reference_wrapper<T>* slot) noexcept {
+    std::memset(static_cast<void*>(slot), 0, sizeof(uintptr_t));
+  }
+
+  static bool is_none(std::reference_wrapper<T> const* slot) noexcept {
+    uintptr_t bits;
+    std::memcpy(&bits, static_cast<void const*>(slot), sizeof(uintptr_t));
+    return bits == 0;
+  }
+};
+
+/// a `bool` is represented as `0` (`false`) or `1` (`true`) by all the
+/// supported ABIs, any other byte value is never a valid `bool`.
+template <>
+struct niche_traits<bool> {
+  static constexpr bool available = sizeof(bool) == 1;
+
+  static constexpr unsigned char niche = 2;
+
+  static void set_none(bool* slot) noexcept {
+    std::memset(static_cast<void*>(slot), niche, 1);
+  }
+
+  static bool is_none(bool const* slot) noexcept {
+    unsigned char byte;
+    std::memcpy(&byte, static_cast<void const*>(slot), 1);
+    return byte == niche;
+  }
+};
+
+template <typename T>
+constexpr bool has_niche = niche_traits<T>::available;
+
+STX_END_NAMESPACE
@@ -0,0 +1,479 @@
+/**
+ * @file option_vec.h
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-19
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "stx/config.h"
+#include "stx/internal/bitmask.h"
+#include "stx/internal/panic_helpers.h"
+#include "stx/option.h"
+#include "stx/relocation.h"
+
+STX_BEGIN_NAMESPACE
+
+namespace internal {
+namespace option_slots {
+
+// element operations shared by `OptionArray` and `OptionVec`: `slots` holds
+// an uninitialized slot per element, only the slots whose bit is set in
+// `present` hold a value.
+
+template <typename T>
+Option<MutRef<T>> get(T* slots, uint64_t const* present, size_t index) {
+  if (bitmask::get(present, index)) return Some(MutRef<T>(slots[index]));
+  return None;
+}
+
+template <typename T>
+Option<ConstRef<T>> get(T const* slots, uint64_t const* present,
+                        size_t index) {
+  if (bitmask::get(present, index)) return Some(ConstRef<T>(slots[index]));
+  return None;
+}
+
+template <typename T, typename... Args>
+T& emplace(T* slots, uint64_t* present, size_t index, Args&&... args) {
+  if (bitmask::get(present, index)) {
+    slots[index].~T();
+    bitmask::clear(present, index);
+  }
+  T* value = new (slots + index) T(std::forward<Args>(args)...);
+  bitmask::set(present, index);
+  return *value;
+}
+
+template <typename T>
+Option<T> take(T* slots, uint64_t* present, size_t index) {
+  if (!bitmask::get(present, index)) return None;
+  Option<T> value = Some(std::move(slots[index]));
+  slots[index].~T();
+  bitmask::clear(present, index);
+  return value;
+}
+
+template <typename T>
+void destroy(T* slots, uint64_t const* present, size_t size) noexcept {
+  if constexpr (!std::is_trivially_destructible_v<T>) {
+    bitmask::for_each_set(present, size,
+                          [&](size_t index) { slots[index].~T(); });
+  }
+}
+
+}  // namespace option_slots
+}  // namespace internal
+
+//! A fixed-size array of `N` optional `T`s, storing the presence of the
+//! elements in a bitmask.
+//!
+//! `Option<double>` is 16 bytes wide, half of it being the padded
+//! discriminant: an array of `Option<double>` wastes half of the memory
+//! bandwidth spent on it. `OptionArray` stores the values densely, one slot
+//! per element, and the states in a separate bitmask. Counting the present
+//! elements only reads the bitmask, 64 elements per word, and iterating them
+//! skips the absent elements a word at a time.
+//!
+//! Elements are accessed as `Option<MutRef<T>>` (or `Option<ConstRef<T>>`)
+//! pointing into the array.
+//!
+//! # Examples
+//!
+//! ``` cpp
+//! OptionArray<double, 1440> samples;  // one per minute
+//! samples.emplace(0, 20.5);
+//! samples.emplace(60, 21.0);
+//!
+//! ASSERT_EQ(samples.count_some(), 2);
+//! ASSERT_EQ(samples[0], Some(ConstRef<double>(20.5)));
+//! ASSERT_EQ(samples[1], None);
+//! ```
+//!
+template <typename T, size_t N>
+struct OptionArray {
+  static_assert(!std::is_reference_v<T>,
+                "'OptionArray' does not store references, use 'Ref<T>'");
+
+  using value_type = T;
+
+  OptionArray() noexcept : present_{} {}
+
+  /// moves the present elements, `other`'s elements are left moved-from
+  OptionArray(OptionArray&& other) noexcept(
+      std::is_nothrow_move_constructible_v<T>)
+      : present_{} {
+    move_from(other);
+  }
+
+  OptionArray& operator=(OptionArray&& other) noexcept(
+      std::is_nothrow_move_constructible_v<T>) {
+    if (this != &other) {
+      clear();
+      move_from(other);
+    }
+    return *this;
+  }
+
+  OptionArray(OptionArray const&) = delete;
+  OptionArray& operator=(OptionArray const&) = delete;
+
+  ~OptionArray() noexcept {
+    internal::option_slots::destroy(slots(), present_, N);
+  }
+
+  [[nodiscard]] static constexpr size_t size() noexcept { return N; }
+
+  [[nodiscard]] bool is_some(size_t index) const noexcept {
+    STX_AUDIT_EXPECTS(index < N, internal::span::index_out_of_bounds());
+    return internal::bitmask::get(present_, index);
+  }
+
+  [[nodiscard]] bool is_none(size_t index) const noexcept {
+    return !is_some(index);
+  }
+
+  /// accesses an element (not bounds-checked, except at the audit contract
+  /// level).
+  [[nodiscard]] Option<MutRef<T>> operator[](size_t index) noexcept {
+    STX_AUDIT_EXPECTS(index < N, internal::span::index_out_of_bounds());
+    return internal::option_slots::get(slots(), present_, index);
+  }
+
+  /// accesses an element (not bounds-checked, except at the audit contract
+  /// level).
+  [[nodiscard]] Option<ConstRef<T>> operator[](size_t index) const noexcept {
+    STX_AUDIT_EXPECTS(index < N, internal::span::index_out_of_bounds());
+    return internal::option_slots::get(slots(), present_, index);
+  }
+
+  /// constructs the element at `index` in-place, destroying the previous one
+  /// if any.
+  template <typename... Args>
+  T& emplace(size_t index, Args&&... args) {
+    STX_AUDIT_EXPECTS(index < N, internal::span::index_out_of_bounds());
+    return internal::option_slots::emplace(slots(), present_, index,
+                                           std::forward<Args>(args)...);
+  }
+
+  /// takes the element at `index` out of the array, leaving `None` in its
+  /// place, see `Option::take`.
+  [[nodiscard]] Option<T> take(size_t index) {
+    STX_AUDIT_EXPECTS(index < N, internal::span::index_out_of_bounds());
+    return internal::option_slots::take(slots(), present_, index);
+  }
+
+  /// destroys all the elements
+  void clear() noexcept {
+    internal::option_slots::destroy(slots(), present_, N);
+    std::memset(present_, 0, sizeof(present_));
+  }
+
+  /// number of present elements, only the bitmask is read.
+  [[nodiscard]] size_t count_some() const noexcept {
+    return internal::bitmask::count(present_, N);
+  }
+
+  /// calls `fn(index, value)` for each present element, in order.
+  template <typename Fn>
+  void for_each_some(Fn&& fn) {
+    static_assert(invocable<Fn&, size_t, T&>);
+    T* const values = slots();
+    internal::bitmask::for_each_set(
+        present_, N, [&](size_t index) { fn(index, values[index]); });
+  }
+
+  /// calls `fn(index, value)` for each present element, in order.
+  template <typename Fn>
+  void for_each_some(Fn&& fn) const {
+    static_assert(invocable<Fn&, size_t, T const&>);
+    T const* const values = slots();
+    internal::bitmask::for_each_set(
+        present_, N, [&](size_t index) { fn(index, values[index]); });
+  }
+
+ private:
+  uint64_t present_[std::max<size_t>(internal::bitmask::words_for(N), 1)];
+  alignas(T) unsigned char storage_[std::max<size_t>(N * sizeof(T), 1)];
+
+  T* slots() noexcept { return std::launder(reinterpret_cast<T*>(storage_)); }
+
+  T const* slots() const noexcept {
+    return std::launder(reinterpret_cast<T const*>(storage_));
+  }
+
+  void move_from(OptionArray& other) {
+    T* const values = slots();
+    T* const other_values = other.slots();
+    internal::bitmask::for_each_set(other.present_, N, [&](size_t index) {
+      new (values + index) T(std::move(other_values[index]));
+      internal::bitmask::set(present_, index);
+    });
+  }
+};
+
+//! A growable sequence of optional `T`s, storing the presence of the
+//! elements in a bitmask. See `OptionArray`.
+//!
+//! # Examples
+//!
+//! ``` cpp
+//! OptionVec<double> samples;
+//! samples.push(Some(20.5));
+//! samples.push(None);
+//! samples.push_some(21.0);
+//!
+//! double sum = 0;
+//! samples.for_each_some([&](size_t, double value) { sum += value; });
+//! ASSERT_EQ(sum, 41.5);
+//! ```
+//!
+template <typename T>
+struct OptionVec {
+  static_assert(!std::is_reference_v<T>,
+                "'OptionVec' does not store references, use 'Ref<T>'");
+
+  using value_type = T;
+
+  OptionVec() noexcept = default;
+
+  OptionVec(OptionVec&& other) noexcept
+      : values_{std::exchange(other.values_, nullptr)},
+        present_{std::exchange(other.present_, nullptr)},
+        size_{std::exchange(other.size_, 0)},
+        capacity_{std::exchange(other.capacity_, 0)} {}
+
+  OptionVec& operator=(OptionVec&& other) noexcept {
+    if (this != &other) {
+      release();
+      values_ = std::exchange(other.values_, nullptr);
+      present_ = std::exchange(other.present_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+      capacity_ = std::exchange(other.capacity_, 0);
+    }
+    return *this;
+  }
+
+  OptionVec(OptionVec const&) = delete;
+  OptionVec& operator=(OptionVec const&) = delete;
+
+  ~OptionVec() noexcept { release(); }
+
+  [[nodiscard]] size_t size() const noexcept { return size_; }
+
+  [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+  [[nodiscard]] size_t capacity() const noexcept { return capacity_; }
+
+  /// makes room for at least `capacity` elements
+  void reserve(size_t capacity) {
+    if (capacity > capacity_) grow(capacity);
+  }
+
+  /// appends `option`, moving its value into the array if present
+  void push(Option<T>&& option) {
+    if (option.is_some()) {
+      push_some(internal::option::unsafe_value_move(option));
+    } else {
+      push_none();
+    }
+  }
+
+  /// appends a present element, constructed in-place from `args`
+  template <typename... Args>
+  void push_some(Args&&... args) {
+    if (size_ == capacity_) {
+      // constructed before the values are relocated, `args` can refer to an
+      // element
+      T element(std::forward<Args>(args)...);
+      grow(size_ + 1);
+      new (values_ + size_) T(std::move(element));
+    } else {
+      new (values_ + size_) T(std::forward<Args>(args)...);
+    }
+    internal::bitmask::set(present_, size_);
+    size_++;
+  }
+
+  /// appends an absent element
+  void push_none() {
+    if (size_ == capacity_) grow(size_ + 1);
+    size_++;
+  }
+
+  /// destroys all the elements, the capacity is kept
+  void clear() noexcept {
+    if (size_ == 0) return;
+    internal::option_slots::destroy(values_, present_, size_);
+    std::memset(present_, 0,
+                internal::bitmask::words_for(size_) * sizeof(uint64_t));
+    size_ = 0;
+  }
+
+  [[nodiscard]] bool is_some(size_t index) const noexcept {
+    STX_AUDIT_EXPECTS(index < size_, internal::span::index_out_of_bounds());
+    return internal::bitmask::get(present_, index);
+  }
+
+  [[nodiscard]] bool is_none(size_t index) const noexcept {
+    return !is_some(index);
+  }
+
+  /// accesses an element (not bounds-checked, except at the audit contract
+  /// level).
+  [[nodiscard]] Option<MutRef<T>> operator[](size_t index) noexcept {
+    STX_AUDIT_EXPECTS(index < size_, internal::span::index_out_of_bounds());
+    return internal::option_slots::get(values_, present_, index);
+  }
+
+  /// accesses an element (not bounds-checked, except at the audit contract
+  /// level).
+  [[nodiscard]] Option<ConstRef<T>> operator[](size_t index) const noexcept {
+    STX_AUDIT_EXPECTS(index < size_, internal::span::index_out_of_bounds());
+    return internal::option_slots::get(
+        static_cast<T const*>(values_), present_, index);
+  }
+
+  /// constructs the element at `index` in-place, destroying the previous one
+  /// if any.
+  template <typename... Args>
+  T& emplace(size_t index, Args&&... args) {
+    STX_AUDIT_EXPECTS(index < size_, internal::span::index_out_of_bounds());
+    return internal::option_slots::emplace(values_, present_, index,
+                                           std::forward<Args>(args)...);
+  }
+
+  /// takes the element at `index` out of the vector, leaving `None` in its
+  /// place, see `Option::take`.
+  [[nodiscard]] Option<T> take(size_t index) {
+    STX_AUDIT_EXPECTS(index < size_, internal::span::index_out_of_bounds());
+    return internal::option_slots::take(values_, present_, index);
+  }
+
+  /// number of present elements, only the bitmask is read.
+  [[nodiscard]] size_t count_some() const noexcept {
+    return internal::bitmask::count(present_, size_);
+  }
+
+  /// calls `fn(index, value)` for each present element, in order.
+  template <typename Fn>
+  void for_each_some(Fn&& fn) {
+    static_assert(invocable<Fn&, size_t, T&>);
+    internal::bitmask::for_each_set(
+        present_, size_, [&](size_t index) { fn(index, values_[index]); });
+  }
+
+  /// calls `fn(index, value)` for each present element, in order.
+  template <typename Fn>
+  void for_each_some(Fn&& fn) const {
+    static_assert(invocable<Fn&, size_t, T const&>);
+    internal::bitmask::for_each_set(present_, size_, [&](size_t index) {
+      fn(index, std::as_const(values_[index]));
+    });
+  }
+
+ private:
+  T* values_ = nullptr;
+  uint64_t* present_ = nullptr;
+  size_t size_ = 0;
+  size_t capacity_ = 0;
+
+  static constexpr size_t kAlignment = std::max(alignof(T), alignof(uint64_t));
+
+  // the values and the bitmask share a single allocation
+  static constexpr size_t present_offset(size_t capacity) noexcept {
+    return (capacity * sizeof(T) + alignof(uint64_t) - 1) / alignof(uint64_t) *
+           alignof(uint64_t);
+  }
+
+  // grows to at least `min_capacity` elements, relocating the values
+  void grow(size_t min_capacity) {
+    size_t capacity =
+        capacity_ == 0 ? internal::bitmask::kWordBits : capacity_ * 2;
+    if (capacity < min_capacity) capacity = min_capacity;
+    size_t const num_words = internal::bitmask::words_for(capacity);
+
+    auto* const memory = static_cast<unsigned char*>(
+        ::operator new(present_offset(capacity) + num_words * sizeof(uint64_t),
+                       std::align_val_t{kAlignment}));
+    T* const values = reinterpret_cast<T*>(memory);
+    uint64_t* const present =
+        reinterpret_cast<uint64_t*>(memory + present_offset(capacity));
+
+    std::memset(present, 0, num_words * sizeof(uint64_t));
+    if (size_ != 0) {
+      std::memcpy(present, present_,
+                  internal::bitmask::words_for(size_) * sizeof(uint64_t));
+      relocate(values);
+    }
+
+    deallocate();
+    values_ = values;
+    present_ = present;
+    capacity_ = capacity;
+  }
+
+  // moves the elements into `values` and destroys the old ones
+  void relocate(T* values) noexcept {
+    if constexpr (trivially_relocatable<T>) {
+      // the slots of the absent elements hold no object, their bytes are
+      // copied along and never read
+      std::memcpy(static_cast<void*>(values), values_, size_ * sizeof(T));
+    } else {
+      static_assert(std::is_nothrow_move_constructible_v<T>,
+                    "'OptionVec' requires a non-throwing move constructor");
+      internal::bitmask::for_each_set(present_, size_, [&](size_t index) {
+        new (values + index) T(std::move(values_[index]));
+        values_[index].~T();
+      });
+    }
+  }
+
+  void deallocate() noexcept {
+    if (capacity_ == 0) return;
+    ::operator delete(static_cast<void*>(values_),
+                      std::align_val_t{kAlignment});
+  }
+
+  void release() noexcept {
+    internal::option_slots::destroy(values_, present_, size_);
+    deallocate();
+  }
+};
+
+/// `OptionVec` only owns its elements through a pointer.
+template <typename T>
+struct is_trivially_relocatable<OptionVec<T>> : std::true_type {};
+
+STX_END_NAMESPACE
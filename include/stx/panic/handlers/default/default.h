@@ -110,6 +110,18 @@ inline void panic_default(std::string_view const& info,
     }
   }
 
+#if defined(STX_COMPACT_SOURCE_LOCATION)
+
+  // resolved offline with 'scripts/resolve_call_site.py'
+  std::fputs("' at call site: '", stderr);
+
+  STX_PANIC_EPRINTF_WITH(fmt_buffer, kFmtBufferSize, "0x%08" PRIx32,
+                         location.id());
+
+  std::fputs("'\n", stderr);
+
+#else
+
   std::fputs("' at function: '", stderr);
 
   std::fputs(location.function_name(), stderr);
@@ -140,6 +152,8 @@ inline void panic_default(std::string_view const& info,
 
   std::fputs("]\n", stderr);
 
+#endif
+
   std::fflush(stderr);
 
 #if defined(STX_ENABLE_PANIC_BACKTRACE)
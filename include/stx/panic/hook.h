@@ -79,6 +79,77 @@ namespace this_thread {
 [[nodiscard]] STX_EXPORT bool is_panicking() noexcept;
 }  // namespace this_thread
 
+/// A callback the panicking thread runs before calling the panic hook, i.e.
+/// to wake other threads waiting for a value it will never produce since the
+/// panic hook aborts or halts the thread.
+///
+/// Guards are pushed and popped in a stack order on the current thread and
+/// must outlive their registration. The guards are popped and run
+/// most-recently-pushed first, a guard that panics aborts the program.
+///
+struct PanicGuard {
+  using Callback = void (*)(void* context) noexcept;
+
+  Callback on_panic = nullptr;
+  void* context = nullptr;
+  PanicGuard* previous = nullptr;
+};
+
+namespace this_thread {
+
+/// Registers `guard` to be run if the current thread panics.
+///
+/// # Thread-safe?
+///
+/// Yes, guards are per-thread.
+///
+STX_EXPORT void push_panic_guard(PanicGuard& guard) noexcept;
+
+/// Unregisters `guard`, which must be the last guard pushed on the current
+/// thread.
+///
+/// # Panics
+///
+/// Panics if `guard` isn't the last guard pushed on the current thread.
+///
+/// # Thread-safe?
+///
+/// Yes, guards are per-thread.
+///
+STX_EXPORT void pop_panic_guard(PanicGuard& guard) noexcept;
+}  // namespace this_thread
+
+/// Pushes a `PanicGuard` on construction and pops it on destruction, the
+/// guard is thus also popped when the scope is left by an exception.
+///
+/// # Examples
+///
+/// ``` cpp
+/// ScopedPanicGuard guard{[](void* queue) noexcept {
+///   static_cast<Queue*>(queue)->close();
+/// }, &queue};
+/// produce(queue);
+/// ```
+///
+class ScopedPanicGuard {
+ public:
+  ScopedPanicGuard(PanicGuard::Callback on_panic, void* context) noexcept {
+    guard_.on_panic = on_panic;
+    guard_.context = context;
+    this_thread::push_panic_guard(guard_);
+  }
+
+  ScopedPanicGuard(ScopedPanicGuard const&) = delete;
+  ScopedPanicGuard& operator=(ScopedPanicGuard const&) = delete;
+  ScopedPanicGuard(ScopedPanicGuard&&) = delete;
+  ScopedPanicGuard& operator=(ScopedPanicGuard&&) = delete;
+
+  ~ScopedPanicGuard() { this_thread::pop_panic_guard(guard_); }
+
+ private:
+  PanicGuard guard_;
+};
+
 /// Checks if panic hooks are visible to be attached-to when loaded as a dynamic
 /// library. This should be called before calling any of `attach_panic_hook` or
 /// `take_panic_hook` when loaded as a dynamic library.
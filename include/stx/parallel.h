@@ -0,0 +1,385 @@
+/**
+ * @file parallel.h
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-20
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+
+#include "stx/algorithm.h"
+#include "stx/config.h"
+#include "stx/option.h"
+#include "stx/result.h"
+#include "stx/span.h"
+
+// Parallel algorithms over spans, for fallible element-wise operations.
+//
+// The input is split into chunks that are processed by the threads of a
+// `par::ThreadPool` and the calling thread. The first `Err` cancels the
+// chunks and elements that follow it, and the `Err` with the lowest index is
+// returned.
+
+#if defined(STX_NO_STD_THREAD_MUTEX)
+#error "`stx/parallel.h` requires std::thread and std::mutex"
+#endif
+
+STX_BEGIN_NAMESPACE
+
+namespace par {
+
+/// A fixed-size pool of threads executing batches of jobs (fork-join).
+///
+/// The calling thread of `run()` participates in the batch and `run()` only
+/// returns once all of the batch's jobs have completed, the jobs can thus
+/// refer to the caller's stack.
+///
+/// # Thread-safe?
+///
+/// Yes, concurrent calls to `run()` are serialized. A `run()` call from
+/// within a job executes its jobs on the calling thread.
+///
+class ThreadPool {
+ public:
+  using Job = void (*)(void* context, size_t index);
+
+  /// creates a pool using `num_threads` threads, including the thread calling
+  /// `run()`. `num_threads - 1` worker threads are started.
+  STX_EXPORT explicit ThreadPool(size_t num_threads);
+
+  ThreadPool(ThreadPool const&) = delete;
+  ThreadPool& operator=(ThreadPool const&) = delete;
+  ThreadPool(ThreadPool&&) = delete;
+  ThreadPool& operator=(ThreadPool&&) = delete;
+
+  /// stops and joins the worker threads.
+  STX_EXPORT ~ThreadPool();
+
+  /// the number of threads executing the jobs, including the calling thread.
+  size_t num_threads() const noexcept { return num_threads_; }
+
+  /// Calls `job(context, i)` for every `i` in `[0, num_jobs)`, each exactly
+  /// once, on the threads of the pool and the calling thread. Returns once
+  /// all of the calls have returned.
+  ///
+  /// # Panics
+  ///
+  /// Panics if `num_jobs` is 2^32 or more.
+  STX_EXPORT void run(size_t num_jobs, Job job, void* context) noexcept;
+
+ private:
+  struct State;
+
+  size_t num_threads_;
+  std::unique_ptr<State> state_;
+};
+
+/// The process-wide pool used by the algorithms when no pool is specified.
+/// It uses `std::thread::hardware_concurrency()` threads and is created on
+/// first use.
+[[nodiscard]] STX_EXPORT ThreadPool& default_thread_pool() noexcept;
+
+}  // namespace par
+
+namespace internal {
+namespace par {
+
+constexpr size_t kCacheLineSize = 64;
+
+/// number of chunks per thread, more chunks balance the load better when the
+/// elements' costs vary.
+constexpr size_t kChunksPerThread = 4;
+
+/// number of elements processed between two checks of the cancellation, a
+/// failure is thus noticed by the other threads within this many elements.
+constexpr size_t kCancellationInterval = 64;
+
+/// Splits `[0, size)` into chunks whose boundaries fall on cache line
+/// boundaries of `T` elements starting at `data`, so the threads do not write
+/// to the same cache lines.
+///
+/// The first chunk holds the `head` elements before the first cache line
+/// boundary in addition to its `stride` elements.
+struct Chunks {
+  size_t size = 0;
+  size_t head = 0;
+  size_t stride = 1;
+  size_t count = 0;
+
+  template <typename T>
+  static Chunks split(T const* data, size_t size, size_t num_threads) noexcept {
+    // `stride` is a multiple of the number of elements spanning a whole
+    // number of cache lines
+    constexpr size_t kLineElements =
+        kCacheLineSize / std::gcd(sizeof(T), kCacheLineSize);
+
+    Chunks chunks;
+    chunks.size = size;
+    if (size == 0) return chunks;
+
+    if constexpr (kCacheLineSize % sizeof(T) == 0) {
+      size_t const misalignment =
+          reinterpret_cast<uintptr_t>(data) % kCacheLineSize;
+      chunks.head =
+          std::min(size, ((kCacheLineSize - misalignment) % kCacheLineSize) /
+                             sizeof(T));
+    }
+
+    size_t const target = num_threads * kChunksPerThread;
+    size_t const stride = (size + target - 1) / target;
+    chunks.stride =
+        (stride + kLineElements - 1) / kLineElements * kLineElements;
+
+    size_t const rest = size - chunks.head;
+    chunks.count =
+        rest <= chunks.stride
+            ? 1
+            : 1 + (rest - chunks.stride + chunks.stride - 1) / chunks.stride;
+    return chunks;
+  }
+
+  size_t begin(size_t chunk) const noexcept {
+    return chunk == 0 ? 0 : std::min(size, head + chunk * stride);
+  }
+
+  size_t end(size_t chunk) const noexcept {
+    return std::min(size, head + (chunk + 1) * stride);
+  }
+};
+
+/// The lowest failing index and its error, shared by the threads.
+///
+/// Elements at or after `failed_index` are cancelled, the elements before it
+/// keep being processed as they can still fail with a lower index.
+template <typename E>
+struct Cancellation {
+  std::atomic<size_t> failed_index{std::numeric_limits<size_t>::max()};
+  std::mutex mutex;
+  Option<E> error = None;
+
+  bool cancelled(size_t index) const noexcept {
+    return index >= failed_index.load(std::memory_order_relaxed);
+  }
+
+  void fail(size_t index, E&& err) {
+    std::lock_guard<std::mutex> lock{mutex};
+    if (index < failed_index.load(std::memory_order_relaxed)) {
+      error = Some(std::move(err));
+      failed_index.store(index, std::memory_order_relaxed);
+    }
+  }
+};
+
+/// Runs `body(begin, end, cancellation)` for every chunk, skipping the chunks
+/// starting after a failed element.
+template <typename E, typename Body>
+void run_chunks(::stx::par::ThreadPool& pool, Chunks const& chunks,
+                Cancellation<E>& cancellation, Body& body) noexcept {
+  struct Context {
+    Chunks const& chunks;
+    Cancellation<E>& cancellation;
+    Body& body;
+  } context{chunks, cancellation, body};
+
+  pool.run(
+      chunks.count,
+      [](void* opaque, size_t chunk) {
+        Context& ctx = *static_cast<Context*>(opaque);
+        size_t const begin = ctx.chunks.begin(chunk);
+        if (ctx.cancellation.cancelled(begin)) return;
+        ctx.body(begin, ctx.chunks.end(chunk), ctx.cancellation);
+      },
+      &context);
+}
+
+}  // namespace par
+}  // namespace internal
+
+namespace par {
+
+/// Writes `f(input[i])` into `output[i]` for every element of `input`, in
+/// parallel on the threads of `pool`. `f` returns a `Result` and the first
+/// `Err` cancels the processing of the elements that follow it.
+///
+/// Returns the prefix of `output` holding the values, or the `Err` with the
+/// lowest index. When an error is returned, the values of the elements
+/// preceding it have been written into `output`.
+///
+/// The input is split into chunks whose output boundaries are aligned to
+/// cache lines, `f` is thus called concurrently and must be thread-safe.
+///
+/// # Panics
+///
+/// Panics if `output` is smaller than `input`.
+///
+/// # Examples
+///
+/// Basic usage:
+///
+/// ``` cpp
+/// auto parse = [](string_view row) -> Result<int, ParseError> { ... };
+///
+/// vector<string_view> rows = ...;
+/// vector<int> values(rows.size());
+///
+/// TRY_OK(parsed, par::try_transform(Span<string_view>(rows),
+///                                   Span<int>(values), parse));
+/// ```
+template <typename In, size_t InExtent, typename Out, size_t OutExtent,
+          typename F>
+[[nodiscard]] auto try_transform(ThreadPool& pool, Span<In, InExtent> input,
+                                 Span<Out, OutExtent> output, F&& f)
+    -> Result<Span<Out>,
+              typename internal::algorithm::result_types<
+                  std::invoke_result_t<F&, In&>>::error_type> {
+  using E = typename internal::algorithm::result_types<
+      std::invoke_result_t<F&, In&>>::error_type;
+  STX_CHECK(output.size() >= input.size(),
+            internal::algorithm::output_too_small());
+
+  In* const inputs = input.data();
+  Out* const values = output.data();
+  size_t const size = input.size();
+
+  auto body = [&](size_t begin, size_t end,
+                  internal::par::Cancellation<E>& cancellation) {
+    for (size_t block = begin; block < end && !cancellation.cancelled(block);
+         block += internal::par::kCancellationInterval) {
+      size_t const block_end =
+          std::min(end, block + internal::par::kCancellationInterval);
+      for (size_t i = block; i < block_end; i++) {
+        auto result = f(inputs[i]);
+        if (result.is_err()) {
+          cancellation.fail(i, internal::result::unsafe_err_move(result));
+          return;
+        }
+        values[i] = internal::result::unsafe_value_move(result);
+      }
+    }
+  };
+
+  internal::par::Cancellation<E> cancellation;
+  internal::par::run_chunks(
+      pool,
+      internal::par::Chunks::split(values, size, pool.num_threads()),
+      cancellation, body);
+
+  if (cancellation.error.is_some()) {
+    return Err<E>(
+        E(internal::option::unsafe_value_move(cancellation.error)));
+  }
+  return Ok(Span<Out>(values, size));
+}
+
+/// Same as `try_transform(pool, input, output, f)`, on the default thread
+/// pool.
+template <typename In, size_t InExtent, typename Out, size_t OutExtent,
+          typename F>
+[[nodiscard]] auto try_transform(Span<In, InExtent> input,
+                                 Span<Out, OutExtent> output, F&& f) {
+  return try_transform(default_thread_pool(), input, output,
+                       std::forward<F>(f));
+}
+
+/// Calls `f(element)` for every element of `input`, in parallel on the
+/// threads of `pool`. `f` returns a `Result` and the first `Err` cancels the
+/// processing of the elements that follow it.
+///
+/// Returns `Ok()`, or the `Err` with the lowest index. When an error is
+/// returned, `f` has been called on all of the elements preceding it.
+///
+/// `f` is called concurrently and must be thread-safe.
+///
+/// # Examples
+///
+/// Basic usage:
+///
+/// ``` cpp
+/// auto validate = [](Request const& request) -> Result<void, Error> {
+///   ...
+/// };
+///
+/// TRY_OK(par::try_for_each(Span<Request const>(requests), validate));
+/// ```
+template <typename In, size_t InExtent, typename F>
+[[nodiscard]] auto try_for_each(ThreadPool& pool, Span<In, InExtent> input,
+                                F&& f)
+    -> Result<void, typename internal::algorithm::result_types<
+                        std::invoke_result_t<F&, In&>>::error_type> {
+  using E = typename internal::algorithm::result_types<
+      std::invoke_result_t<F&, In&>>::error_type;
+
+  In* const inputs = input.data();
+  size_t const size = input.size();
+
+  auto body = [&](size_t begin, size_t end,
+                  internal::par::Cancellation<E>& cancellation) {
+    for (size_t block = begin; block < end && !cancellation.cancelled(block);
+         block += internal::par::kCancellationInterval) {
+      size_t const block_end =
+          std::min(end, block + internal::par::kCancellationInterval);
+      for (size_t i = block; i < block_end; i++) {
+        auto result = f(inputs[i]);
+        if (result.is_err()) {
+          cancellation.fail(i, internal::result::unsafe_err_move(result));
+          return;
+        }
+      }
+    }
+  };
+
+  internal::par::Cancellation<E> cancellation;
+  internal::par::run_chunks(
+      pool, internal::par::Chunks::split(inputs, size, pool.num_threads()),
+      cancellation, body);
+
+  if (cancellation.error.is_some()) {
+    return Err<E>(
+        E(internal::option::unsafe_value_move(cancellation.error)));
+  }
+  return Ok();
+}
+
+/// Same as `try_for_each(pool, input, f)`, on the default thread pool.
+template <typename In, size_t InExtent, typename F>
+[[nodiscard]] auto try_for_each(Span<In, InExtent> input, F&& f) {
+  return try_for_each(default_thread_pool(), input, std::forward<F>(f));
+}
+
+}  // namespace par
+
+STX_END_NAMESPACE
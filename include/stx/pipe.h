@@ -0,0 +1,471 @@
+/**
+ * @file pipe.h
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-16
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+#include "stx/config.h"
+#include "stx/option.h"
+#include "stx/result.h"
+
+STX_BEGIN_NAMESPACE
+
+// Lazy `Option` and `Result` pipelines.
+//
+// `std::move(opt).map(f).and_then(g).unwrap_or(x)` materializes and moves an
+// `Option` at every step, and checks its state again at every step. A
+// pipeline instead only records the stages, it is evaluated once the
+// terminal stage (`unwrap_or`, `unwrap_or_else`, `collect`) is applied: the
+// source's state is checked once, then the value is passed by reference from
+// stage to stage as long as no stage fails. Only the stages that can fail
+// (`and_then`, `filter`) check a state, failures jump straight to the
+// terminal stage.
+//
+// Each stage is a continuation: `run<R>(next, fail)` calls `next(value)` with
+// an r-value reference to the value it produces, or `fail(error)` with the
+// error (`None` for `Option` pipelines). Both return the terminal's `R`.
+
+namespace internal {
+namespace lazy {
+
+template <typename T>
+struct OptionSource {
+  using value_type = T;
+  using error_type = NoneType;
+
+  template <typename R, typename Next, typename Fail>
+  R run(Next&& next, Fail&& fail) && {
+    if (source.is_some()) {
+      return std::forward<Next>(next)(option::unsafe_value_move(source));
+    } else {
+      return std::forward<Fail>(fail)(None);
+    }
+  }
+
+  Option<T>& source;
+};
+
+template <typename T, typename E>
+struct ResultSource {
+  using value_type = T;
+  using error_type = E;
+
+  template <typename R, typename Next, typename Fail>
+  R run(Next&& next, Fail&& fail) && {
+    if (source.is_ok()) {
+      return std::forward<Next>(next)(result::unsafe_value_move(source));
+    } else {
+      return std::forward<Fail>(fail)(result::unsafe_err_move(source));
+    }
+  }
+
+  Result<T, E>& source;
+};
+
+// the state checks of the `Option` or `Result` returned by an `and_then`
+// stage
+template <typename T>
+bool is_present(Option<T> const& option) {
+  return option.is_some();
+}
+
+template <typename T, typename E>
+bool is_present(Result<T, E> const& result) {
+  return result.is_ok();
+}
+
+template <typename T>
+T&& take_value(Option<T>& option) {
+  return option::unsafe_value_move(option);
+}
+
+template <typename T, typename E>
+T&& take_value(Result<T, E>& result) {
+  return result::unsafe_value_move(result);
+}
+
+template <typename T>
+NoneType take_error(Option<T>&) {
+  return None;
+}
+
+template <typename T, typename E>
+E&& take_error(Result<T, E>& result) {
+  return result::unsafe_err_move(result);
+}
+
+template <typename T>
+struct fallible_traits {
+  static constexpr bool valid = false;
+};
+
+template <typename T>
+struct fallible_traits<Option<T>> {
+  static constexpr bool valid = true;
+  using value_type = T;
+  using error_type = NoneType;
+};
+
+template <typename T, typename E>
+struct fallible_traits<Result<T, E>> {
+  static constexpr bool valid = !std::is_void_v<T>;
+  using value_type = T;
+  using error_type = E;
+};
+
+template <typename Fn>
+struct Map {
+  template <typename T, typename E>
+  using value_type = invoke_result<Fn&&, T&&>;
+
+  template <typename T, typename E>
+  using error_type = E;
+
+  template <typename R, typename Prev, typename Next, typename Fail>
+  R run(Prev&& prev, Next&& next, Fail&& fail) && {
+    using T = typename Prev::value_type;
+    static_assert(invocable<Fn&&, T&&>);
+    return std::move(prev).template run<R>(
+        [&](T&& value) -> R {
+          return std::forward<Next>(next)(
+              std::forward<Fn>(fn)(std::forward<T>(value)));
+        },
+        std::forward<Fail>(fail));
+  }
+
+  Fn fn;
+};
+
+template <typename Fn>
+struct AndThen {
+  template <typename T, typename E>
+  using value_type =
+      typename fallible_traits<invoke_result<Fn&&, T&&>>::value_type;
+
+  template <typename T, typename E>
+  using error_type = E;
+
+  template <typename R, typename Prev, typename Next, typename Fail>
+  R run(Prev&& prev, Next&& next, Fail&& fail) && {
+    using T = typename Prev::value_type;
+    static_assert(invocable<Fn&&, T&&>);
+    using Output = invoke_result<Fn&&, T&&>;
+    static_assert(fallible_traits<Output>::valid,
+                  "'and_then' must return an 'Option' or a non-void 'Result'");
+    static_assert(std::is_same_v<typename fallible_traits<Output>::error_type,
+                                 typename Prev::error_type>,
+                  "'and_then' must return the error type of the pipeline");
+    return std::move(prev).template run<R>(
+        [&](T&& value) -> R {
+          Output output = std::forward<Fn>(fn)(std::forward<T>(value));
+          if (is_present(output)) {
+            return std::forward<Next>(next)(take_value(output));
+          } else {
+            return fail(take_error(output));
+          }
+        },
+        fail);
+  }
+
+  Fn fn;
+};
+
+template <typename Predicate>
+struct Filter {
+  template <typename T, typename E>
+  using value_type = T;
+
+  template <typename T, typename E>
+  using error_type = E;
+
+  template <typename R, typename Prev, typename Next, typename Fail>
+  R run(Prev&& prev, Next&& next, Fail&& fail) && {
+    using T = typename Prev::value_type;
+    static_assert(std::is_same_v<typename Prev::error_type, NoneType>,
+                  "'filter' is only supported by 'Option' pipelines");
+    static_assert(invocable<Predicate&&, T const&>);
+    return std::move(prev).template run<R>(
+        [&](T&& value) -> R {
+          if (std::forward<Predicate>(predicate)(std::as_const(value))) {
+            return std::forward<Next>(next)(std::forward<T>(value));
+          } else {
+            return fail(None);
+          }
+        },
+        fail);
+  }
+
+  Predicate predicate;
+};
+
+template <typename Fn>
+struct MapErr {
+  template <typename T, typename E>
+  using value_type = T;
+
+  template <typename T, typename E>
+  using error_type = invoke_result<Fn&&, E&&>;
+
+  template <typename R, typename Prev, typename Next, typename Fail>
+  R run(Prev&& prev, Next&& next, Fail&& fail) && {
+    using E = typename Prev::error_type;
+    static_assert(!std::is_same_v<E, NoneType>,
+                  "'map_err' is only supported by 'Result' pipelines");
+    static_assert(invocable<Fn&&, E&&>);
+    return std::move(prev).template run<R>(
+        std::forward<Next>(next), [&](E&& error) -> R {
+          return std::forward<Fail>(fail)(
+              std::forward<Fn>(fn)(std::forward<E>(error)));
+        });
+  }
+
+  Fn fn;
+};
+
+// a source followed by a stage
+template <typename Prev, typename Stage>
+struct Pipe {
+  using value_type = typename Stage::template value_type<
+      typename Prev::value_type, typename Prev::error_type>;
+
+  using error_type = typename Stage::template error_type<
+      typename Prev::value_type, typename Prev::error_type>;
+
+  template <typename R, typename Next, typename Fail>
+  R run(Next&& next, Fail&& fail) && {
+    return std::move(stage).template run<R>(
+        std::move(prev), std::forward<Next>(next), std::forward<Fail>(fail));
+  }
+
+  Prev prev;
+  Stage stage;
+};
+
+template <typename A>
+struct UnwrapOr {
+  template <typename P>
+  std::decay_t<typename P::value_type> evaluate(P&& pipe) && {
+    using T = typename P::value_type;
+    using V = std::decay_t<T>;
+    return std::move(pipe).template run<V>(
+        [](T&& value) -> V { return std::forward<T>(value); },
+        [&](auto&&) -> V { return std::forward<A>(alt); });
+  }
+
+  A&& alt;
+};
+
+template <typename Fn>
+struct UnwrapOrElse {
+  template <typename P>
+  std::decay_t<typename P::value_type> evaluate(P&& pipe) && {
+    using T = typename P::value_type;
+    using V = std::decay_t<T>;
+    static_assert(invocable<Fn&&>);
+    return std::move(pipe).template run<V>(
+        [](T&& value) -> V { return std::forward<T>(value); },
+        [&](auto&&) -> V { return std::forward<Fn>(fn)(); });
+  }
+
+  Fn fn;
+};
+
+struct Collect {
+  template <typename P>
+  auto evaluate(P&& pipe) && {
+    using T = typename P::value_type;
+    using V = std::decay_t<T>;
+    using E = typename P::error_type;
+    if constexpr (std::is_same_v<E, NoneType>) {
+      return std::move(pipe).template run<Option<V>>(
+          [](T&& value) -> Option<V> {
+            return Some<V>(std::forward<T>(value));
+          },
+          [](NoneType) -> Option<V> { return None; });
+    } else {
+      return std::move(pipe).template run<Result<V, E>>(
+          [](T&& value) -> Result<V, E> {
+            return Ok<V>(std::forward<T>(value));
+          },
+          [](E&& error) -> Result<V, E> {
+            return Err<E>(std::forward<E>(error));
+          });
+    }
+  }
+};
+
+template <typename T>
+constexpr bool is_pipe = false;
+
+template <typename T>
+constexpr bool is_pipe<OptionSource<T>> = true;
+
+template <typename T, typename E>
+constexpr bool is_pipe<ResultSource<T, E>> = true;
+
+template <typename Prev, typename Stage>
+constexpr bool is_pipe<Pipe<Prev, Stage>> = true;
+
+template <typename T>
+constexpr bool is_stage = false;
+
+template <typename Fn>
+constexpr bool is_stage<Map<Fn>> = true;
+
+template <typename Fn>
+constexpr bool is_stage<AndThen<Fn>> = true;
+
+template <typename Predicate>
+constexpr bool is_stage<Filter<Predicate>> = true;
+
+template <typename Fn>
+constexpr bool is_stage<MapErr<Fn>> = true;
+
+template <typename T>
+constexpr bool is_terminal = std::is_same_v<T, Collect>;
+
+template <typename A>
+constexpr bool is_terminal<UnwrapOr<A>> = true;
+
+template <typename Fn>
+constexpr bool is_terminal<UnwrapOrElse<Fn>> = true;
+
+template <typename P, typename S,
+          std::enable_if_t<is_pipe<P> && is_stage<S>, int> = 0>
+Pipe<P, S> operator|(P&& pipe, S&& stage) {
+  return Pipe<P, S>{std::move(pipe), std::move(stage)};
+}
+
+template <typename P, typename S,
+          std::enable_if_t<is_pipe<P> && is_terminal<S>, int> = 0>
+decltype(auto) operator|(P&& pipe, S&& terminal) {
+  return std::move(terminal).evaluate(std::move(pipe));
+}
+
+}  // namespace lazy
+}  // namespace internal
+
+/// Starts a lazy pipeline over `option`, the stages are applied with `|`
+/// (see `stx::lazy`) and the pipeline is evaluated by its terminal stage.
+///
+/// The pipeline refers to `option` and consumes it once evaluated: it must
+/// be evaluated within the expression that creates it.
+///
+/// # Examples
+///
+/// Basic usage:
+///
+/// ``` cpp
+/// Option name = Some("  stx  "s);
+/// auto trim = [](string s) { /* ... */ return s; };
+/// auto non_empty = [](string const& s) { return !s.empty(); };
+///
+/// string x = pipe(move(name)) | lazy::map(trim) | lazy::filter(non_empty) |
+///            lazy::unwrap_or("anonymous"s);
+/// ASSERT_EQ(x, "stx");
+/// ```
+template <typename T>
+[[nodiscard]] internal::lazy::OptionSource<T> pipe(Option<T>&& option) {
+  return internal::lazy::OptionSource<T>{option};
+}
+
+/// Starts a lazy pipeline over `result`, see `pipe(Option<T>&&)`.
+///
+/// # Examples
+///
+/// Basic usage:
+///
+/// ``` cpp
+/// auto parse = [](string s) -> Result<int, string> { /* ... */ };
+///
+/// Result<string, string> input = Ok("42"s);
+/// int x = pipe(move(input)) | lazy::and_then(parse) |
+///         lazy::map([](int v) { return v * 2; }) | lazy::unwrap_or(0);
+/// ASSERT_EQ(x, 84);
+/// ```
+template <typename T, typename E,
+          std::enable_if_t<!std::is_void_v<T>, int> = 0>
+[[nodiscard]] internal::lazy::ResultSource<T, E> pipe(Result<T, E>&& result) {
+  return internal::lazy::ResultSource<T, E>{result};
+}
+
+/// Stages of lazy `Option` and `Result` pipelines, see `pipe`.
+namespace lazy {
+
+/// Applies `op` to the value, see `Option::map` and `Result::map`.
+template <typename Fn>
+[[nodiscard]] internal::lazy::Map<Fn> map(Fn&& op) {
+  return internal::lazy::Map<Fn>{std::forward<Fn>(op)};
+}
+
+/// Applies `op` to the value and continues with the value of the `Option`
+/// or `Result` it returns, see `Option::and_then` and `Result::and_then`.
+/// The `Result`'s error type must be the pipeline's error type.
+template <typename Fn>
+[[nodiscard]] internal::lazy::AndThen<Fn> and_then(Fn&& op) {
+  return internal::lazy::AndThen<Fn>{std::forward<Fn>(op)};
+}
+
+/// Discards the value if `predicate` returns `false`, see `Option::filter`.
+/// Only supported by `Option` pipelines.
+template <typename UnaryPredicate>
+[[nodiscard]] internal::lazy::Filter<UnaryPredicate> filter(
+    UnaryPredicate&& predicate) {
+  return internal::lazy::Filter<UnaryPredicate>{
+      std::forward<UnaryPredicate>(predicate)};
+}
+
+/// Applies `op` to the error, see `Result::map_err`. Only supported by
+/// `Result` pipelines.
+template <typename Fn>
+[[nodiscard]] internal::lazy::MapErr<Fn> map_err(Fn&& op) {
+  return internal::lazy::MapErr<Fn>{std::forward<Fn>(op)};
+}
+
+/// Evaluates the pipeline, returns its value or `alt`. `alt` is only moved
+/// from if the pipeline fails.
+template <typename A>
+[[nodiscard]] internal::lazy::UnwrapOr<A> unwrap_or(A&& alt) {
+  return internal::lazy::UnwrapOr<A>{std::forward<A>(alt)};
+}
+
+/// Evaluates the pipeline, returns its value or the value returned by `op`.
+template <typename Fn>
+[[nodiscard]] internal::lazy::UnwrapOrElse<Fn> unwrap_or_else(Fn&& op) {
+  return internal::lazy::UnwrapOrElse<Fn>{std::forward<Fn>(op)};
+}
+
+/// Evaluates the pipeline into an `Option` or a `Result`.
+[[nodiscard]] inline internal::lazy::Collect collect() { return {}; }
+
+}  // namespace lazy
+
+STX_END_NAMESPACE
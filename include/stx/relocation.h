@@ -0,0 +1,164 @@
+/**
+ * @file relocation.h
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-12
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "stx/config.h"
+
+STX_BEGIN_NAMESPACE
+
+//! Customization point marking a type as trivially relocatable: moving a `T`
+//! to a new address and destroying the source is equivalent to copying its
+//! bytes and forgetting the source.
+//!
+//! This holds for trivially copyable types, and also for most types that own
+//! a resource through a pointer (i.e. `std::unique_ptr` or `std::vector`),
+//! whose move constructor copies the pointer and nulls the source's for the
+//! destructor to do nothing. It doesn't hold for types storing pointers into
+//! themselves, i.e. libstdc++'s `std::string` which points to its own
+//! small-string buffer, or `std::vector` when the standard library's debug
+//! containers are enabled.
+//!
+//! `uninitialized_relocate` then moves a range of `T`s with a single
+//! `std::memcpy` instead of a move construction and destruction per element.
+//! `Option<T>` and `Result<T, E>` are trivially relocatable if their payloads
+//! are.
+//!
+//! # Examples
+//!
+//! ``` cpp
+//! // owns a handle through a pointer, doesn't point to itself
+//! struct Texture {
+//!   Texture(Texture&& other) noexcept
+//!       : handle_{std::exchange(other.handle_, nullptr)} {}
+//!   ~Texture() noexcept { if (handle_ != nullptr) release(handle_); }
+//!
+//!  private:
+//!   GpuHandle* handle_;
+//! };
+//!
+//! template <>
+//! struct stx::is_trivially_relocatable<Texture> : std::true_type {};
+//!
+//! static_assert(stx::trivially_relocatable<Option<Texture>>);
+//! ```
+//!
+template <typename T>
+struct is_trivially_relocatable
+    : std::bool_constant<std::is_trivially_move_constructible_v<T> &&
+                         std::is_trivially_destructible_v<T>> {};
+
+template <typename T>
+constexpr bool trivially_relocatable = is_trivially_relocatable<T>::value;
+
+/// the deleter is held by value and must be relocatable too
+template <typename T, typename D>
+struct is_trivially_relocatable<std::unique_ptr<T, D>>
+    : is_trivially_relocatable<D> {};
+
+template <typename T>
+struct is_trivially_relocatable<std::shared_ptr<T>> : std::true_type {};
+
+template <typename T>
+struct is_trivially_relocatable<std::weak_ptr<T>> : std::true_type {};
+
+/// stateless, but its copy constructor is user-provided on some
+/// implementations
+template <typename T>
+struct is_trivially_relocatable<std::allocator<T>> : std::true_type {};
+
+/// 1 if the standard library's debug containers are enabled: MSVC's iterator
+/// debugging (the default in debug builds), libstdc++'s `_GLIBCXX_DEBUG` or
+/// libc++'s debug mode.
+#if (defined(_ITERATOR_DEBUG_LEVEL) && _ITERATOR_DEBUG_LEVEL != 0) || \
+    defined(_GLIBCXX_DEBUG) || defined(_LIBCPP_DEBUG) ||             \
+    defined(_LIBCPP_ENABLE_DEBUG_MODE)
+#define STX_STD_DEBUG_CONTAINERS 1
+#else
+#define STX_STD_DEBUG_CONTAINERS 0
+#endif
+
+#if !STX_STD_DEBUG_CONTAINERS
+/// the allocator is held by value and must be relocatable too.
+///
+/// not specialized when the standard library's debug containers are enabled
+/// (`STX_STD_DEBUG_CONTAINERS`): their iterator bookkeeping points back at
+/// the vector, and would be left dangling by a bytewise copy.
+template <typename T, typename Allocator>
+struct is_trivially_relocatable<std::vector<T, Allocator>>
+    : is_trivially_relocatable<Allocator> {};
+#endif
+
+/// Moves the objects in `[first, last)` into the uninitialized storage
+/// starting at `dest` and ends the source objects' lifetimes. The ranges must
+/// not overlap and `T`'s move constructor must not throw. Returns the end of
+/// the destination range.
+///
+/// Trivially relocatable objects are moved with a single `std::memcpy`, other
+/// objects are move-constructed and destroyed one by one.
+///
+/// # Examples
+///
+/// Basic usage:
+///
+/// ``` cpp
+/// // grows a buffer holding `size` options
+/// auto* grown = static_cast<Option<Texture>*>(
+///     std::malloc(2 * capacity * sizeof(Option<Texture>)));
+/// uninitialized_relocate(buffer, buffer + size, grown);
+/// std::free(buffer);
+/// ```
+template <typename T>
+T* uninitialized_relocate(T* first, T* last, T* dest) noexcept {
+  if constexpr (trivially_relocatable<T>) {
+    size_t const size = static_cast<size_t>(last - first);
+    if (size != 0) {
+      std::memcpy(static_cast<void*>(dest), static_cast<void const*>(first),
+                  size * sizeof(T));
+    }
+    return dest + size;
+  } else {
+    for (; first != last; first++, dest++) {
+      new (static_cast<void*>(dest)) T(std::move(*first));
+      first->~T();
+    }
+    return dest;
+  }
+}
+
+STX_END_NAMESPACE
@@ -0,0 +1,429 @@
+/**
+ * @file result_vec.h
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-18
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "stx/config.h"
+#include "stx/internal/bitmask.h"
+#include "stx/internal/panic_helpers.h"
+#include "stx/option.h"
+#include "stx/relocation.h"
+#include "stx/result.h"
+
+STX_BEGIN_NAMESPACE
+
+//! A growable sequence of `Result<T, E>`s, stored as a structure of arrays.
+//!
+//! A `std::vector<Result<T, E>>` interleaves the values, the errors and the
+//! padded discriminants, a cache line thus only holds a few elements and
+//! checking the elements' states touches every cache line of the vector.
+//! `ResultVec` instead stores the values and the errors in two separate
+//! columns and the states in a bitmask, one bit per element:
+//!
+//! - `count_ok()`, `count_err()` and `first_err()` only scan the bitmask, 64
+//! elements per word.
+//! - `for_each_ok()` and `for_each_err()` only touch the values or errors
+//! column.
+//!
+//! Both columns have a slot for every element, only one of them is
+//! constructed.
+//!
+//! Elements are accessed as `Result<MutRef<T>, MutRef<E>>` (or
+//! `Result<ConstRef<T>, ConstRef<E>>`) pointing into the columns.
+//!
+//! # Examples
+//!
+//! ``` cpp
+//! auto parse = [](string_view row) -> Result<int, ParseError> { ... };
+//!
+//! ResultVec<int, ParseError> parsed;
+//! for (string_view row : rows) parsed.push(parse(row));
+//!
+//! if (parsed.count_err() != 0) {
+//!   size_t const index = parsed.first_err().unwrap();
+//!   log_error(index, parsed[index].unwrap_err().get());
+//! }
+//! ```
+//!
+template <typename T, typename E>
+struct ResultVec {
+  static_assert(!std::is_reference_v<T> && !std::is_reference_v<E>,
+                "'ResultVec' does not store references, use 'Ref<T>'");
+  static_assert(!std::is_void_v<T> && !std::is_void_v<E>);
+
+  using value_type = T;
+  using error_type = E;
+  using reference = Result<MutRef<T>, MutRef<E>>;
+  using const_reference = Result<ConstRef<T>, ConstRef<E>>;
+
+  template <bool Const>
+  struct Iterator {
+    using ResultVecType = std::conditional_t<Const, ResultVec const, ResultVec>;
+
+    auto operator*() const { return (*vec)[index]; }
+
+    Iterator& operator++() noexcept {
+      index++;
+      return *this;
+    }
+
+    bool operator==(Iterator const& cmp) const noexcept {
+      return index == cmp.index;
+    }
+
+    bool operator!=(Iterator const& cmp) const noexcept {
+      return index != cmp.index;
+    }
+
+    ResultVecType* vec;
+    size_t index;
+  };
+
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  ResultVec() noexcept = default;
+
+  ResultVec(ResultVec&& other) noexcept
+      : values_{std::exchange(other.values_, nullptr)},
+        errors_{std::exchange(other.errors_, nullptr)},
+        ok_{std::exchange(other.ok_, nullptr)},
+        size_{std::exchange(other.size_, 0)},
+        capacity_{std::exchange(other.capacity_, 0)} {}
+
+  ResultVec& operator=(ResultVec&& other) noexcept {
+    if (this != &other) {
+      release();
+      values_ = std::exchange(other.values_, nullptr);
+      errors_ = std::exchange(other.errors_, nullptr);
+      ok_ = std::exchange(other.ok_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+      capacity_ = std::exchange(other.capacity_, 0);
+    }
+    return *this;
+  }
+
+  ResultVec(ResultVec const&) = delete;
+  ResultVec& operator=(ResultVec const&) = delete;
+
+  ~ResultVec() noexcept { release(); }
+
+  [[nodiscard]] size_t size() const noexcept { return size_; }
+
+  [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+  [[nodiscard]] size_t capacity() const noexcept { return capacity_; }
+
+  /// makes room for at least `capacity` elements
+  void reserve(size_t capacity) {
+    if (capacity > capacity_) grow(capacity);
+  }
+
+  /// appends `result`, moving its value or error into the matching column
+  void push(Result<T, E>&& result) {
+    if (result.is_ok()) {
+      push_ok(internal::result::unsafe_value_move(result));
+    } else {
+      push_err(internal::result::unsafe_err_move(result));
+    }
+  }
+
+  /// appends an `Ok` element, constructed in-place from `args`
+  template <typename... Args>
+  void push_ok(Args&&... args) {
+    if (size_ == capacity_) {
+      // constructed before the columns are relocated, `args` can refer to an
+      // element
+      T element(std::forward<Args>(args)...);
+      grow(size_ + 1);
+      new (values_ + size_) T(std::move(element));
+    } else {
+      new (values_ + size_) T(std::forward<Args>(args)...);
+    }
+    internal::bitmask::set(ok_, size_);
+    size_++;
+  }
+
+  /// appends an `Err` element, constructed in-place from `args`
+  template <typename... Args>
+  void push_err(Args&&... args) {
+    if (size_ == capacity_) {
+      // constructed before the columns are relocated, `args` can refer to an
+      // element
+      E element(std::forward<Args>(args)...);
+      grow(size_ + 1);
+      new (errors_ + size_) E(std::move(element));
+    } else {
+      new (errors_ + size_) E(std::forward<Args>(args)...);
+    }
+    size_++;
+  }
+
+  /// destroys all the elements, the capacity is kept
+  void clear() noexcept {
+    if (size_ == 0) return;
+    destroy_elements();
+    std::memset(ok_, 0, internal::bitmask::words_for(size_) * sizeof(uint64_t));
+    size_ = 0;
+  }
+
+  [[nodiscard]] bool is_ok(size_t index) const noexcept {
+    STX_AUDIT_EXPECTS(index < size_, internal::span::index_out_of_bounds());
+    return internal::bitmask::get(ok_, index);
+  }
+
+  [[nodiscard]] bool is_err(size_t index) const noexcept {
+    return !is_ok(index);
+  }
+
+  /// accesses an element (not bounds-checked, except at the audit contract
+  /// level).
+  [[nodiscard]] reference operator[](size_t index) noexcept {
+    if (is_ok(index)) {
+      return Ok<MutRef<T>>(MutRef<T>(values_[index]));
+    } else {
+      return Err<MutRef<E>>(MutRef<E>(errors_[index]));
+    }
+  }
+
+  /// accesses an element (not bounds-checked, except at the audit contract
+  /// level).
+  [[nodiscard]] const_reference operator[](size_t index) const noexcept {
+    if (is_ok(index)) {
+      return Ok<ConstRef<T>>(ConstRef<T>(values_[index]));
+    } else {
+      return Err<ConstRef<E>>(ConstRef<E>(errors_[index]));
+    }
+  }
+
+  /// accesses an element (bounds-checked).
+  [[nodiscard]] Option<reference> at(size_t index) noexcept {
+    if (index < size_) return Some((*this)[index]);
+    return None;
+  }
+
+  /// accesses an element (bounds-checked).
+  [[nodiscard]] Option<const_reference> at(size_t index) const noexcept {
+    if (index < size_) return Some((*this)[index]);
+    return None;
+  }
+
+  iterator begin() noexcept { return iterator{this, 0}; }
+
+  iterator end() noexcept { return iterator{this, size_}; }
+
+  const_iterator begin() const noexcept { return const_iterator{this, 0}; }
+
+  const_iterator end() const noexcept { return const_iterator{this, size_}; }
+
+  /// number of `Ok` elements, only the bitmask is read.
+  [[nodiscard]] size_t count_ok() const noexcept {
+    return internal::bitmask::count(ok_, size_);
+  }
+
+  /// number of `Err` elements, only the bitmask is read.
+  [[nodiscard]] size_t count_err() const noexcept {
+    return size_ - count_ok();
+  }
+
+  /// index of the first `Err` element, only the bitmask is read.
+  ///
+  /// # Examples
+  ///
+  /// Basic usage:
+  ///
+  /// ``` cpp
+  /// ResultVec<int, Error> vec;
+  /// vec.push_ok(1);
+  /// vec.push_err(Error::Invalid);
+  ///
+  /// ASSERT_EQ(vec.first_err(), Some<size_t>(1));
+  /// ```
+  [[nodiscard]] Option<size_t> first_err() const noexcept {
+    size_t const index = internal::bitmask::find_first_clear(ok_, size_);
+    if (index == size_) return None;
+    return Some(size_t{index});
+  }
+
+  /// calls `fn(index, value)` for each `Ok` element, in order. Only the
+  /// bitmask and the values column are read.
+  template <typename Fn>
+  void for_each_ok(Fn&& fn) {
+    static_assert(invocable<Fn&, size_t, T&>);
+    internal::bitmask::for_each_set(
+        ok_, size_, [&](size_t index) { fn(index, values_[index]); });
+  }
+
+  /// calls `fn(index, value)` for each `Ok` element, in order.
+  template <typename Fn>
+  void for_each_ok(Fn&& fn) const {
+    static_assert(invocable<Fn&, size_t, T const&>);
+    internal::bitmask::for_each_set(ok_, size_, [&](size_t index) {
+      fn(index, std::as_const(values_[index]));
+    });
+  }
+
+  /// calls `fn(index, error)` for each `Err` element, in order. Only the
+  /// bitmask and the errors column are read.
+  template <typename Fn>
+  void for_each_err(Fn&& fn) {
+    static_assert(invocable<Fn&, size_t, E&>);
+    internal::bitmask::for_each_clear(
+        ok_, size_, [&](size_t index) { fn(index, errors_[index]); });
+  }
+
+  /// calls `fn(index, error)` for each `Err` element, in order.
+  template <typename Fn>
+  void for_each_err(Fn&& fn) const {
+    static_assert(invocable<Fn&, size_t, E const&>);
+    internal::bitmask::for_each_clear(ok_, size_, [&](size_t index) {
+      fn(index, std::as_const(errors_[index]));
+    });
+  }
+
+ private:
+  T* values_ = nullptr;
+  E* errors_ = nullptr;
+  uint64_t* ok_ = nullptr;
+  size_t size_ = 0;
+  size_t capacity_ = 0;
+
+  static constexpr size_t kAlignment =
+      std::max({alignof(T), alignof(E), alignof(uint64_t)});
+
+  static constexpr size_t align_up(size_t offset, size_t alignment) noexcept {
+    return (offset + alignment - 1) / alignment * alignment;
+  }
+
+  // the columns and the bitmask share a single allocation
+  static constexpr size_t errors_offset(size_t capacity) noexcept {
+    return align_up(capacity * sizeof(T), alignof(E));
+  }
+
+  static constexpr size_t ok_offset(size_t capacity) noexcept {
+    return align_up(errors_offset(capacity) + capacity * sizeof(E),
+                    alignof(uint64_t));
+  }
+
+  static constexpr size_t allocation_size(size_t capacity) noexcept {
+    return ok_offset(capacity) +
+           internal::bitmask::words_for(capacity) * sizeof(uint64_t);
+  }
+
+  // grows to at least `min_capacity` elements, relocating the columns
+  void grow(size_t min_capacity) {
+    size_t capacity =
+        capacity_ == 0 ? internal::bitmask::kWordBits : capacity_ * 2;
+    if (capacity < min_capacity) capacity = min_capacity;
+
+    auto* const memory = static_cast<unsigned char*>(::operator new(
+        allocation_size(capacity), std::align_val_t{kAlignment}));
+    T* const values = reinterpret_cast<T*>(memory);
+    E* const errors = reinterpret_cast<E*>(memory + errors_offset(capacity));
+    uint64_t* const ok =
+        reinterpret_cast<uint64_t*>(memory + ok_offset(capacity));
+
+    std::memset(ok, 0,
+                internal::bitmask::words_for(capacity) * sizeof(uint64_t));
+    if (size_ != 0) {
+      std::memcpy(ok, ok_,
+                  internal::bitmask::words_for(size_) * sizeof(uint64_t));
+      relocate(values, errors);
+    }
+
+    deallocate();
+    values_ = values;
+    errors_ = errors;
+    ok_ = ok;
+    capacity_ = capacity;
+  }
+
+  // moves the elements into the new columns and destroys the old ones
+  void relocate(T* values, E* errors) noexcept {
+    // the slots of the other alternative hold no object, their bytes are
+    // copied along and never read
+    if constexpr (trivially_relocatable<T>) {
+      std::memcpy(static_cast<void*>(values), values_, size_ * sizeof(T));
+    } else {
+      static_assert(std::is_nothrow_move_constructible_v<T>,
+                    "'ResultVec' requires a non-throwing move constructor");
+      internal::bitmask::for_each_set(ok_, size_, [&](size_t index) {
+        new (values + index) T(std::move(values_[index]));
+        values_[index].~T();
+      });
+    }
+    if constexpr (trivially_relocatable<E>) {
+      std::memcpy(static_cast<void*>(errors), errors_, size_ * sizeof(E));
+    } else {
+      static_assert(std::is_nothrow_move_constructible_v<E>,
+                    "'ResultVec' requires a non-throwing move constructor");
+      internal::bitmask::for_each_clear(ok_, size_, [&](size_t index) {
+        new (errors + index) E(std::move(errors_[index]));
+        errors_[index].~E();
+      });
+    }
+  }
+
+  void destroy_elements() noexcept {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      internal::bitmask::for_each_set(
+          ok_, size_, [&](size_t index) { values_[index].~T(); });
+    }
+    if constexpr (!std::is_trivially_destructible_v<E>) {
+      internal::bitmask::for_each_clear(
+          ok_, size_, [&](size_t index) { errors_[index].~E(); });
+    }
+  }
+
+  void deallocate() noexcept {
+    if (capacity_ == 0) return;
+    ::operator delete(static_cast<void*>(values_),
+                      std::align_val_t{kAlignment});
+  }
+
+  void release() noexcept {
+    destroy_elements();
+    deallocate();
+  }
+};
+
+/// `ResultVec` only owns its columns through pointers.
+template <typename T, typename E>
+struct is_trivially_relocatable<ResultVec<T, E>> : std::true_type {};
+
+STX_END_NAMESPACE
@@ -35,6 +35,85 @@
 
 STX_BEGIN_NAMESPACE
 
+#if defined(STX_COMPACT_SOURCE_LOCATION)
+
+namespace internal {
+
+/// 32-bit FNV-1a hash of a call site's file name and line number.
+///
+/// `scripts/resolve_call_site.py` computes the same hash to resolve a call
+/// site ID back to its file and line.
+constexpr uint32_t call_site_id(char const* file,
+                                uint_least32_t line) noexcept {
+  uint32_t hash = 2166136261U;
+
+  for (; *file != '\0'; file++) {
+    hash ^= static_cast<unsigned char>(*file);
+    hash *= 16777619U;
+  }
+
+  for (int shift = 0; shift < 32; shift += 8) {
+    hash ^= static_cast<uint32_t>(line >> shift) & 0xFFU;
+    hash *= 16777619U;
+  }
+
+  return hash;
+}
+
+}  // namespace internal
+
+///
+/// Compact `SourceLocation`, enabled by defining `STX_COMPACT_SOURCE_LOCATION`
+/// (the `STX_COMPACT_SOURCE_LOCATION` CMake option).
+///
+/// Only a 32-bit ID of the call site is stored, the file name, function name,
+/// line and column are thus not embedded into the binary. The ID is printed by
+/// the default panic handler and can be resolved to its file and line with
+/// `scripts/resolve_call_site.py`.
+///
+struct [[nodiscard]] SourceLocation {
+  static constexpr SourceLocation current(
+#if STX_HAS_BUILTIN(FILE) && STX_HAS_BUILTIN(LINE)
+      uint32_t id = internal::call_site_id(__builtin_FILE(), __builtin_LINE())
+#else
+      uint32_t id = 0
+#endif
+          ) noexcept {
+    SourceLocation loc{};
+    loc.id_ = id;
+    return loc;
+  }
+
+  constexpr SourceLocation() noexcept : id_() {}
+  constexpr SourceLocation(SourceLocation const& other) noexcept = default;
+  constexpr SourceLocation(SourceLocation && other) noexcept = default;
+  constexpr SourceLocation& operator=(SourceLocation const& other) noexcept =
+      default;
+  constexpr SourceLocation& operator=(SourceLocation&& other) noexcept =
+      default;
+  ~SourceLocation() noexcept = default;
+
+  /// return the call site ID represented by this object
+  constexpr uint32_t id() const noexcept { return id_; }
+
+  /// not available, always 0
+  constexpr uint_least32_t column() const noexcept { return 0; }
+
+  /// not available, always 0
+  constexpr uint_least32_t line() const noexcept { return 0; }
+
+  /// not available, always "unknown"
+  constexpr const char* file_name() const noexcept { return "unknown"; }
+
+  /// not available, always "unknown"
+  constexpr const char* function_name() const noexcept { return "unknown"; }
+
+ private:
+  uint32_t id_;
+};
+
+#else
+
 ///
 /// The `SourceLocation`  class represents certain information about the source
 /// code, such as file names, line numbers, and function names. Previously,
@@ -111,4 +190,68 @@ struct [[nodiscard]] SourceLocation {
   const char* func_;
 };
 
+#endif
+
+///
+/// The `SourceLocation` of the call site at which a parameter of this type is
+/// default-initialized with `{}`:
+///
+/// ``` cpp
+/// void check(bool ok, CallerLocation const& location = {});
+/// ```
+///
+/// The constructor is `consteval` from C++ 20 on, the location, or the call
+/// site ID of the compact `SourceLocation`, is thus computed at compile time
+/// even at `-O0`. An immediate function called from a nested default argument
+/// (i.e. `SourceLocation const& location = SourceLocation::current()`) is
+/// evaluated at the declaration by GCC 12, a braced default argument is
+/// evaluated at the call site.
+///
+struct [[nodiscard]] CallerLocation : SourceLocation {
+#if defined(STX_COMPACT_SOURCE_LOCATION)
+#if STX_HAS_BUILTIN(FILE) && STX_HAS_BUILTIN(LINE)
+  STX_CONSTEVAL CallerLocation(
+      const char* file = __builtin_FILE(),
+      uint_least32_t line = __builtin_LINE()) noexcept
+      : SourceLocation{
+            SourceLocation::current(internal::call_site_id(file, line))} {}
+#else
+  STX_CONSTEVAL CallerLocation() noexcept
+      : SourceLocation{SourceLocation::current(0)} {}
+#endif
+#else
+  STX_CONSTEVAL CallerLocation(
+#if STX_HAS_BUILTIN(FILE)
+      const char* file = __builtin_FILE(),
+#else
+      const char* file = "unknown",
+#endif
+
+#if STX_HAS_BUILTIN(FUNCTION)
+      const char* func = __builtin_FUNCTION(),
+#else
+      const char* func = "unknown",
+#endif
+
+#if STX_HAS_BUILTIN(LINE)
+      uint_least32_t line = __builtin_LINE(),
+#else
+      uint_least32_t line = 0,
+#endif
+
+#if STX_HAS_BUILTIN(COLUMN)
+      uint_least32_t column = __builtin_COLUMN()
+#else
+      uint_least32_t column = 0
+#endif
+          ) noexcept
+      : SourceLocation{SourceLocation::current(file, func, line, column)} {
+  }
+#endif
+
+  /// an explicitly passed location
+  constexpr CallerLocation(SourceLocation const& location) noexcept
+      : SourceLocation{location} {}
+};
+
 STX_END_NAMESPACE
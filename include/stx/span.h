@@ -33,6 +33,7 @@
 #include <type_traits>
 
 #include "stx/config.h"
+#include "stx/internal/panic_helpers.h"
 #include "stx/option.h"
 
 STX_BEGIN_NAMESPACE
@@ -354,8 +355,10 @@ struct Span {
   /// returns a constant reverse iterator to the end.
   constexpr const_reverse_iterator crend() const noexcept { return rend(); };
 
-  /// accesses an element of the sequence (not bounds-checked).
+  /// accesses an element of the sequence (not bounds-checked, except at the
+  /// audit contract level).
   constexpr reference operator[](index_type index) const noexcept {
+    STX_AUDIT_EXPECTS(index < size(), internal::span::index_out_of_bounds());
     return data()[index];
   };
 
@@ -379,15 +382,20 @@ struct Span {
     }
   }
 
-  /// obtains a subspan starting at an offset (not bounds-checked).
+  /// obtains a subspan starting at an offset (not bounds-checked, except at
+  /// the audit contract level).
   constexpr Span<element_type> subspan(index_type offset) const noexcept {
+    STX_AUDIT_EXPECTS(offset <= size(),
+                      internal::span::subspan_out_of_bounds());
     return Span<element_type>(begin() + offset, end());
   };
 
   /// obtains a subspan starting at an offset and with a length
-  /// (not bounds-checked).
+  /// (not bounds-checked, except at the audit contract level).
   constexpr Span<element_type> subspan(index_type offset,
                                        size_type length) const noexcept {
+    STX_AUDIT_EXPECTS(offset <= size() && length <= size() - offset,
+                      internal::span::subspan_out_of_bounds());
     return Span<element_type>(begin() + offset, length);
   };
 
@@ -637,8 +645,10 @@ struct Span<Element, dynamic_extent> {
   /// returns a constant reverse iterator to the end.
   constexpr const_reverse_iterator crend() const noexcept { return rend(); };
 
-  /// accesses an element of the sequence (not bounds-checked).
+  /// accesses an element of the sequence (not bounds-checked, except at the
+  /// audit contract level).
   constexpr reference operator[](index_type index) const noexcept {
+    STX_AUDIT_EXPECTS(index < size(), internal::span::index_out_of_bounds());
     return data()[index];
   };
 
@@ -662,15 +672,20 @@ struct Span<Element, dynamic_extent> {
     }
   }
 
-  /// obtains a subspan starting at an offset (not bounds-checked).
+  /// obtains a subspan starting at an offset (not bounds-checked, except at
+  /// the audit contract level).
   constexpr Span<element_type> subspan(index_type offset) const noexcept {
+    STX_AUDIT_EXPECTS(offset <= size(),
+                      internal::span::subspan_out_of_bounds());
     return Span<element_type>(begin() + offset, end());
   };
 
   /// obtains a subspan starting at an offset and with a length
-  /// (not bounds-checked).
+  /// (not bounds-checked, except at the audit contract level).
   constexpr Span<element_type> subspan(index_type offset,
                                        size_type length) const noexcept {
+    STX_AUDIT_EXPECTS(offset <= size() && length <= size() - offset,
+                      internal::span::subspan_out_of_bounds());
     return Span<element_type>(begin() + offset, length);
   };
 
@@ -0,0 +1,417 @@
+/**
+ * @file task.h
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-20
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include "stx/config.h"
+#include "stx/coroutine.h"
+#include "stx/panic.h"
+#include "stx/result.h"
+
+#if STX_HAS_COROUTINES
+
+STX_BEGIN_NAMESPACE
+
+template <typename T, typename E>
+class Task;
+
+namespace internal {
+namespace task {
+
+/// panic helper for `Task::run()` when the task suspended on an awaitable
+/// other than a child task, `Result` or the tasks it awaits
+[[noreturn]] STX_COLD STX_NOINLINE inline void not_completed() noexcept {
+  panic("called `Task::run()` on a task that suspended without completing");
+}
+
+/// panic helper for `Task::result()` when the task has not completed
+[[noreturn]] STX_COLD STX_NOINLINE inline void no_result() noexcept {
+  panic("called `Task::result()` on a task that has not completed");
+}
+
+/// panic helper for the methods of a moved-from `Task`
+[[noreturn]] STX_COLD STX_NOINLINE inline void no_task() noexcept {
+  panic("called a method on a moved-from `Task`");
+}
+
+// The state of a task shared by all of its instantiations.
+//
+// A task awaited by a parent task records it. When the task completes with an
+// `Err`, the error is moved into the parent which completes with it right
+// away, without being resumed, and the task's frame is destroyed. This is
+// repeated up the chain of parents (iteratively, so a long chain doesn't
+// exhaust the stack) and the first ancestor completing with a value, or the
+// root, is resumed.
+struct PromiseBase {
+  static void* operator new(size_t size) {
+    return coroutine::pool_allocate(size);
+  }
+
+  static void operator delete(void* frame, size_t size) noexcept {
+    coroutine::pool_deallocate(frame, size);
+  }
+
+  std::suspend_always initial_suspend() const noexcept { return {}; }
+
+  [[noreturn]] void unhandled_exception() const noexcept { std::terminate(); }
+
+  /// marks the task and the ancestors its error propagates to as completed
+  /// and returns the coroutine to resume next.
+  std::coroutine_handle<> complete() noexcept {
+    PromiseBase* promise = this;
+    promise->completed = true;
+    while (promise->failed && promise->parent != nullptr) {
+      PromiseBase* const parent = promise->parent;
+      promise->propagate(*promise, *parent);
+      parent->completed = true;
+      // the parent won't be resumed, the frame is released now rather than
+      // recursively once the parent's frame is destroyed. `this` can be
+      // destroyed here.
+      std::exchange(*promise->owner, nullptr).destroy();
+      promise = parent;
+    }
+    if (promise->continuation) return promise->continuation;
+    return std::noop_coroutine();
+  }
+
+  // the awaiting coroutine, resumed once the task completes with a value
+  std::coroutine_handle<> continuation = nullptr;
+  // the awaiting task, `nullptr` if the task is not awaited by a task
+  PromiseBase* parent = nullptr;
+  // the handle owning the task's frame in the awaiting task
+  std::coroutine_handle<>* owner = nullptr;
+  // moves the task's error into `parent`
+  void (*propagate)(PromiseBase& promise, PromiseBase& parent) noexcept =
+      nullptr;
+  bool completed = false;
+  bool failed = false;
+};
+
+struct FinalAwaiter {
+  bool await_ready() const noexcept { return false; }
+
+  template <typename Promise>
+  std::coroutine_handle<> await_suspend(
+      std::coroutine_handle<Promise> handle) const noexcept {
+    return handle.promise().complete();
+  }
+
+  void await_resume() const noexcept {}
+};
+
+template <typename T, typename E>
+struct Promise;
+
+/// awaits a child task, evaluating to its value. The awaiter owns the child's
+/// frame.
+template <typename U, typename F>
+struct TaskAwaiter {
+  explicit TaskAwaiter(std::coroutine_handle<Promise<U, F>> handle) noexcept
+      : child{handle} {}
+
+  TaskAwaiter(TaskAwaiter const&) = delete;
+  TaskAwaiter& operator=(TaskAwaiter const&) = delete;
+
+  ~TaskAwaiter() {
+    if (child) child.destroy();
+  }
+
+  Promise<U, F>& promise() const noexcept {
+    return std::coroutine_handle<Promise<U, F>>::from_address(child.address())
+        .promise();
+  }
+
+  bool await_ready() const noexcept { return false; }
+
+  template <typename P>
+  std::coroutine_handle<> await_suspend(
+      std::coroutine_handle<P> parent) noexcept {
+    Promise<U, F>& promise = this->promise();
+    promise.continuation = parent;
+    promise.parent = &parent.promise();
+    promise.owner = &child;
+    promise.propagate = [](PromiseBase& task, PromiseBase& ancestor) noexcept {
+      static_cast<P&>(ancestor).set_err(
+          result::unsafe_err_move(static_cast<Promise<U, F>&>(task).result));
+    };
+    return child;
+  }
+
+  U await_resume() noexcept(std::is_nothrow_move_constructible_v<U> ||
+                            std::is_void_v<U>) {
+    if constexpr (!std::is_void_v<U>) {
+      return result::unsafe_value_move(promise().result);
+    }
+  }
+
+  std::coroutine_handle<> child;
+};
+
+/// awaits a `Result`, completing the task with its error if it is an `Err`
+template <typename U, typename F>
+struct ResultAwaiter {
+  Result<U, F>& result;
+
+  bool await_ready() const noexcept { return result.is_ok(); }
+
+  template <typename P>
+  std::coroutine_handle<> await_suspend(
+      std::coroutine_handle<P> handle) noexcept {
+    handle.promise().set_err(result::unsafe_err_move(result));
+    return handle.promise().complete();
+  }
+
+  U await_resume() noexcept(std::is_nothrow_move_constructible_v<U> ||
+                            std::is_void_v<U>) {
+    if constexpr (!std::is_void_v<U>) {
+      return result::unsafe_value_move(result);
+    }
+  }
+};
+
+/// awaits an l-value awaiter in place. GCC copies the awaiter into the frame
+/// when `await_transform` returns an l-value reference.
+template <typename A>
+struct LvalueAwaiter {
+  A& awaiter;
+
+  bool await_ready() { return awaiter.await_ready(); }
+
+  template <typename Handle>
+  decltype(auto) await_suspend(Handle handle) {
+    return awaiter.await_suspend(handle);
+  }
+
+  decltype(auto) await_resume() { return awaiter.await_resume(); }
+};
+
+template <typename T, typename E>
+struct Promise : PromiseBase {
+  Promise() noexcept {}
+
+  ~Promise() {
+    if (has_result) result.~Result();
+  }
+
+  Task<T, E> get_return_object() noexcept {
+    return Task<T, E>{std::coroutine_handle<Promise>::from_promise(*this)};
+  }
+
+  FinalAwaiter final_suspend() const noexcept { return {}; }
+
+  void return_value(Ok<T>&& ok) { store(std::move(ok)); }
+
+  void return_value(Err<E>&& err) { store(std::move(err)); }
+
+  template <typename U,
+            std::enable_if_t<std::is_constructible_v<T, U&&>, int> = 0>
+  void return_value(U&& value) {
+    store(Ok<T>(T(std::forward<U>(value))));
+  }
+
+  template <typename F>
+  void set_err(F&& err) {
+    static_assert(std::is_constructible_v<E, F&&>,
+                  "the awaited error type 'F' can not be converted to the "
+                  "task's error type 'E'");
+    store(Err<E>(E(std::forward<F>(err))));
+  }
+
+  /// the awaited child task's `Err` completes this task with it
+  template <typename U, typename F>
+  TaskAwaiter<U, F> await_transform(Task<U, F>&& child) noexcept {
+    static_assert(std::is_constructible_v<E, F&&>,
+                  "the awaited 'Task<U, F>''s error type 'F' can not be "
+                  "converted to the task's error type 'E'");
+    return TaskAwaiter<U, F>{std::exchange(child.handle_, nullptr)};
+  }
+
+  /// an awaited `Err` completes the task with it
+  template <typename U, typename F>
+  ResultAwaiter<U, F> await_transform(Result<U, F>&& awaited) noexcept {
+    static_assert(std::is_constructible_v<E, F&&>,
+                  "the awaited 'Result<U, F>''s error type 'F' can not be "
+                  "converted to the task's error type 'E'");
+    return ResultAwaiter<U, F>{awaited};
+  }
+
+  /// any other awaitable, i.e. an I/O operation, is awaited as is
+  template <typename A>
+  auto await_transform(A&& awaitable) noexcept(
+      std::is_lvalue_reference_v<A> ||
+      std::is_nothrow_move_constructible_v<A>) {
+    if constexpr (std::is_lvalue_reference_v<A>) {
+      return LvalueAwaiter<std::remove_reference_t<A>>{awaitable};
+    } else {
+      return std::move(awaitable);
+    }
+  }
+
+  template <typename R>
+  void store(R&& value) {
+    new (&result) Result<T, E>{std::forward<R>(value)};
+    has_result = true;
+    failed = result.is_err();
+  }
+
+  union {
+    Result<T, E> result;
+  };
+  bool has_result = false;
+};
+
+}  // namespace task
+}  // namespace internal
+
+//! A lazy coroutine producing a `Result<T, E>`.
+//!
+//! The task starts when it is awaited (`co_await std::move(task)` from another
+//! task) or run (`run()`, `start()`). Awaiting a task transfers control to it
+//! directly (symmetric transfer) and the task resumes its parent the same way
+//! once it completes, a chain of tasks thus runs in constant stack space when
+//! the compiler emits the transfers as tail calls (with optimizations
+//! enabled).
+//!
+//! In a task, `co_await` on a child task or on a `Result` evaluates to its
+//! value. If it is an `Err`, the task completes with the error, which is
+//! converted to `E`, without resuming it: the error propagates up the chain of
+//! awaiting tasks without an exception, destroying their frames on the way.
+//! Any other awaitable is awaited as is.
+//!
+//! The frames are allocated from the per-thread size-class pool of
+//! `pool_coroutine_frame_allocator`, not from `::operator new`. The frame
+//! is released by the destructor of the `Task`.
+//!
+//! # Examples
+//!
+//! ``` cpp
+//! auto read_header(Socket& socket) -> Task<Header, IoError>;
+//!
+//! auto read_message(Socket& socket) -> Task<Message, IoError> {
+//!   Header header = co_await read_header(socket);
+//!   Bytes body = co_await read_body(socket, header.length);
+//!   co_return Message{header, std::move(body)};
+//! }
+//!
+//! Result<Message, IoError> message = read_message(socket).run();
+//! ```
+//!
+//! # Exceptions
+//!
+//! Exceptions must not escape the task, `std::terminate` is called otherwise.
+//!
+template <typename T, typename E>
+class [[nodiscard]] Task {
+ public:
+  using promise_type = internal::task::Promise<T, E>;
+
+  Task(Task&& other) noexcept : handle_{std::exchange(other.handle_, {})} {}
+
+  Task& operator=(Task&& other) noexcept {
+    if (this != &other) {
+      if (handle_) handle_.destroy();
+      handle_ = std::exchange(other.handle_, {});
+    }
+    return *this;
+  }
+
+  Task(Task const&) = delete;
+  Task& operator=(Task const&) = delete;
+
+  ~Task() {
+    if (handle_) handle_.destroy();
+  }
+
+  /// Returns `true` if the task has completed, with a value or an error.
+  [[nodiscard]] bool is_done() const noexcept {
+    STX_EXPECTS(handle_, internal::task::no_task());
+    return handle_.promise().completed;
+  }
+
+  /// Starts the task on the calling thread, returning once it has completed
+  /// or suspended on an awaitable other than a task or a `Result`. The task
+  /// is then resumed by that awaitable.
+  void start() noexcept {
+    STX_EXPECTS(handle_, internal::task::no_task());
+    handle_.resume();
+  }
+
+  /// Returns the result of the completed task.
+  ///
+  /// # Panics
+  ///
+  /// Panics if the task has not completed.
+  [[nodiscard]] Result<T, E> result() && {
+    STX_EXPECTS(is_done(), internal::task::no_result());
+    return std::move(handle_.promise().result);
+  }
+
+  /// Runs the task to completion on the calling thread and returns its
+  /// result.
+  ///
+  /// # Panics
+  ///
+  /// Panics if the task suspended on an awaitable other than a task or a
+  /// `Result`.
+  ///
+  /// # Examples
+  ///
+  /// Basic usage:
+  ///
+  /// ``` cpp
+  /// auto twice(int x) -> Task<int, Error> { co_return x * 2; }
+  ///
+  /// auto quadruple(int x) -> Task<int, Error> {
+  ///   co_return co_await twice(co_await twice(x));
+  /// }
+  ///
+  /// ASSERT_EQ(quadruple(2).run(), Ok(8));
+  /// ```
+  [[nodiscard]] Result<T, E> run() && {
+    start();
+    STX_EXPECTS(handle_.promise().completed, internal::task::not_completed());
+    return std::move(handle_.promise().result);
+  }
+
+ private:
+  explicit Task(std::coroutine_handle<promise_type> handle) noexcept
+      : handle_{handle} {}
+
+  std::coroutine_handle<promise_type> handle_;
+
+  friend promise_type;
+
+  template <typename U, typename F>
+  friend struct internal::task::Promise;
+};
+
+STX_END_NAMESPACE
+
+#endif
@@ -0,0 +1,328 @@
+/**
+ * @file task_graph.h
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-20
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "stx/algorithm.h"
+#include "stx/config.h"
+#include "stx/executor.h"
+#include "stx/option.h"
+#include "stx/panic.h"
+#include "stx/result.h"
+#include "stx/span.h"
+
+#if defined(STX_NO_STD_THREAD_MUTEX)
+#error "`stx/task_graph.h` requires std::thread and std::mutex"
+#endif
+
+STX_BEGIN_NAMESPACE
+
+/// The outcome of a node of a `TaskGraph`.
+enum class NodeStatus : uint8_t {
+  /// the graph hasn't been run
+  Pending,
+  /// the node returned `Ok`
+  Succeeded,
+  /// the node returned `Err`
+  Failed,
+  /// a node the node depends on failed, the node wasn't run
+  Cancelled
+};
+
+/// The number of nodes of a `TaskGraph` run with each outcome.
+struct GraphReport {
+  size_t succeeded = 0;
+  size_t failed = 0;
+  size_t cancelled = 0;
+};
+
+namespace internal {
+namespace task_graph {
+
+// A type-erased node, scheduled by `run()`.
+struct Node {
+  /// runs the node's function on its parents' values, stores the result and
+  /// returns `true` if it is `Ok`
+  bool (*run)(Node& node) noexcept;
+  /// frees the node
+  void (*destroy)(Node& node) noexcept;
+  std::string_view name;
+  uint32_t num_parents = 0;
+  // parents that haven't finished
+  std::atomic<uint32_t> pending_parents{0};
+  // set by a parent that failed or was cancelled
+  std::atomic<bool> cancelled{false};
+  NodeStatus status = NodeStatus::Pending;
+};
+
+struct Edge {
+  uint32_t parent;
+  uint32_t child;
+};
+
+struct NodeDeleter {
+  void operator()(Node* node) const noexcept { node->destroy(*node); }
+};
+
+template <typename T, typename E>
+struct ValueNode : Node {
+  Option<Result<T, E>> result = None;
+};
+
+template <typename T, typename E, typename F, typename... Parents>
+struct NodeImpl : ValueNode<T, E> {
+  NodeImpl(F&& node_fn, ValueNode<Parents, E> const*... node_parents)
+      : fn{std::move(node_fn)}, parents{node_parents...} {
+    this->run = [](Node& node) noexcept {
+      auto& self = static_cast<NodeImpl&>(node);
+      self.result = Some(std::apply(
+          [&self](ValueNode<Parents, E> const*... parent) {
+            return std::move(self.fn)(parent->result.value().value()...);
+          },
+          self.parents));
+      return self.result.value().is_ok();
+    };
+    this->destroy = [](Node& node) noexcept {
+      delete &static_cast<NodeImpl&>(node);
+    };
+  }
+
+  F fn;
+  std::tuple<ValueNode<Parents, E> const*...> parents;
+};
+
+/// runs the graph of `nodes` on `executor` and blocks until every node has
+/// succeeded, failed or been cancelled
+STX_EXPORT GraphReport run(Executor& executor, Span<Node* const> nodes,
+                           Span<Edge const> edges) noexcept;
+
+/// panic helper for a node that doesn't belong to the graph
+[[noreturn]] STX_COLD STX_NOINLINE inline void foreign_node() noexcept {
+  panic("the node doesn't belong to this `TaskGraph`");
+}
+
+/// panic helper for a graph that has already been run
+[[noreturn]] STX_COLD STX_NOINLINE inline void already_run() noexcept {
+  panic("the `TaskGraph` has already been run");
+}
+
+/// panic helper for the access to the value of a node that didn't succeed
+[[noreturn]] STX_COLD STX_NOINLINE inline void no_value() noexcept {
+  panic("called `TaskGraph::value()` on a node that didn't succeed");
+}
+
+/// panic helper for the access to the error of a node that didn't fail
+[[noreturn]] STX_COLD STX_NOINLINE inline void no_err() noexcept {
+  panic("called `TaskGraph::err()` on a node that didn't fail");
+}
+
+}  // namespace task_graph
+}  // namespace internal
+
+template <typename E>
+class TaskGraph;
+
+/// A handle to a node of a `TaskGraph<E>` whose value is of type `T`.
+template <typename T, typename E>
+class GraphNode {
+ private:
+  GraphNode(uint32_t index, internal::task_graph::ValueNode<T, E>* node)
+      : index_{index}, node_{node} {}
+
+  uint32_t index_;
+  internal::task_graph::ValueNode<T, E>* node_;
+
+  friend class TaskGraph<E>;
+};
+
+//! A directed acyclic graph of fallible tasks sharing the error type `E`.
+//!
+//! Each node returns a `Result<T, E>` and is called with the values of the
+//! nodes it depends on (its parents) once all of them have succeeded. A node
+//! that fails cancels all of its descendants: they are never scheduled and
+//! their status is `NodeStatus::Cancelled`. Branches that don't depend on
+//! the failed node keep running.
+//!
+//! `run()` dispatches the ready nodes to an `Executor`. Each node has an
+//! atomic counter of its unfinished parents, the thread that finishes the
+//! last parent makes the node ready: it keeps one ready child to run next
+//! and submits the others. Nodes the executor's queues can't take are run on
+//! the thread that made them ready.
+//!
+//! A graph is run once, the values of its nodes live as long as the graph.
+//!
+//! # Examples
+//!
+//! ``` cpp
+//! TaskGraph<Error> graph;
+//! auto request = graph.add("parse", [&] { return parse(input); });
+//! auto user = graph.add("auth", [](Request const& r) { return auth(r); },
+//!                       request);
+//! auto page = graph.add("render",
+//!                       [](Request const& r, User const& u) {
+//!                         return render(r, u);
+//!                       },
+//!                       request, user);
+//!
+//! graph.run(executor);
+//! if (graph.status(page) == NodeStatus::Succeeded) send(graph.value(page));
+//! ```
+//!
+template <typename E>
+class TaskGraph {
+ public:
+  TaskGraph() = default;
+
+  TaskGraph(TaskGraph const&) = delete;
+  TaskGraph& operator=(TaskGraph const&) = delete;
+  TaskGraph(TaskGraph&&) noexcept = default;
+  TaskGraph& operator=(TaskGraph&&) noexcept = default;
+
+  ~TaskGraph() = default;
+
+  /// Adds a node that calls `fn` with the values of `parents` and returns a
+  /// `Result<T, E>`.
+  ///
+  /// `name` identifies the node in the executor's panic reports and must
+  /// outlive the graph.
+  ///
+  /// # Panics
+  ///
+  /// Panics if the graph has been run or if a parent belongs to another
+  /// graph.
+  template <typename F, typename... Parents>
+  auto add(std::string_view name, F&& fn, GraphNode<Parents, E>... parents)
+      -> GraphNode<typename internal::algorithm::result_types<
+                       std::invoke_result_t<std::decay_t<F>&&,
+                                            Parents const&...>>::value_type,
+                   E> {
+    using R =
+        std::invoke_result_t<std::decay_t<F>&&, Parents const&...>;
+    using T = typename internal::algorithm::result_types<R>::value_type;
+    static_assert(
+        std::is_same_v<typename internal::algorithm::result_types<
+                           R>::error_type,
+                       E>,
+        "the node must return a `Result` of the graph's error type");
+    static_assert(!std::is_void_v<T>,
+                  "the node must return a `Result` with a value");
+
+    STX_EXPECTS(!ran_, internal::task_graph::already_run());
+    (check_owned(parents.index_, parents.node_), ...);
+
+    using Impl =
+        internal::task_graph::NodeImpl<T, E, std::decay_t<F>, Parents...>;
+    auto const index = static_cast<uint32_t>(nodes_.size());
+    auto* node =
+        new Impl{std::decay_t<F>{std::forward<F>(fn)}, parents.node_...};
+    node->name = name;
+    node->num_parents = sizeof...(Parents);
+    nodes_.emplace_back(node);
+    (edges_.push_back(internal::task_graph::Edge{parents.index_, index}),
+     ...);
+    return GraphNode<T, E>{index, node};
+  }
+
+  [[nodiscard]] size_t size() const noexcept { return nodes_.size(); }
+
+  /// Runs the graph on `executor` and blocks until every node has succeeded,
+  /// failed or been cancelled. It must not be called from a task of the
+  /// executor.
+  ///
+  /// # Panics
+  ///
+  /// Panics if the graph has already been run.
+  GraphReport run(Executor& executor) {
+    STX_EXPECTS(!ran_, internal::task_graph::already_run());
+    ran_ = true;
+    std::vector<internal::task_graph::Node*> nodes;
+    nodes.reserve(nodes_.size());
+    for (auto& node : nodes_) nodes.push_back(node.get());
+    return internal::task_graph::run(
+        executor, Span<internal::task_graph::Node* const>(nodes),
+        Span<internal::task_graph::Edge const>(edges_));
+  }
+
+  template <typename T>
+  [[nodiscard]] NodeStatus status(GraphNode<T, E> node) const noexcept {
+    check_owned(node.index_, node.node_);
+    return node.node_->status;
+  }
+
+  /// Returns the value of a node that succeeded.
+  ///
+  /// # Panics
+  ///
+  /// Panics if the node's status isn't `NodeStatus::Succeeded`.
+  template <typename T>
+  [[nodiscard]] T const& value(GraphNode<T, E> node) const noexcept {
+    check_owned(node.index_, node.node_);
+    STX_EXPECTS(node.node_->status == NodeStatus::Succeeded,
+                internal::task_graph::no_value());
+    return node.node_->result.value().value();
+  }
+
+  /// Returns the error of a node that failed.
+  ///
+  /// # Panics
+  ///
+  /// Panics if the node's status isn't `NodeStatus::Failed`.
+  template <typename T>
+  [[nodiscard]] E const& err(GraphNode<T, E> node) const noexcept {
+    check_owned(node.index_, node.node_);
+    STX_EXPECTS(node.node_->status == NodeStatus::Failed,
+                internal::task_graph::no_err());
+    return node.node_->result.value().err_value();
+  }
+
+ private:
+  void check_owned(uint32_t index,
+                   internal::task_graph::Node const* node) const noexcept {
+    STX_EXPECTS(index < nodes_.size() && nodes_[index].get() == node,
+                internal::task_graph::foreign_node());
+  }
+
+  std::vector<std::unique_ptr<internal::task_graph::Node,
+                              internal::task_graph::NodeDeleter>>
+      nodes_;
+  std::vector<internal::task_graph::Edge> edges_;
+  bool ran_ = false;
+};
+
+STX_END_NAMESPACE
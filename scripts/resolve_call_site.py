@@ -0,0 +1,74 @@
+"""Resolves call site IDs printed by the default panic handler when STX is
+built with `STX_COMPACT_SOURCE_LOCATION`.
+
+A call site ID is the 32-bit FNV-1a hash of the file name (as seen by the
+compiler, i.e. `__FILE__`) and the line number of the call site. This script
+recomputes the hash for every line of the source files found under the given
+directories and prints the matching locations.
+
+usage: python3 resolve_call_site.py <call-site-id>... --dirs <dir>...
+
+    python3 scripts/resolve_call_site.py 0x1b2c3d4e --dirs src include
+
+File names are tried relative to the current directory, relative to the
+searched directory and as absolute paths, run it from the directory the
+compiler was invoked from if the build used other relative paths.
+"""
+
+import argparse
+import os
+import sys
+
+SOURCE_EXTENSIONS = (".h", ".hh", ".hpp", ".hxx", ".c", ".cc", ".cpp", ".cxx")
+
+
+def call_site_id(file_name, line):
+    hash = 2166136261
+    for byte in file_name.encode():
+        hash = ((hash ^ byte) * 16777619) & 0xFFFFFFFF
+    for shift in range(0, 32, 8):
+        hash = ((hash ^ ((line >> shift) & 0xFF)) * 16777619) & 0xFFFFFFFF
+    return hash
+
+
+def source_files(dirs):
+    for dir in dirs:
+        for root, _, files in os.walk(dir):
+            for file in files:
+                if file.endswith(SOURCE_EXTENSIONS):
+                    path = os.path.join(root, file)
+                    yield path, {path, os.path.normpath(path),
+                                 os.path.abspath(path),
+                                 os.path.relpath(path, dir)}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("ids", nargs="+", help="call site IDs, i.e. 0x1b2c3d4e")
+    parser.add_argument("--dirs", nargs="+", default=["."],
+                        help="directories to search for source files")
+    args = parser.parse_args()
+
+    ids = {int(id, 0) for id in args.ids}
+    found = set()
+
+    for path, names in source_files(args.dirs):
+        with open(path, "rb") as file:
+            num_lines = file.read().count(b"\n") + 1
+        for name in names:
+            for line in range(1, num_lines + 1):
+                id = call_site_id(name, line)
+                if id in ids:
+                    found.add(id)
+                    lines = open(path, errors="replace").read().split("\n")
+                    print(f"0x{id:08x}: {name}:{line}: "
+                          f"{lines[line - 1].strip()}")
+
+    for id in sorted(ids - found):
+        print(f"0x{id:08x}: not found", file=sys.stderr)
+
+    return 0 if found == ids else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
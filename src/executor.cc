@@ -0,0 +1,370 @@
+/**
+ * @file executor.cc
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-20
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "stx/executor.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "stx/internal/futex.h"
+#include "stx/panic/hook.h"
+
+STX_BEGIN_NAMESPACE
+
+namespace internal {
+namespace executor {
+
+void Job::complete() noexcept {
+  uint32_t const previous = state.fetch_or(kDone, std::memory_order_acq_rel);
+  if ((previous & kWaiting) != 0) futex::wake_all(state);
+  release();
+}
+
+void Job::wait() noexcept {
+  uint32_t word = state.load(std::memory_order_acquire);
+  while ((word & kDone) == 0) {
+    if ((word & kWaiting) == 0 &&
+        !state.compare_exchange_weak(word, word | kWaiting,
+                                     std::memory_order_acquire)) {
+      continue;
+    }
+    futex::wait(state, word | kWaiting);
+    word = state.load(std::memory_order_acquire);
+  }
+}
+
+constexpr size_t kCacheLineSize = 64;
+
+size_t round_up_pow2(size_t size) noexcept {
+  size_t capacity = 1;
+  while (capacity < size) capacity <<= 1;
+  return capacity;
+}
+
+// A bounded Chase-Lev work-stealing deque (Lê, Pop, Cohen and Zappa Nardelli,
+// "Correct and Efficient Work-Stealing for Weak Memory Models"). The owner
+// pushes and pops at the bottom, thieves steal from the top.
+class Deque {
+ public:
+  explicit Deque(size_t capacity)
+      : mask_{static_cast<int64_t>(round_up_pow2(capacity)) - 1},
+        buffer_{new std::atomic<Job*>[static_cast<size_t>(mask_ + 1)]} {}
+
+  // owner only, returns `false` if the deque is full
+  bool push(Job* job) noexcept {
+    int64_t const bottom = bottom_.load(std::memory_order_relaxed);
+    int64_t const top = top_.load(std::memory_order_acquire);
+    if (bottom - top > mask_) return false;
+    buffer_[static_cast<size_t>(bottom & mask_)].store(
+        job, std::memory_order_relaxed);
+    // publishes the job to the thieves
+    bottom_.store(bottom + 1, std::memory_order_release);
+    return true;
+  }
+
+  // owner only
+  Job* pop() noexcept {
+    int64_t const bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = top_.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+
+    Job* job = buffer_[static_cast<size_t>(bottom & mask_)].load(
+        std::memory_order_relaxed);
+    if (top == bottom) {
+      // last element, race against the thieves
+      if (!top_.compare_exchange_strong(top, top + 1,
+                                        std::memory_order_seq_cst,
+                                        std::memory_order_relaxed)) {
+        job = nullptr;
+      }
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return job;
+  }
+
+  // any thread, returns `nullptr` if the deque is empty or the steal lost a
+  // race
+  Job* steal() noexcept {
+    int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t const bottom = bottom_.load(std::memory_order_acquire);
+    if (top >= bottom) return nullptr;
+
+    Job* job =
+        buffer_[static_cast<size_t>(top & mask_)].load(std::memory_order_relaxed);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    return job;
+  }
+
+ private:
+  alignas(kCacheLineSize) std::atomic<int64_t> top_{0};
+  alignas(kCacheLineSize) std::atomic<int64_t> bottom_{0};
+  int64_t mask_;
+  std::unique_ptr<std::atomic<Job*>[]> buffer_;
+};
+
+// the bounded queue of the tasks submitted by the other threads
+class Injector {
+ public:
+  explicit Injector(size_t capacity) : jobs_(round_up_pow2(capacity)) {}
+
+  bool push(Job* job) noexcept {
+    std::lock_guard<std::mutex> lock{mutex_};
+    if (tail_ - head_ == jobs_.size()) return false;
+    jobs_[tail_ & (jobs_.size() - 1)] = job;
+    tail_++;
+    size_.store(tail_ - head_, std::memory_order_release);
+    return true;
+  }
+
+  Job* pop() noexcept {
+    if (size_.load(std::memory_order_acquire) == 0) return nullptr;
+    std::lock_guard<std::mutex> lock{mutex_};
+    if (head_ == tail_) return nullptr;
+    Job* job = jobs_[head_ & (jobs_.size() - 1)];
+    head_++;
+    size_.store(tail_ - head_, std::memory_order_release);
+    return job;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<Job*> jobs_;
+  size_t head_ = 0;
+  size_t tail_ = 0;
+  std::atomic<size_t> size_{0};
+};
+
+struct Worker;
+
+}  // namespace executor
+}  // namespace internal
+
+namespace {
+
+using internal::executor::Worker;
+
+/// the worker the calling thread is, and the task it is running
+thread_local Worker* current_worker = nullptr;
+thread_local internal::executor::Job* current_job = nullptr;
+
+}  // namespace
+
+struct Executor::State {
+  explicit State(size_t queue_capacity) : injector{queue_capacity} {}
+
+  std::vector<std::unique_ptr<Worker>> workers;
+  internal::executor::Injector injector;
+
+  // submitted tasks that have not run yet
+  std::atomic<uint32_t> pending{0};
+  // bumped to wake the parked workers
+  std::atomic<uint32_t> epoch{0};
+  std::atomic<uint32_t> sleepers{0};
+  std::atomic<bool> stopping{false};
+
+  void notify() noexcept {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers.load(std::memory_order_seq_cst) != 0) {
+      epoch.fetch_add(1, std::memory_order_release);
+      internal::futex::wake_one(epoch);
+    }
+  }
+
+  internal::executor::Job* find(Worker& worker) noexcept;
+  void run(Worker& worker, internal::executor::Job& job) noexcept;
+  void work(Worker& worker) noexcept;
+};
+
+namespace internal {
+namespace executor {
+
+struct Worker {
+  Worker(void const* owner, size_t worker_id, size_t queue_capacity)
+      : executor{owner}, id{worker_id}, deque{queue_capacity} {}
+
+  // the state of the executor the worker belongs to
+  void const* executor;
+  size_t id;
+  Deque deque;
+  std::thread thread;
+};
+
+}  // namespace executor
+}  // namespace internal
+
+namespace {
+
+/// reports the panicking task of the worker before the panic hook is called
+void report_panic(void* context) noexcept {
+  auto& worker = *static_cast<Worker*>(context);
+  std::string_view const name =
+      current_job != nullptr ? current_job->name : std::string_view{};
+  std::fprintf(stderr, "worker %zu panicked while running task '%.*s'\n",
+               worker.id, static_cast<int>(name.size()), name.data());
+  std::fflush(stderr);
+}
+
+}  // namespace
+
+internal::executor::Job* Executor::State::find(Worker& worker) noexcept {
+  if (auto* job = worker.deque.pop()) return job;
+  if (auto* job = injector.pop()) return job;
+
+  size_t const num_workers = workers.size();
+  for (size_t i = 1; i < num_workers; i++) {
+    Worker& victim = *workers[(worker.id + i) % num_workers];
+    if (auto* job = victim.deque.steal()) return job;
+  }
+  return nullptr;
+}
+
+void Executor::State::run(Worker& worker,
+                          internal::executor::Job& job) noexcept {
+  PanicGuard guard;
+  guard.on_panic = report_panic;
+  guard.context = &worker;
+
+  current_job = &job;
+  this_thread::push_panic_guard(guard);
+  job.run(job);
+  this_thread::pop_panic_guard(guard);
+  current_job = nullptr;
+
+  job.complete();
+  if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    internal::futex::wake_all(pending);
+  }
+}
+
+void Executor::State::work(Worker& worker) noexcept {
+  current_worker = &worker;
+  while (true) {
+    if (auto* job = find(worker)) {
+      run(worker, *job);
+      continue;
+    }
+
+    uint32_t const observed = epoch.load(std::memory_order_acquire);
+    sleepers.fetch_add(1, std::memory_order_seq_cst);
+    if (auto* job = find(worker)) {
+      sleepers.fetch_sub(1, std::memory_order_relaxed);
+      run(worker, *job);
+      continue;
+    }
+    if (stopping.load(std::memory_order_acquire) &&
+        pending.load(std::memory_order_acquire) == 0) {
+      sleepers.fetch_sub(1, std::memory_order_relaxed);
+      break;
+    }
+    internal::futex::wait(epoch, observed);
+    sleepers.fetch_sub(1, std::memory_order_relaxed);
+  }
+  current_worker = nullptr;
+}
+
+Executor::Executor(size_t num_workers, size_t queue_capacity)
+    : num_workers_{std::max<size_t>(num_workers, 1)},
+      state_{std::make_unique<State>(queue_capacity)} {
+  state_->workers.reserve(num_workers_);
+  for (size_t i = 0; i < num_workers_; i++) {
+    state_->workers.push_back(
+        std::make_unique<Worker>(state_.get(), i, queue_capacity));
+  }
+  for (auto& worker : state_->workers) {
+    worker->thread =
+        std::thread{[state = state_.get(), &worker = *worker] {
+          state->work(worker);
+        }};
+  }
+}
+
+Executor::~Executor() {
+  wait_idle();
+  state_->stopping.store(true, std::memory_order_release);
+  state_->epoch.fetch_add(1, std::memory_order_release);
+  internal::futex::wake_all(state_->epoch);
+  for (auto& worker : state_->workers) worker->thread.join();
+}
+
+Option<SubmitError> Executor::push(internal::executor::Job* job) noexcept {
+  if (this_thread::is_panicking()) return Some(SubmitError::Panicking);
+
+  // counted before it is visible to the workers, which decrement it
+  state_->pending.fetch_add(1, std::memory_order_relaxed);
+
+  bool pushed = false;
+  if (current_worker != nullptr && current_worker->executor == state_.get()) {
+    pushed = current_worker->deque.push(job);
+  } else {
+    pushed = state_->injector.push(job);
+  }
+
+  if (!pushed) {
+    if (state_->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      internal::futex::wake_all(state_->pending);
+    }
+    return Some(SubmitError::QueueFull);
+  }
+
+  state_->notify();
+  return None;
+}
+
+void Executor::wait_idle() noexcept {
+  uint32_t pending = state_->pending.load(std::memory_order_acquire);
+  while (pending != 0) {
+    internal::futex::wait(state_->pending, pending);
+    pending = state_->pending.load(std::memory_order_acquire);
+  }
+}
+
+Option<size_t> this_worker::id() noexcept {
+  if (current_worker == nullptr) return None;
+  return Some(size_t{current_worker->id});
+}
+
+Option<std::string_view> this_worker::task_name() noexcept {
+  if (current_job == nullptr) return None;
+  return Some(std::string_view{current_job->name});
+}
+
+STX_END_NAMESPACE
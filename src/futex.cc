@@ -0,0 +1,91 @@
+/**
+ * @file futex.cc
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-20
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#include "stx/internal/futex.h"
+
+#if STX_OS_LINUX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <thread>
+#endif
+
+STX_BEGIN_NAMESPACE
+
+namespace internal {
+namespace futex {
+
+#if STX_OS_LINUX
+
+void wait(std::atomic<uint32_t>& word, uint32_t expected) noexcept {
+  static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t));
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE,
+          expected, nullptr, nullptr, 0);
+}
+
+void wake_one(std::atomic<uint32_t>& word) noexcept {
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE, 1,
+          nullptr, nullptr, 0);
+}
+
+void wake_all(std::atomic<uint32_t>& word) noexcept {
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE,
+          INT32_MAX, nullptr, nullptr, 0);
+}
+
+#elif defined(__cpp_lib_atomic_wait)
+
+void wait(std::atomic<uint32_t>& word, uint32_t expected) noexcept {
+  word.wait(expected, std::memory_order_relaxed);
+}
+
+void wake_one(std::atomic<uint32_t>& word) noexcept { word.notify_one(); }
+
+void wake_all(std::atomic<uint32_t>& word) noexcept { word.notify_all(); }
+
+#else
+
+void wait(std::atomic<uint32_t>& word, uint32_t expected) noexcept {
+  if (word.load(std::memory_order_relaxed) == expected) {
+    std::this_thread::yield();
+  }
+}
+
+void wake_one(std::atomic<uint32_t>&) noexcept {}
+
+void wake_all(std::atomic<uint32_t>&) noexcept {}
+
+#endif
+
+}  // namespace futex
+}  // namespace internal
+
+STX_END_NAMESPACE
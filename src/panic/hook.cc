@@ -31,6 +31,8 @@
 
 #include <cstdlib>
 
+#include "stx/panic.h"
+
 STX_BEGIN_NAMESPACE
 
 namespace this_thread {
@@ -42,6 +44,14 @@ STX_LOCAL size_t step_panic_count(size_t step) noexcept {
   panic_count += step;
   return panic_count;
 }
+
+/// the most recently pushed panic guard of this thread
+thread_local PanicGuard* panic_guards = nullptr;
+
+/// panic helper for `pop_panic_guard()` on a guard that isn't the last one
+[[noreturn]] STX_COLD STX_NOINLINE void guard_not_on_top() noexcept {
+  panic("called `pop_panic_guard()` on a guard that isn't the last one pushed");
+}
 }  // namespace
 }  // namespace this_thread
 
@@ -56,6 +66,18 @@ STX_EXPORT bool this_thread::is_panicking() noexcept {
   return this_thread::step_panic_count(0) != 0;
 }
 
+STX_EXPORT void this_thread::push_panic_guard(PanicGuard& guard) noexcept {
+  guard.previous = this_thread::panic_guards;
+  this_thread::panic_guards = &guard;
+}
+
+STX_EXPORT void this_thread::pop_panic_guard(PanicGuard& guard) noexcept {
+  STX_EXPECTS(this_thread::panic_guards == &guard,
+              this_thread::guard_not_on_top());
+  this_thread::panic_guards = guard.previous;
+  guard.previous = nullptr;
+}
+
 // the panic hook takes higher precedence over the panic handler
 STX_LOCAL void default_panic_hook(std::string_view const& info,
                                   ReportPayload const& payload,
@@ -112,6 +134,13 @@ void begin_panic(std::string_view const& info,
     std::abort();
   }
 
+  // the guards are popped before being run, a guard panicking is thus
+  // detected as a recursive panic
+  while (PanicGuard* guard = this_thread::panic_guards) {
+    this_thread::panic_guards = guard->previous;
+    guard->on_panic(guard->context);
+  }
+
   // all threads use the same panic hook
   PanicHook hook = panic_hook_ref().load(std::memory_order_seq_cst);
 
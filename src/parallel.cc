@@ -0,0 +1,178 @@
+/**
+ * @file parallel.cc
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-20
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#include "stx/parallel.h"
+
+#include <condition_variable>
+#include <thread>
+#include <vector>
+
+STX_BEGIN_NAMESPACE
+
+namespace par {
+namespace {
+
+/// set while the current thread executes a job, `run()` calls made from a
+/// job are executed on the calling thread instead of waiting on the pool
+/// it is part of.
+thread_local bool executing_job = false;
+
+constexpr uint64_t kIndexMask = 0xFFFF'FFFFU;
+
+[[noreturn]] STX_COLD STX_NOINLINE void too_many_jobs() noexcept {
+  panic("`ThreadPool::run()` supports at most 2^32 - 1 jobs per batch");
+}
+
+}  // namespace
+
+struct ThreadPool::State {
+  std::mutex mutex;
+  // signalled when a batch is submitted or the pool is stopped
+  std::condition_variable submitted;
+  // signalled when the last active worker leaves a batch
+  std::condition_variable idle;
+
+  // the current batch, guarded by `mutex`
+  uint64_t generation = 0;
+  Job job = nullptr;
+  void* context = nullptr;
+  size_t num_jobs = 0;
+  // number of workers executing the current batch, guarded by `mutex`
+  size_t active = 0;
+  bool stopped = false;
+
+  // the low 32 bits of the batch's generation in the upper half and the index
+  // of the next job to claim in the lower half. a worker that wakes after its
+  // batch's `run()` returned can't claim the jobs of the next batch.
+  std::atomic<uint64_t> next_job{0};
+
+  // serializes the batches of concurrent `run()` calls
+  std::mutex run_mutex;
+  std::vector<std::thread> workers;
+
+  /// claims and executes the jobs of the batch until none are left
+  void execute(uint64_t batch_generation, Job batch_job, void* batch_context,
+               size_t batch_num_jobs) noexcept {
+    uint64_t const tag = (batch_generation & kIndexMask) << 32;
+    executing_job = true;
+    uint64_t claim = next_job.load(std::memory_order_relaxed);
+    while ((claim & ~kIndexMask) == tag &&
+           (claim & kIndexMask) < batch_num_jobs) {
+      if (next_job.compare_exchange_weak(claim, claim + 1,
+                                         std::memory_order_relaxed)) {
+        batch_job(batch_context, static_cast<size_t>(claim & kIndexMask));
+        claim = next_job.load(std::memory_order_relaxed);
+      }
+    }
+    executing_job = false;
+  }
+
+  void work() noexcept {
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock{mutex};
+    while (true) {
+      submitted.wait(lock, [&] { return stopped || generation != seen; });
+      if (stopped) return;
+
+      seen = generation;
+      Job const batch_job = job;
+      void* const batch_context = context;
+      size_t const batch_num_jobs = num_jobs;
+      active++;
+      lock.unlock();
+
+      execute(seen, batch_job, batch_context, batch_num_jobs);
+
+      lock.lock();
+      active--;
+      if (active == 0) idle.notify_all();
+    }
+  }
+};
+
+ThreadPool::ThreadPool(size_t num_threads)
+    : num_threads_{std::max<size_t>(num_threads, 1)},
+      state_{std::make_unique<State>()} {
+  state_->workers.reserve(num_threads_ - 1);
+  for (size_t i = 1; i < num_threads_; i++) {
+    state_->workers.emplace_back([state = state_.get()] { state->work(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock{state_->mutex};
+    state_->stopped = true;
+  }
+  state_->submitted.notify_all();
+  for (std::thread& worker : state_->workers) worker.join();
+}
+
+void ThreadPool::run(size_t num_jobs, Job job, void* context) noexcept {
+  if (num_jobs == 0) return;
+
+  STX_CHECK(num_jobs <= kIndexMask, too_many_jobs());
+
+  if (num_jobs == 1 || state_->workers.empty() || executing_job) {
+    for (size_t i = 0; i < num_jobs; i++) job(context, i);
+    return;
+  }
+
+  std::lock_guard<std::mutex> run_lock{state_->run_mutex};
+
+  uint64_t generation = 0;
+  {
+    std::lock_guard<std::mutex> lock{state_->mutex};
+    state_->job = job;
+    state_->context = context;
+    state_->num_jobs = num_jobs;
+    generation = ++state_->generation;
+    state_->next_job.store((generation & kIndexMask) << 32,
+                           std::memory_order_relaxed);
+  }
+  state_->submitted.notify_all();
+
+  state_->execute(generation, job, context, num_jobs);
+
+  // all of the jobs have been claimed, wait for the workers still executing
+  // them. workers joining the batch late find no job left, or a counter
+  // tagged with a later generation.
+  std::unique_lock<std::mutex> lock{state_->mutex};
+  state_->idle.wait(lock, [&] { return state_->active == 0; });
+}
+
+ThreadPool& default_thread_pool() noexcept {
+  static ThreadPool pool{std::thread::hardware_concurrency()};
+  return pool;
+}
+
+}  // namespace par
+
+STX_END_NAMESPACE
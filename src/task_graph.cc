@@ -0,0 +1,190 @@
+/**
+ * @file task_graph.cc
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-20
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#include "stx/task_graph.h"
+
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+STX_BEGIN_NAMESPACE
+
+namespace internal {
+namespace task_graph {
+
+namespace {
+
+constexpr uint32_t kNone = std::numeric_limits<uint32_t>::max();
+
+// The state of a graph's run, shared by the threads running its nodes.
+struct Run {
+  Run(Executor& run_executor, Span<Node* const> run_nodes)
+      : executor{run_executor}, nodes{run_nodes} {}
+
+  Executor& executor;
+  Span<Node* const> nodes;
+
+  // the children of node `i` are `children[offsets[i]..offsets[i + 1]]`
+  std::vector<uint32_t> offsets;
+  std::vector<uint32_t> children;
+
+  // nodes that haven't finished
+  std::atomic<size_t> remaining{0};
+  std::atomic<size_t> failed{0};
+  std::atomic<size_t> cancelled{0};
+
+  // the waiting thread returns, and destroys the run, only after the last
+  // node's thread has released the mutex
+  std::mutex mutex;
+  std::condition_variable finished;
+  bool done = false;
+
+  bool submit(uint32_t index) noexcept {
+    return executor
+        .submit(nodes[index]->name, [this, index] { execute(index); })
+        .is_ok();
+  }
+
+  void finish_one() noexcept {
+    if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      std::lock_guard lock{mutex};
+      done = true;
+      finished.notify_all();
+    }
+  }
+
+  // Counts down the children of a finished node. The children it makes ready
+  // are either kept in `next`, submitted, or pushed to `local` if they are
+  // cancelled or the executor is full.
+  void release(uint32_t index, bool succeeded, uint32_t& next,
+               std::vector<uint32_t>& local) noexcept {
+    for (uint32_t i = offsets[index]; i < offsets[index + 1]; i++) {
+      uint32_t const child_index = children[i];
+      Node& child = *nodes[child_index];
+      if (!succeeded) child.cancelled.store(true, std::memory_order_relaxed);
+      // the last parent's decrement acquires the other parents'
+      // cancellations
+      if (child.pending_parents.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        continue;
+      }
+      if (child.cancelled.load(std::memory_order_relaxed)) {
+        local.push_back(child_index);
+      } else if (next == kNone) {
+        next = child_index;
+      } else if (!submit(child_index)) {
+        local.push_back(child_index);
+      }
+    }
+  }
+
+  // Runs the node and the nodes it makes ready that aren't submitted, a chain
+  // is run in a loop rather than by recursion.
+  void execute(uint32_t index) noexcept {
+    // ready nodes that are cancelled or that the executor couldn't take, it
+    // doesn't allocate unless there are any
+    std::vector<uint32_t> local;
+    uint32_t next = index;
+
+    while (true) {
+      if (next == kNone) {
+        if (local.empty()) break;
+        next = local.back();
+        local.pop_back();
+      }
+
+      uint32_t const current = std::exchange(next, kNone);
+      Node& node = *nodes[current];
+      bool succeeded = false;
+      if (node.cancelled.load(std::memory_order_relaxed)) {
+        node.status = NodeStatus::Cancelled;
+        cancelled.fetch_add(1, std::memory_order_relaxed);
+      } else {
+        succeeded = node.run(node);
+        node.status = succeeded ? NodeStatus::Succeeded : NodeStatus::Failed;
+        if (!succeeded) failed.fetch_add(1, std::memory_order_relaxed);
+      }
+      release(current, succeeded, next, local);
+      finish_one();
+    }
+  }
+};
+
+}  // namespace
+
+GraphReport run(Executor& executor, Span<Node* const> nodes,
+                Span<Edge const> edges) noexcept {
+  size_t const num_nodes = nodes.size();
+  if (num_nodes == 0) return GraphReport{};
+
+  Run run{executor, nodes};
+
+  // compressed adjacency lists of the children
+  run.offsets.assign(num_nodes + 1, 0);
+  for (Edge const& edge : edges) run.offsets[edge.parent + 1]++;
+  for (size_t i = 0; i < num_nodes; i++) {
+    run.offsets[i + 1] += run.offsets[i];
+  }
+  run.children.resize(edges.size());
+  {
+    std::vector<uint32_t> cursor{run.offsets.begin(), run.offsets.end() - 1};
+    for (Edge const& edge : edges) {
+      run.children[cursor[edge.parent]++] = edge.child;
+    }
+  }
+
+  std::vector<uint32_t> roots;
+  for (size_t i = 0; i < num_nodes; i++) {
+    nodes[i]->pending_parents.store(nodes[i]->num_parents,
+                                    std::memory_order_relaxed);
+    if (nodes[i]->num_parents == 0) roots.push_back(static_cast<uint32_t>(i));
+  }
+  run.remaining.store(num_nodes, std::memory_order_relaxed);
+
+  for (uint32_t root : roots) {
+    if (!run.submit(root)) run.execute(root);
+  }
+
+  {
+    std::unique_lock lock{run.mutex};
+    run.finished.wait(lock, [&run] { return run.done; });
+  }
+
+  GraphReport report;
+  report.failed = run.failed.load(std::memory_order_relaxed);
+  report.cancelled = run.cancelled.load(std::memory_order_relaxed);
+  report.succeeded = num_nodes - report.failed - report.cancelled;
+  return report;
+}
+
+}  // namespace task_graph
+}  // namespace internal
+
+STX_END_NAMESPACE
@@ -0,0 +1,126 @@
+/**
+ * @file algorithm_test.cc
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-20
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#include "stx/algorithm.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace stx;
+
+namespace {
+
+enum class Error { Invalid, Overflow };
+
+}  // namespace
+
+TEST(AlgorithmTest, TryCollect) {
+  vector<Result<int, Error>> rows;
+  for (int i = 0; i < 5; i++) rows.push_back(Ok(int{i}));
+  vector<int> values(rows.size());
+
+  auto collected =
+      try_collect(Span<Result<int, Error>>(rows), Span<int>(values));
+  EXPECT_TRUE(collected.is_ok());
+  EXPECT_EQ(collected.value().size(), 5);
+  EXPECT_EQ(values, (vector{0, 1, 2, 3, 4}));
+
+  rows[2] = Err(Error::Overflow);
+  rows[4] = Err(Error::Invalid);
+  vector<int> partial(rows.size(), -1);
+  EXPECT_EQ(
+      try_collect(Span<Result<int, Error> const>(rows), Span<int>(partial)),
+      Err(Error::Overflow));
+  EXPECT_EQ(partial, (vector{0, 1, -1, -1, -1}));
+
+  EXPECT_TRUE(try_collect(Span<Result<int, Error>>(), Span<int>()).is_ok());
+
+  vector<int> small(2);
+  EXPECT_DEATH_IF_SUPPORTED(
+      (void)try_collect(Span<Result<int, Error>>(rows), Span<int>(small)),
+      ".*");
+}
+
+TEST(AlgorithmTest, TryCollectMoves) {
+  vector<Result<unique_ptr<int>, string>> rows;
+  rows.push_back(Ok(make_unique<int>(1)));
+  rows.push_back(Ok(make_unique<int>(2)));
+  vector<unique_ptr<int>> values(rows.size());
+
+  auto collected = try_collect(Span<Result<unique_ptr<int>, string>>(rows),
+                               Span<unique_ptr<int>>(values));
+  EXPECT_TRUE(collected.is_ok());
+  EXPECT_EQ(*values[1], 2);
+  EXPECT_EQ(rows[1].value(), nullptr);
+}
+
+TEST(AlgorithmTest, PartitionResults) {
+  vector<Result<string, Error>> rows;
+  rows.push_back(Ok("a"s));
+  rows.push_back(Err(Error::Invalid));
+  rows.push_back(Ok("b"s));
+  rows.push_back(Err(Error::Overflow));
+  rows.push_back(Ok("c"s));
+  vector<string> values(rows.size());
+  vector<Error> errors(rows.size());
+
+  auto [ok, err] =
+      partition_results(Span<Result<string, Error> const>(rows),
+                        Span<string>(values), Span<Error>(errors));
+  ASSERT_EQ(ok.size(), 3);
+  ASSERT_EQ(err.size(), 2);
+  EXPECT_EQ(ok[0], "a");
+  EXPECT_EQ(ok[2], "c");
+  EXPECT_EQ(err[0], Error::Invalid);
+  EXPECT_EQ(err[1], Error::Overflow);
+  // copied out of the `const` input
+  EXPECT_EQ(rows[0].value(), "a");
+}
+
+TEST(AlgorithmTest, Flatten) {
+  vector<Option<int>> samples;
+  for (int i = 0; i < 10; i++) {
+    if (i % 3 == 0) {
+      samples.push_back(Some(int{i}));
+    } else {
+      samples.push_back(None);
+    }
+  }
+  vector<int> values(samples.size());
+
+  Span<int> present = flatten(Span<Option<int>>(samples), Span<int>(values));
+  ASSERT_EQ(present.size(), 4);
+  EXPECT_EQ(present[0], 0);
+  EXPECT_EQ(present[3], 9);
+}
@@ -0,0 +1,185 @@
+/**
+ * @file coroutine_test.cc
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-04-16
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "stx/coroutine.h"
+
+#if STX_HAS_COROUTINES
+
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace string_literals;
+using namespace stx;
+
+namespace {
+
+enum class Error { Negative, Odd };
+
+auto parse(int x) -> Result<string, Error> {
+  if (x < 0) return Err(Error::Negative);
+  return Ok(to_string(x));
+}
+
+auto parse_twice(int a, int b) -> Result<string, Error> {
+  co_return co_await parse(a) + co_await parse(b);
+}
+
+auto check_even(int x) -> Result<void, Error> {
+  if (x % 2 != 0) co_return Err(Error::Odd);
+  co_return Ok();
+}
+
+auto parse_even(int x) -> Result<size_t, Error> {
+  co_await check_even(x);
+  auto str = co_await parse(x);
+  co_return str.size();
+}
+
+auto parse_negative(int x) -> Result<int, Error> {
+  if (x >= 0) co_return Err(Error::Negative);
+  co_return x;
+}
+
+auto half(int x) -> Option<int> {
+  if (x % 2 != 0) return None;
+  return Some(x / 2);
+}
+
+auto quarter(int x) -> Option<int> { co_return co_await half(co_await half(x)); }
+
+auto quarter_or_none(int x) -> Option<int> {
+  int y = co_await half(x);
+  if (y == 0) co_return None;
+  co_return Some(move(y));
+}
+
+auto owned(int x) -> Result<unique_ptr<int>, Error> {
+  if (x < 0) co_return Err(Error::Negative);
+  co_return make_unique<int>(x);
+}
+
+auto deref_owned(int x) -> Result<int, Error> {
+  auto ptr = co_await owned(x);
+  co_return *ptr;
+}
+
+// the error is converted to the coroutine's error type
+auto widen(int x) -> Result<int, long> {
+  co_return co_await (x < 0 ? make_err<int, int>(move(x))
+                            : make_ok<int, int>(move(x)));
+}
+
+auto deep(int depth) -> Result<int, Error> {
+  if (depth == 0) co_return co_await parse_negative(-1);
+  co_return co_await deep(depth - 1) - 1;
+}
+
+int allocations = 0;
+int deallocations = 0;
+
+void* counting_allocate(size_t size) {
+  allocations++;
+  return ::operator new(size);
+}
+
+void counting_deallocate(void* frame, size_t size) noexcept {
+  deallocations++;
+  ::operator delete(frame, size);
+}
+
+}  // namespace
+
+TEST(CoroutineTest, Result) {
+  EXPECT_EQ(parse_twice(1, 2), Ok("12"s));
+  EXPECT_EQ(parse_twice(-1, 2), Err(Error::Negative));
+  EXPECT_EQ(parse_twice(1, -2), Err(Error::Negative));
+
+  EXPECT_EQ(parse_negative(-5), Ok(-5));
+  EXPECT_EQ(parse_negative(5), Err(Error::Negative));
+
+  EXPECT_EQ(deref_owned(8), Ok(8));
+  EXPECT_EQ(deref_owned(-8), Err(Error::Negative));
+
+  EXPECT_EQ(widen(3), Ok(3));
+  EXPECT_EQ(widen(-3), Err(-3L));
+}
+
+TEST(CoroutineTest, VoidResult) {
+  EXPECT_EQ(check_even(2), Ok());
+  EXPECT_EQ(check_even(3), Err(Error::Odd));
+
+  EXPECT_EQ(parse_even(1024), Ok(4UL));
+  EXPECT_EQ(parse_even(1023), Err(Error::Odd));
+  EXPECT_EQ(parse_even(-2), Err(Error::Negative));
+}
+
+TEST(CoroutineTest, Option) {
+  EXPECT_EQ(quarter(8), Some(2));
+  EXPECT_EQ(quarter(6), None);
+  EXPECT_EQ(quarter(7), None);
+
+  EXPECT_EQ(quarter_or_none(4), Some(2));
+  EXPECT_EQ(quarter_or_none(0), None);
+  EXPECT_EQ(quarter_or_none(3), None);
+}
+
+TEST(CoroutineTest, Deep) {
+  // exhausts the default arena and falls back to the heap
+  EXPECT_EQ(deep(4), Ok(-5));
+  EXPECT_EQ(deep(4096), Ok(-4097));
+}
+
+TEST(CoroutineTest, FrameAllocator) {
+  auto previous = set_coroutine_frame_allocator(
+      CoroutineFrameAllocator{counting_allocate, counting_deallocate});
+
+  EXPECT_EQ(parse_twice(1, 2), Ok("12"s));
+  EXPECT_EQ(parse_twice(-1, 2), Err(Error::Negative));
+  EXPECT_EQ(quarter(6), None);
+
+  auto restored = set_coroutine_frame_allocator(previous);
+  EXPECT_EQ(restored.allocate, counting_allocate);
+
+  // frames are released to the allocator they were allocated with
+  EXPECT_EQ(allocations, deallocations);
+
+  thread other{[] {
+    // every thread starts with the default allocator
+    auto current = set_coroutine_frame_allocator(heap_coroutine_frame_allocator);
+    EXPECT_EQ(current.allocate, arena_coroutine_frame_allocator.allocate);
+    EXPECT_EQ(deep(64), Ok(-65));
+  }};
+  other.join();
+}
+
+#endif
@@ -0,0 +1,170 @@
+/**
+ * @file dyn_error_test.cc
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-11
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#include "stx/dyn_error.h"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace string_literals;
+using namespace stx;
+
+namespace {
+
+enum class DiskError { Full, ReadOnly };
+
+SpanReport operator>>(ReportQuery, DiskError const& error) noexcept {
+  switch (error) {
+    case DiskError::Full:
+      return SpanReport("disk is full");
+    case DiskError::ReadOnly:
+      return SpanReport("disk is read-only");
+    default:
+      return SpanReport();
+  }
+}
+
+struct SyntaxError {
+  SyntaxError(int line, int column) noexcept : line{line}, column{column} {}
+
+  int line;
+  int column;
+};
+
+FixedReport operator>>(ReportQuery, SyntaxError const& error) noexcept {
+  char buffer[64];
+  int size = snprintf(buffer, sizeof(buffer), "syntax error at %d:%d",
+                      error.line, error.column);
+  return FixedReport(buffer, static_cast<size_t>(size));
+}
+
+// counts the live instances, to check that the held error is destroyed
+struct Tracked {
+  static inline int live = 0;
+
+  explicit Tracked(int value) noexcept : value{value} { live++; }
+  Tracked(Tracked&& other) noexcept : value{other.value} { live++; }
+  Tracked& operator=(Tracked&&) = delete;
+  ~Tracked() noexcept { live--; }
+
+  int value;
+};
+
+struct Oversized {
+  char bytes[kDynErrorInlineSize + 1];
+};
+
+auto write(int size) -> Result<int, DiskError> {
+  if (size < 0) return Err(DiskError::ReadOnly);
+  return Ok(move(size));
+}
+
+auto compile(int line) -> Result<int, SyntaxError> {
+  if (line == 0) return Err(SyntaxError{7, 21});
+  return Ok(line * 2);
+}
+
+auto build(int line) -> Result<int, DynError> {
+  TRY_OK(object, compile(line));
+  TRY_OK(written, write(object));
+  return Ok(move(written));
+}
+
+}  // namespace
+
+TEST(DynErrorTest, Compatibility) {
+  EXPECT_TRUE(is_dyn_error_compatible<DiskError>);
+  EXPECT_TRUE(is_dyn_error_compatible<SyntaxError>);
+  EXPECT_TRUE(is_dyn_error_compatible<Tracked>);
+  EXPECT_TRUE(is_dyn_error_compatible<string>);
+  EXPECT_FALSE(is_dyn_error_compatible<Oversized>);
+  EXPECT_FALSE(is_dyn_error_compatible<DynError>);
+  EXPECT_FALSE((is_convertible_v<Oversized, DynError>));
+  EXPECT_EQ(sizeof(DynError), kDynErrorInlineSize + sizeof(void*));
+}
+
+TEST(DynErrorTest, Observers) {
+  DynError disk = DiskError::Full;
+  EXPECT_TRUE(disk.is<DiskError>());
+  EXPECT_FALSE(disk.is<SyntaxError>());
+  EXPECT_EQ(disk.downcast<DiskError>(), Some(DiskError::Full));
+  EXPECT_EQ(disk.downcast<SyntaxError>().is_none(), true);
+  EXPECT_EQ(disk.report().what(), "disk is full");
+
+  DynError syntax{in_place_type<SyntaxError>, 3, 4};
+  EXPECT_EQ(syntax.report().what(), "syntax error at 3:4");
+  EXPECT_EQ((report_query >> syntax).what(), "syntax error at 3:4");
+  EXPECT_EQ(move(syntax).take<SyntaxError>().unwrap().column, 4);
+
+  DynError text = "connection reset"s;
+  EXPECT_EQ(text.report().what(), "connection reset");
+  EXPECT_EQ(move(text).take<DiskError>(), None);
+}
+
+TEST(DynErrorTest, Propagation) {
+  EXPECT_EQ(build(4).unwrap(), 8);
+  EXPECT_EQ(build(0).unwrap_err().report().what(), "syntax error at 7:21");
+  DynError error = build(-1).unwrap_err();
+  EXPECT_EQ(error.downcast<DiskError>(), Some(DiskError::ReadOnly));
+
+  EXPECT_DEATH_IF_SUPPORTED(build(0).unwrap(), ".*");
+}
+
+TEST(DynErrorTest, Lifetime) {
+  {
+    DynError a{in_place_type<Tracked>, 5};
+    EXPECT_EQ(Tracked::live, 1);
+
+    DynError b = move(a);
+    EXPECT_EQ(Tracked::live, 2);
+    EXPECT_EQ(b.downcast<Tracked>().unwrap().get().value, 5);
+
+    b = DynError{DiskError::Full};
+    EXPECT_EQ(Tracked::live, 1);
+
+    a = move(b);
+    EXPECT_EQ(Tracked::live, 0);
+    EXPECT_TRUE(a.is<DiskError>());
+  }
+  EXPECT_EQ(Tracked::live, 0);
+
+  {
+    auto string_error = make_unique<DynError>("a long error message, that "s
+                                              "doesn't fit in the SSO buffer");
+    DynError moved = move(*string_error);
+    string_error.reset();
+    EXPECT_EQ(moved.report().what(),
+              "a long error message, that doesn't fit in the SSO buffer");
+  }
+}
@@ -0,0 +1,139 @@
+/**
+ * @file error_code_test.cc
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-10
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#include "stx/error_code.h"
+
+#include <cerrno>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "stx/backtrace.h"
+
+using namespace std;
+using namespace string_literals;
+using namespace stx;
+
+enum class DbError { Locked = 1, Corrupt = 2 };
+
+inline string_view db_error_message(int64_t value) noexcept {
+  switch (static_cast<DbError>(value)) {
+    case DbError::Locked:
+      return "database is locked";
+    case DbError::Corrupt:
+      return "database is corrupt";
+    default:
+      return "unknown database error";
+  }
+}
+
+inline constexpr ErrorCategory db_error_category{"db", db_error_message};
+
+template <>
+struct stx::error_code_traits<DbError> {
+  static constexpr ErrorCategory const* category = &db_error_category;
+};
+
+auto lock(int64_t row) -> Result<int64_t, DbError> {
+  if (row < 0) return Err(DbError::Locked);
+  return Ok(move(row));
+}
+
+auto update(int64_t row) -> Result<int64_t, ErrorCode> {
+  if (row == 0) return Err(ErrorCode(errno_category, EINVAL));
+  TRY_OK(locked, lock(row));
+  return Ok(locked + 1);
+}
+
+TEST(ErrorCodeTest, Layout) {
+  EXPECT_TRUE(is_trivially_copyable_v<ErrorCode>);
+  EXPECT_EQ(sizeof(ErrorCode), 2 * sizeof(void*));
+  EXPECT_EQ(sizeof(Option<ErrorCode>), sizeof(ErrorCode));
+
+  // the value is packed after the category pointer
+  EXPECT_EQ(sizeof(Result<int64_t, ErrorCode>), sizeof(ErrorCode));
+  EXPECT_EQ(sizeof(Result<double, ErrorCode>), sizeof(ErrorCode));
+  EXPECT_EQ(sizeof(Result<uint8_t, ErrorCode>), sizeof(ErrorCode));
+  EXPECT_TRUE((is_trivially_copyable_v<Result<int64_t, ErrorCode>>));
+
+  // too large, or not trivially copyable
+  EXPECT_GT((sizeof(Result<ErrorCode, ErrorCode>)), sizeof(ErrorCode));
+  EXPECT_GT((sizeof(Result<string, ErrorCode>)), sizeof(string));
+}
+
+TEST(ErrorCodeTest, PackedResult) {
+  Result<int64_t, ErrorCode> ok = Ok<int64_t>(-1);
+  EXPECT_TRUE(ok.is_ok());
+  EXPECT_EQ(ok.value(), -1);
+
+  Result<int64_t, ErrorCode> err = Err(ErrorCode(errno_category, ENOENT));
+  EXPECT_TRUE(err.is_err());
+  EXPECT_EQ(err.err_value(), ErrorCode(errno_category, ENOENT));
+
+  // assignment across the variants
+  ok = move(err);
+  EXPECT_TRUE(ok.is_err());
+  ok = Ok<int64_t>(8);
+  EXPECT_EQ(move(ok).unwrap(), 8);
+
+  EXPECT_EQ(update(4), Ok<int64_t>(5));
+  EXPECT_EQ(update(0), Err(ErrorCode(errno_category, EINVAL)));
+  EXPECT_EQ(update(-1), Err(ErrorCode(DbError::Locked)));
+}
+
+TEST(ErrorCodeTest, Categories) {
+  ErrorCode db = DbError::Corrupt;
+  EXPECT_EQ(&db.category(), &db_error_category);
+  EXPECT_EQ(db.value(), 2);
+  EXPECT_EQ(db.message(), "database is corrupt");
+  EXPECT_TRUE(db.is(DbError::Corrupt));
+  EXPECT_FALSE(db.is(DbError::Locked));
+
+  // same value, different categories
+  EXPECT_NE(ErrorCode(errno_category, 2), db);
+
+  errno = ENOENT;
+  ErrorCode io = ErrorCode::from_errno();
+  EXPECT_EQ(io.category().name, "errno");
+  EXPECT_EQ(io.value(), ENOENT);
+  EXPECT_EQ(io.message(), strerror(ENOENT));
+
+  ErrorCode signal = backtrace::SignalError::SigErr;
+  EXPECT_EQ(signal.category().name, "signal");
+  EXPECT_EQ(signal.message(), "'std::signal' returned 'SIGERR'");
+}
+
+TEST(ErrorCodeTest, Report) {
+  EXPECT_EQ((report_query >> ErrorCode(DbError::Locked)).what(),
+            "db: database is locked (1)");
+  EXPECT_EQ((report_query >> ErrorCode(errno_category, ENOENT)).what(),
+            "errno: "s + strerror(ENOENT) + " (2)");
+
+  EXPECT_DEATH_IF_SUPPORTED(update(-1).unwrap(), ".*");
+}
@@ -0,0 +1,207 @@
+/**
+ * @file error_set_test.cc
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-09
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#include "stx/error_set.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace string_literals;
+using namespace stx;
+
+enum class IoError : uint8_t { Closed, TimedOut };
+enum class ParseError : uint8_t { Truncated, BadChecksum };
+enum class AuthError : uint8_t { Denied };
+
+using ServiceError = ErrorSet<IoError, ParseError, AuthError>;
+
+auto read(int fd) -> Result<int, IoError> {
+  if (fd < 0) return Err(IoError::Closed);
+  return Ok(move(fd));
+}
+
+auto parse(int frame) -> Result<int, ParseError> {
+  if (frame == 0) return Err(ParseError::Truncated);
+  return Ok(frame * 2);
+}
+
+auto read_and_parse(int fd) -> Result<int, ErrorSet<IoError, ParseError>> {
+  TRY_OK(frame, read(fd));
+  TRY_OK(message, parse(frame));
+  return Ok(move(message));
+}
+
+auto authenticate(int user) -> Result<void, AuthError> {
+  if (user != 1) return Err(AuthError::Denied);
+  return Ok();
+}
+
+auto serve(int user, int fd) -> Result<int, ServiceError> {
+  TRY_OK(authenticate(user));
+  TRY_OK(message, read_and_parse(fd));
+  return Ok(message + 1);
+}
+
+TEST(ErrorSetTest, Layout) {
+  static_assert(sizeof(ServiceError) == 2);
+  static_assert(is_same_v<ServiceError::tag_type, uint8_t>);
+  static_assert(is_trivially_copyable_v<ServiceError>);
+  static_assert(ServiceError::index_of<ParseError> == 1);
+  static_assert(ServiceError::contains<AuthError>);
+  static_assert(!ServiceError::contains<int>);
+  static_assert(!is_trivially_copyable_v<ErrorSet<IoError, string>>);
+
+#if CFG(ENDIAN, LITTLE)
+  // packed next to the discriminant of a pointer-tagged `Result`
+  static_assert(sizeof(Result<int*, ServiceError>) == sizeof(int*));
+#endif
+}
+
+TEST(ErrorSetTest, Observers) {
+  ServiceError error = ParseError::BadChecksum;
+  EXPECT_EQ(error.index(), 1);
+  EXPECT_TRUE(error.is<ParseError>());
+  EXPECT_FALSE(error.is<IoError>());
+  EXPECT_EQ(error, ParseError::BadChecksum);
+  EXPECT_NE(error, ParseError::Truncated);
+  EXPECT_NE(error, IoError::Closed);
+  EXPECT_EQ(error, ServiceError{ParseError::BadChecksum});
+  EXPECT_NE(error, ServiceError{IoError::Closed});
+
+  EXPECT_EQ(error.get<ParseError>(), Some(ParseError::BadChecksum));
+  EXPECT_EQ(error.get<IoError>(), None);
+  EXPECT_EQ(ServiceError{error}.take<ParseError>(),
+            Some(ParseError::BadChecksum));
+  EXPECT_EQ(move(error).take<AuthError>(), None);
+
+  ServiceError in_place{in_place_type<AuthError>, AuthError::Denied};
+  EXPECT_EQ(in_place, AuthError::Denied);
+}
+
+TEST(ErrorSetTest, Match) {
+  auto describe = [](ServiceError error) {
+    return move(error).match(
+        [](IoError io) {
+          return io == IoError::TimedOut ? "timed out"s : "closed"s;
+        },
+        [](ParseError) { return "parse"s; },
+        [](AuthError) { return "auth"s; });
+  };
+
+  EXPECT_EQ(describe(IoError::TimedOut), "timed out");
+  EXPECT_EQ(describe(IoError::Closed), "closed");
+  EXPECT_EQ(describe(ParseError::Truncated), "parse");
+  EXPECT_EQ(describe(AuthError::Denied), "auth");
+
+  ServiceError error = AuthError::Denied;
+  size_t index =
+      error.match([](auto e) { return ServiceError::index_of<decltype(e)>; });
+  EXPECT_EQ(index, 2);
+
+  ServiceError const& cref = error;
+  EXPECT_TRUE(cref.match([](IoError const&) { return false; },
+                         [](ParseError const&) { return false; },
+                         [](AuthError const&) { return true; }));
+}
+
+template <int N>
+struct Code {
+  int value;
+};
+
+TEST(ErrorSetTest, LargeMatch) {
+  // dispatched through a table of function pointers
+  using Error = ErrorSet<Code<0>, Code<1>, Code<2>, Code<3>, Code<4>, Code<5>,
+                         Code<6>, Code<7>, Code<8>, Code<9>>;
+
+  auto sum = [](Error error) {
+    return move(error).match([](auto code) {
+      return Error::index_of<decltype(code)> * 100 + code.value;
+    });
+  };
+
+  EXPECT_EQ(sum(Code<0>{7}), 7);
+  EXPECT_EQ(sum(Code<4>{7}), 407);
+  EXPECT_EQ(sum(Code<9>{1}), 901);
+
+  ErrorSet<Code<9>, Code<2>> narrow = Code<2>{5};
+  Error wide = move(narrow);
+  EXPECT_EQ(wide.index(), 2);
+  EXPECT_EQ(sum(wide), 205);
+}
+
+TEST(ErrorSetTest, Widening) {
+  EXPECT_EQ(read_and_parse(4), Ok(8));
+  EXPECT_EQ(read_and_parse(-1),
+            Err(ErrorSet<IoError, ParseError>{IoError::Closed}));
+  EXPECT_EQ(read_and_parse(0),
+            Err(ErrorSet<IoError, ParseError>{ParseError::Truncated}));
+
+  EXPECT_EQ(serve(1, 4), Ok(9));
+  EXPECT_EQ(serve(2, 4), Err(ServiceError{AuthError::Denied}));
+  EXPECT_EQ(serve(1, -1), Err(ServiceError{IoError::Closed}));
+  EXPECT_EQ(serve(1, 0), Err(ServiceError{ParseError::Truncated}));
+
+  // the members are reordered
+  ErrorSet<AuthError, ParseError> narrow = ParseError::BadChecksum;
+  ServiceError wide = move(narrow);
+  EXPECT_EQ(wide.index(), 1);
+  EXPECT_EQ(wide, ParseError::BadChecksum);
+}
+
+TEST(ErrorSetTest, NonTrivial) {
+  using Error = ErrorSet<IoError, string, vector<int>>;
+
+  Error a = "connection reset"s;
+  Error b = a;
+  EXPECT_EQ(b, "connection reset"s);
+  b = vector{1, 2, 3};
+  EXPECT_EQ(b, (vector{1, 2, 3}));
+  b = a;
+  EXPECT_EQ(b, "connection reset"s);
+  b = IoError::Closed;
+  EXPECT_EQ(b, IoError::Closed);
+
+  Error c = move(a);
+  EXPECT_EQ(c.get<string>().map([](auto s) { return s.get().size(); }),
+            Some(16UL));
+
+  ErrorSet<string, AuthError> narrow = "expired token"s;
+  ErrorSet<IoError, AuthError, string> wide = move(narrow);
+  EXPECT_EQ(wide, "expired token"s);
+
+  auto fail = []() -> Result<int, Error> {
+    return Err("unreachable"s);
+  };
+  EXPECT_EQ(fail(), Err(Error{"unreachable"s}));
+}
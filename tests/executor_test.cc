@@ -0,0 +1,150 @@
+/**
+ * @file executor_test.cc
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-20
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+
+#include "stx/executor.h"
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace stx;
+
+TEST(ExecutorTest, SubmitAndWait) {
+  Executor executor{4};
+  EXPECT_EQ(executor.num_workers(), 4);
+
+  atomic<int> sum{0};
+  vector<TaskHandle> handles;
+  for (int i = 1; i <= 100; i++) {
+    auto handle = executor.submit("add", [&sum, i] { sum += i; });
+    ASSERT_TRUE(handle.is_ok());
+    handles.push_back(std::move(handle).unwrap());
+  }
+
+  for (auto& handle : handles) {
+    handle.wait();
+    EXPECT_TRUE(handle.is_done());
+    EXPECT_EQ(handle.name(), "add");
+  }
+  EXPECT_EQ(sum.load(), 5050);
+}
+
+TEST(ExecutorTest, WaitIdle) {
+  Executor executor{2};
+  atomic<int> count{0};
+  for (int i = 0; i < 1'000; i++) {
+    EXPECT_TRUE(executor.submit("count", [&count] { count++; }).is_ok());
+  }
+  executor.wait_idle();
+  EXPECT_EQ(count.load(), 1'000);
+
+  // idle executor
+  executor.wait_idle();
+}
+
+TEST(ExecutorTest, NestedSubmission) {
+  Executor executor{4};
+  atomic<int> count{0};
+
+  // the subtasks are pushed to the submitting worker's deque and are stolen
+  // by the other workers
+  for (int i = 0; i < 16; i++) {
+    auto handle = executor.submit("fork", [&executor, &count] {
+      for (int j = 0; j < 64; j++) {
+        EXPECT_TRUE(executor.submit("leaf", [&count] { count++; }).is_ok());
+      }
+    });
+    EXPECT_TRUE(handle.is_ok());
+  }
+
+  executor.wait_idle();
+  EXPECT_EQ(count.load(), 16 * 64);
+}
+
+TEST(ExecutorTest, QueueFull) {
+  Executor executor{1, 4};
+  atomic<bool> release{false};
+
+  // keeps the only worker busy so the injection queue isn't drained
+  auto blocker = executor.submit("block", [&release] {
+    while (!release.load()) this_thread::yield();
+  });
+  ASSERT_TRUE(blocker.is_ok());
+  while (executor.submit("fill", [] {}).is_ok()) {
+  }
+
+  auto rejected = executor.submit("rejected", [] {});
+  ASSERT_TRUE(rejected.is_err());
+  EXPECT_EQ(rejected.err_value(), SubmitError::QueueFull);
+
+  release = true;
+  executor.wait_idle();
+  EXPECT_TRUE(executor.submit("accepted", [] {}).is_ok());
+}
+
+TEST(ExecutorTest, ThisWorker) {
+  EXPECT_TRUE(this_worker::id().is_none());
+  EXPECT_TRUE(this_worker::task_name().is_none());
+
+  Executor executor{3};
+  Option<size_t> id = None;
+  string name;
+  auto handle = executor.submit("inspect", [&] {
+    id = this_worker::id();
+    name = string{this_worker::task_name().unwrap_or("")};
+  });
+  ASSERT_TRUE(handle.is_ok());
+  handle.value().wait();
+
+  ASSERT_TRUE(id.is_some());
+  EXPECT_LT(id.value(), 3);
+  EXPECT_EQ(name, "inspect");
+}
+
+namespace {
+
+void panic_in_task() {
+  Executor executor{2};
+  auto handle = executor.submit("explode", [] { panic("boom"); });
+  if (handle.is_ok()) handle.value().wait();
+}
+
+}  // namespace
+
+TEST(ExecutorDeathTest, PanicReportsWorkerAndTask) {
+  EXPECT_DEATH(panic_in_task(),
+               "worker [0-9]+ panicked while running task 'explode'");
+}
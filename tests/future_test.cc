@@ -0,0 +1,219 @@
+/**
+ * @file future_test.cc
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-20
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+
+#include "stx/future.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "stx/error_set.h"
+
+using namespace std;
+using namespace stx;
+
+namespace {
+
+enum class IoError { Closed };
+
+using Error = ErrorSet<IoError, FutureError>;
+
+}  // namespace
+
+TEST(FutureTest, FulfillAndGet) {
+  FutureSlot<int, FutureError> slot;
+  auto [promise, future] = make_future(slot);
+  EXPECT_FALSE(future.is_ready());
+  std::move(promise).fulfill(Ok(42));
+  EXPECT_TRUE(future.is_ready());
+  EXPECT_EQ(std::move(future).get(), Ok(42));
+
+  // the slot is reused once its ends are gone
+  auto [promise2, future2] = make_future(slot);
+  std::move(promise2).fulfill(Err(FutureError::Panicked));
+  EXPECT_EQ(std::move(future2).get(), Err(FutureError::Panicked));
+}
+
+TEST(FutureTest, CrossThread) {
+  for (int i = 0; i < 100; i++) {
+    FutureSlot<string, Error> slot;
+    auto [promise, future] = make_future(slot);
+    thread producer{[promise = std::move(promise), i]() mutable {
+      if (i % 2 == 0) std::this_thread::sleep_for(chrono::microseconds{50});
+      std::move(promise).fulfill_with(
+          [i]() -> Result<string, Error> { return Ok(to_string(i)); });
+    }};
+    EXPECT_EQ(std::move(future).get(), Ok(to_string(i)));
+    producer.join();
+  }
+}
+
+TEST(FutureTest, SlotDestroyedOnRelease) {
+  for (int i = 0; i < 200; i++) {
+    thread producer;
+    {
+      FutureSlot<int, Error> slot;
+      auto [promise, future] = make_future(slot);
+      producer = thread{[promise = std::move(promise), i]() mutable {
+        if (i % 2 == 0) std::this_thread::sleep_for(chrono::microseconds{50});
+        std::move(promise).fulfill(Ok(int{i}));
+      }};
+      { Future<int, Error> dropped = std::move(future); }
+      // the destructor parks until the producer is done releasing the slot
+    }
+    producer.join();
+  }
+}
+
+TEST(FutureTest, Allocated) {
+  auto [promise, future] = make_future<unique_ptr<int>, FutureError>();
+  thread producer{[promise = std::move(promise)]() mutable {
+    std::move(promise).fulfill(Ok(make_unique<int>(7)));
+  }};
+  auto value = std::move(future).get().unwrap();
+  EXPECT_EQ(*value, 7);
+  producer.join();
+
+  // the slot is freed by the last end, in either order
+  {
+    auto [promise2, future2] = make_future<string, FutureError>();
+    { Future<string, FutureError> dropped = std::move(future2); }
+  }
+}
+
+TEST(FutureTest, BrokenPromise) {
+  FutureSlot<int, Error> slot;
+  auto [promise, future] = make_future(slot);
+  { Promise<int, Error> dropped = std::move(promise); }
+  EXPECT_EQ(std::move(future).get(), Err(Error{FutureError::BrokenPromise}));
+}
+
+TEST(FutureTest, Then) {
+  // attached before the promise is fulfilled
+  {
+    FutureSlot<int, FutureError> slot;
+    auto [promise, future] = make_future(slot);
+    int seen = 0;
+    std::move(future).then(
+        [&seen](Result<int, FutureError>&& result) { seen = std::move(result).unwrap(); });
+    EXPECT_EQ(seen, 0);
+    std::move(promise).fulfill(Ok(5));
+    EXPECT_EQ(seen, 5);
+  }
+
+  // attached after
+  {
+    FutureSlot<int, FutureError> slot;
+    auto [promise, future] = make_future(slot);
+    std::move(promise).fulfill(Ok(6));
+    int seen = 0;
+    std::move(future).then(
+        [&seen](Result<int, FutureError>&& result) { seen = std::move(result).unwrap(); });
+    EXPECT_EQ(seen, 6);
+  }
+
+  // chained
+  {
+    FutureSlot<int, FutureError> slot;
+    FutureSlot<string, FutureError> next;
+    auto [promise, future] = make_future(slot);
+    Future<string, FutureError> text = std::move(future).then(
+        next, [](Result<int, FutureError>&& result) {
+          return std::move(result).map([](int x) { return to_string(x * 2); });
+        });
+    thread producer{[promise = std::move(promise)]() mutable {
+      std::move(promise).fulfill(Ok(21));
+    }};
+    EXPECT_EQ(std::move(text).get(), Ok("42"s));
+    producer.join();
+  }
+}
+
+namespace {
+
+// halts the panicking thread instead of aborting, the waiter is still woken
+// up and exits
+[[noreturn]] void wait_for_panicking_producer() {
+  (void)attach_panic_hook([](std::string_view const&, ReportPayload const&,
+                             SourceLocation const&) noexcept {
+    while (true) std::this_thread::sleep_for(chrono::seconds{1});
+  });
+  FutureSlot<int, Error> slot;
+  auto [promise, future] = make_future(slot);
+  thread{[promise = std::move(promise)]() mutable {
+    std::move(promise).fulfill_with(
+        []() -> Result<int, Error> { panic("producer failed"); });
+  }}.detach();
+  auto result = std::move(future).get();
+  std::_Exit(result == Err(Error{FutureError::Panicked}) ? 0 : 1);
+}
+
+}  // namespace
+
+TEST(FutureTest, PanickedProducer) {
+  EXPECT_EXIT(wait_for_panicking_producer(), ::testing::ExitedWithCode(0),
+              "");
+}
+
+TEST(FutureTest, ThrowingProducer) {
+  FutureSlot<int, Error> slot;
+  auto [promise, future] = make_future(slot);
+
+  EXPECT_THROW(std::move(promise).fulfill_with([]() -> Result<int, Error> {
+    throw std::runtime_error{"unreachable host"};
+  }),
+               std::runtime_error);
+
+  // the producer's guard was popped by the exception
+  PanicGuard probe;
+  stx::this_thread::push_panic_guard(probe);
+  EXPECT_EQ(probe.previous, nullptr);
+  stx::this_thread::pop_panic_guard(probe);
+
+  { Promise<int, Error> dropped = std::move(promise); }
+  EXPECT_EQ(std::move(future).get(), Err(Error{FutureError::BrokenPromise}));
+}
+
+TEST(FutureDeathTest, PopGuardOutOfOrder) {
+  PanicGuard first;
+  PanicGuard second;
+  first.on_panic = [](void*) noexcept {};
+  second.on_panic = [](void*) noexcept {};
+  stx::this_thread::push_panic_guard(first);
+  stx::this_thread::push_panic_guard(second);
+  EXPECT_DEATH(stx::this_thread::pop_panic_guard(first), "last one pushed");
+  stx::this_thread::pop_panic_guard(second);
+  stx::this_thread::pop_panic_guard(first);
+}
@@ -282,6 +282,16 @@ TEST(OptionTest, Unwrap) {
   EXPECT_DEATH_IF_SUPPORTED(Option<vector<int>>(None).unwrap(), ".*");
 }
 
+TEST(OptionTest, UnwrapUnchecked) {
+  EXPECT_EQ(Option(Some(0)).unwrap_unchecked(), 0);
+  EXPECT_EQ(Option(Some(vector{1, 2, 3})).unwrap_unchecked(),
+            (vector{1, 2, 3}));
+
+#if defined(STX_ENABLE_DEBUG_ASSERTIONS)
+  EXPECT_DEATH_IF_SUPPORTED(Option<int>(None).unwrap_unchecked(), ".*");
+#endif
+}
+
 TEST(OptionLifetimeTest, Unwrap) {
   auto a = Option(Some(make_mv<0>()));
   EXPECT_NO_THROW(move(a).unwrap().done());
@@ -310,6 +320,31 @@ TEST(OptionTest, UnwrapOr) {
             (vector{6, 7, 8, 9, 10}));
 }
 
+namespace {
+struct Point {
+  int64_t x;
+  int64_t y;
+};
+}  // namespace
+
+// trivially copyable values of up to two words are selected without branching
+TEST(OptionTest, UnwrapOrSelect) {
+  int values[] = {1, 2, 3, 4};
+  int fallback = 0;
+  int sum = 0;
+  for (int i = 0; i < 4; i++) {
+    Option<int*> value = i % 2 == 0 ? Option<int*>(Some(&values[i])) : None;
+    sum += *move(value).unwrap_or(&fallback);
+  }
+  EXPECT_EQ(sum, 4);
+
+  EXPECT_EQ(Option(Some(Point{1, 2})).unwrap_or(Point{3, 4}).y, 2);
+  EXPECT_EQ(Option<Point>(None).unwrap_or(Point{3, 4}).y, 4);
+  EXPECT_EQ(Option<Point>(None).unwrap_or_default().x, 0);
+  EXPECT_EQ(Option<int>(None).unwrap_or_default(), 0);
+  EXPECT_EQ(Option(Some(7)).unwrap_or_default(), 7);
+}
+
 TEST(OptionLifetimeTest, UnwrapOr) {
   auto a = Option(Some(make_mv<0>()));
   EXPECT_NO_THROW(move(a).unwrap_or(make_mv<0>()).done());
@@ -630,9 +665,10 @@ TEST(OptionTest, Clone) {
   EXPECT_EQ(a.clone(), Some(9));
   EXPECT_EQ(a, Some(9));
 
-  auto b = Option(Some<int*>(nullptr));
-  EXPECT_EQ(b.clone(), Some<int*>(nullptr));
-  EXPECT_EQ(b, Some<int*>(nullptr));
+  int x = 8;
+  auto b = Option(Some<int*>(&x));
+  EXPECT_EQ(b.clone(), Some<int*>(&x));
+  EXPECT_EQ(b, Some<int*>(&x));
 
   auto c = Option(Some(vector<int>{1, 2, 3, 4, 5}));
   EXPECT_EQ(c.clone(), Some(vector<int>{1, 2, 3, 4, 5}));
@@ -742,4 +778,181 @@ TEST(OptionTest, TrySome) {
   EXPECT_EQ(opt_try_a(-10), None);
 }
 
+auto opt_try_ref(int m) -> Option<size_t> {
+  auto opt = m > 0 ? make_some(vector<int>(static_cast<size_t>(m), m))
+                   : make_none<vector<int>>();
+  TRY_SOME_REF(x, std::move(opt));
+  EXPECT_EQ(&x, &opt.value());
+  TRY_SOME_REF(y, opt_try_b(m));
+  return Some(x.size() + static_cast<size_t>(y));
+}
+
+TEST(OptionTest, TrySomeRef) {
+  EXPECT_EQ(opt_try_ref(3), Some(6UL));
+  EXPECT_EQ(opt_try_ref(-3), None);
+}
+
+#if CFG(COMPILER, GNUC)
+auto opt_try_expr(int a, int b) -> Option<int> {
+  return Some(TRY_SOME_EXPR(opt_try_b(a)) * TRY_SOME_EXPR(opt_try_b(b)));
+}
+
+TEST(OptionTest, TrySomeExpr) {
+  EXPECT_EQ(opt_try_expr(2, 3), Some(6));
+  EXPECT_EQ(opt_try_expr(-2, 3), None);
+  EXPECT_EQ(opt_try_expr(2, -3), None);
+}
+#endif
+
+enum class Slot : uint32_t { Zero = 0, One = 1, Invalid = UINT32_MAX };
+
+struct Fd {
+  int fd = -1;
+  bool operator==(Fd const& other) const { return fd == other.fd; }
+  bool operator!=(Fd const& other) const { return fd != other.fd; }
+};
+
+template <>
+struct stx::niche_traits<Slot>
+    : stx::sentinel_niche_traits<Slot, Slot::Invalid> {};
+
+template <>
+struct stx::niche_traits<Fd> {
+  static constexpr bool available = true;
+  static void set_none(Fd* slot) noexcept { new (slot) Fd{-1}; }
+  static bool is_none(Fd const* slot) noexcept { return slot->fd == -1; }
+};
+
+TEST(OptionTest, NicheTraits) {
+  static_assert(sizeof(Option<Slot>) == sizeof(uint32_t));
+  static_assert(sizeof(Option<Fd>) == sizeof(int));
+  static_assert(sizeof(Option<bool>) == sizeof(bool));
+  static_assert(sizeof(Option<uint32_t>) == 2 * sizeof(uint32_t));
+
+  Option<Slot> a = None;
+  EXPECT_TRUE(a.is_none());
+  EXPECT_EQ(a.replace(Slot::Zero), None);
+  EXPECT_EQ(a, Some(Slot::Zero));
+  EXPECT_EQ(a.take(), Some(Slot::Zero));
+  EXPECT_EQ(a, None);
+  EXPECT_EQ(Option(Some(Slot::Invalid)), None);
+
+  Option<Fd> b = Some(Fd{0});
+  EXPECT_TRUE(b.is_some());
+  EXPECT_EQ(b.clone().map([](Fd fd) { return fd.fd; }), Some(0));
+  EXPECT_EQ(Option(Some(Fd{-1})), None);
+
+  Option<bool> c = None;
+  EXPECT_EQ(c, None);
+  c = Some(false);
+  EXPECT_EQ(c, Some(false));
+  c = Some(true);
+  EXPECT_EQ(c, Some(true));
+  EXPECT_EQ(c.take(), Some(true));
+  EXPECT_EQ(c, None);
+}
+
+TEST(OptionTest, NicheLayout) {
+  static_assert(sizeof(Option<int*>) == sizeof(int*));
+  static_assert(sizeof(Option<int const*>) == sizeof(int const*));
+  static_assert(sizeof(Option<void (*)(int)>) == sizeof(void (*)(int)));
+  static_assert(sizeof(Option<Ref<int>>) == sizeof(int*));
+  static_assert(sizeof(Option<ConstRef<vector<int>>>) == sizeof(void*));
+  static_assert(alignof(Option<Ref<int>>) == alignof(int*));
+  static_assert(sizeof(Option<int>) > sizeof(int));
+
+  // the null pointer represents `None`
+  EXPECT_EQ(Option(Some<int*>(nullptr)), None);
+  EXPECT_TRUE(Option<int*>(None).is_none());
+
+  int x = 8;
+  int y = 16;
+
+  Option<Ref<int>> a = None;
+  EXPECT_TRUE(a.is_none());
+  EXPECT_EQ(a.replace(x), None);
+  EXPECT_TRUE(a.is_some());
+  EXPECT_EQ(&a.clone().unwrap().get(), &x);
+
+  auto b = a.take();
+  EXPECT_TRUE(a.is_none());
+  EXPECT_EQ(b.clone().map([](int& v) { return v * 2; }), Some(16));
+
+  a = Some(Ref<int>(y));
+  swap(a, b);
+  EXPECT_EQ(&a.clone().unwrap().get(), &x);
+  EXPECT_EQ(&b.clone().unwrap().get(), &y);
+
+  Option<int*> c = Some(&x);
+  EXPECT_EQ(c.clone().map([](int* v) { return *v; }).unwrap_or(0), 8);
+  EXPECT_EQ(c.take().unwrap(), &x);
+  EXPECT_EQ(c, None);
+  EXPECT_EQ(c.clone().map([](int* v) { return *v; }).unwrap_or(0), 0);
+}
+
+TEST(OptionTest, Triviality) {
+  static_assert(is_trivially_copyable_v<Option<int>>);
+  static_assert(is_trivially_copy_constructible_v<Option<int>>);
+  static_assert(is_trivially_copy_assignable_v<Option<int>>);
+  static_assert(is_trivially_move_constructible_v<Option<int>>);
+  static_assert(is_trivially_move_assignable_v<Option<int>>);
+  static_assert(is_trivially_destructible_v<Option<int>>);
+  static_assert(is_trivially_copyable_v<Option<Ref<int>>>);
+  static_assert(is_trivially_copyable_v<Option<int*>>);
+
+  static_assert(!is_trivially_copyable_v<Option<vector<int>>>);
+  static_assert(!is_trivially_destructible_v<Option<vector<int>>>);
+  static_assert(!is_trivially_copyable_v<Option<MoveOnly<0>>>);
+
+  // move-assignment no longer swaps, the moved-from option keeps its state
+  Option a = Some(vector{1, 2, 3});
+  Option b = Some(vector{4, 5});
+  a = move(b);
+  EXPECT_EQ(a, Some(vector{4, 5}));
+  EXPECT_TRUE(b.is_some());
+
+  Option<vector<int>> c = None;
+  a = move(c);
+  EXPECT_EQ(a, None);
+  a = Some(vector{6});
+  EXPECT_EQ(a, Some(vector{6}));
+  c = a;
+  EXPECT_EQ(c, Some(vector{6}));
+}
+
+// neither copyable nor movable, i.e. holds a mutex
+struct Pinned {
+  explicit Pinned(int v, int w) : value{v + w} {}
+  Pinned(Pinned&&) = delete;
+  Pinned& operator=(Pinned&&) = delete;
+  int value;
+};
+
+TEST(OptionTest, InPlace) {
+  Option<vector<int>> a{std::in_place, 3, 7};
+  EXPECT_EQ(a, Some(vector{7, 7, 7}));
+
+  auto b = make_some_in_place<vector<int>>(2, 5);
+  EXPECT_EQ(b, Some(vector{5, 5}));
+
+  EXPECT_EQ(b.emplace(1, 6).size(), 1);
+  EXPECT_EQ(b, Some(vector{6}));
+
+  Option<vector<int>> c = None;
+  c.emplace(1, 4).push_back(8);
+  EXPECT_EQ(c, Some(vector{4, 8}));
+
+  auto d = make_some_in_place<Pinned>(2, 3);
+  EXPECT_EQ(d.value().value, 5);
+  d.emplace(4, 4);
+  EXPECT_EQ(d.value().value, 8);
+
+  Option<Pinned> e = None;
+  EXPECT_TRUE(e.is_none());
+  e.emplace(1, 1);
+  EXPECT_EQ(e.value().value, 2);
+
+  static_assert(!std::is_constructible_v<Option<int>, std::in_place_t, void*>);
+}
+
 TEST(OptionTest, Docs) {}
@@ -0,0 +1,166 @@
+/**
+ * @file option_vec_test.cc
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-19
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#include "stx/option_vec.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace stx;
+
+TEST(OptionArrayTest, Access) {
+  OptionArray<double, 100> samples;
+  EXPECT_EQ(samples.size(), 100);
+  EXPECT_EQ(samples.count_some(), 0);
+  EXPECT_EQ(samples[0], None);
+
+  samples.emplace(0, 20.5);
+  samples.emplace(64, 21.0);
+  samples.emplace(99, 22.0);
+  EXPECT_TRUE(samples.is_some(64));
+  EXPECT_TRUE(samples.is_none(1));
+  EXPECT_EQ(samples.count_some(), 3);
+  EXPECT_EQ(samples[0].unwrap().get(), 20.5);
+  EXPECT_EQ(as_const(samples)[99].unwrap().get(), 22.0);
+
+  samples[64].unwrap().get() = 23.0;
+  EXPECT_EQ(samples.take(64), Some(23.0));
+  EXPECT_EQ(samples.take(64), None);
+
+  double sum = 0;
+  size_t count = 0;
+  as_const(samples).for_each_some([&](size_t index, double value) {
+    EXPECT_TRUE(index == 0 || index == 99);
+    sum += value;
+    count++;
+  });
+  EXPECT_EQ(count, 2);
+  EXPECT_EQ(sum, 42.5);
+
+  samples.clear();
+  EXPECT_EQ(samples.count_some(), 0);
+}
+
+TEST(OptionArrayTest, Lifetime) {
+  auto shared = make_shared<int>(5);
+  {
+    OptionArray<shared_ptr<int>, 10> a;
+    a.emplace(1, shared);
+    a.emplace(3, shared);
+    a.emplace(3, shared);
+    EXPECT_EQ(shared.use_count(), 3);
+
+    OptionArray<shared_ptr<int>, 10> b = move(a);
+    EXPECT_EQ(b.count_some(), 2);
+    EXPECT_EQ(shared.use_count(), 3);
+    a.clear();
+    EXPECT_EQ(b[1].unwrap().get(), shared);
+  }
+  EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST(OptionVecTest, Push) {
+  OptionVec<int> vec;
+  EXPECT_TRUE(vec.empty());
+
+  // spans several bitmask words and capacity doublings
+  for (int i = 0; i < 1000; i++) {
+    if (i % 3 == 0) {
+      vec.push(Some(int{i}));
+    } else {
+      vec.push_none();
+    }
+  }
+
+  EXPECT_EQ(vec.size(), 1000);
+  EXPECT_EQ(vec.count_some(), 334);
+  EXPECT_EQ(vec[3].unwrap().get(), 3);
+  EXPECT_EQ(vec[4], None);
+
+  size_t count = 0;
+  vec.for_each_some([&](size_t index, int& value) {
+    EXPECT_EQ(static_cast<int>(index), value);
+    count++;
+  });
+  EXPECT_EQ(count, 334);
+
+  vec.emplace(4, 40);
+  EXPECT_EQ(as_const(vec)[4].unwrap().get(), 40);
+  EXPECT_EQ(vec.take(4), Some(40));
+  EXPECT_TRUE(vec.is_none(4));
+}
+
+TEST(OptionVecTest, PushAliasing) {
+  OptionVec<string> vec;
+  vec.push_some("a value past the small buffer"s);
+  while (vec.size() != vec.capacity()) vec.push_none();
+
+  // the values are relocated by the push, the argument refers to the old ones
+  size_t const index = vec.size();
+  vec.push_some(vec[0].unwrap().get());
+
+  EXPECT_EQ(vec[index].unwrap().get(), "a value past the small buffer");
+  EXPECT_EQ(vec[0].unwrap().get(), "a value past the small buffer");
+}
+
+TEST(OptionVecTest, Lifetime) {
+  auto shared = make_shared<int>(5);
+  {
+    OptionVec<shared_ptr<int>> vec;
+    for (int i = 0; i < 100; i++) {
+      if (i % 2 == 0) {
+        vec.push_some(shared);
+      } else {
+        vec.push(None);
+      }
+    }
+    EXPECT_EQ(shared.use_count(), 51);
+
+    OptionVec<shared_ptr<int>> moved = move(vec);
+    EXPECT_TRUE(vec.empty());
+    EXPECT_EQ(moved.count_some(), 50);
+
+    moved.clear();
+    EXPECT_EQ(shared.use_count(), 1);
+    moved.push_some(shared);
+    EXPECT_EQ(shared.use_count(), 2);
+  }
+  EXPECT_EQ(shared.use_count(), 1);
+
+  OptionVec<string> strings;
+  for (int i = 0; i < 100; i++) {
+    strings.push_some("a string past the small buffer "s + to_string(i));
+  }
+  EXPECT_EQ(strings[99].unwrap().get(), "a string past the small buffer 99");
+}
@@ -29,9 +29,76 @@
 
 #include "stx/panic.h"
 
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+
 #include "gtest/gtest.h"
+#include "stx/option.h"
+#include "stx/result.h"
 
 TEST(PanicTest, Panics) {
   EXPECT_DEATH_IF_SUPPORTED(stx::panic(), ".*");
   EXPECT_DEATH_IF_SUPPORTED(stx::panic("hello, world"), ".*");
 }
+
+#if !defined(STX_COMPACT_SOURCE_LOCATION)
+
+// the out-of-line panic paths report the caller, not the panic helpers
+TEST(PanicTest, UnwrapReportsCallSite) {
+  stx::Option<int> none = stx::None;
+  stx::Result<int, int> err = stx::Err(1);
+
+  EXPECT_DEATH_IF_SUPPORTED((void)std::move(none).unwrap(),
+                            "panic_test\\.cc:[0-9]+");
+  EXPECT_DEATH_IF_SUPPORTED((void)none.value(), "panic_test\\.cc:[0-9]+");
+  EXPECT_DEATH_IF_SUPPORTED((void)std::move(err).expect("expected"),
+                            "panic_test\\.cc:[0-9]+");
+  EXPECT_DEATH_IF_SUPPORTED((void)std::move(err).unwrap(),
+                            "at function: .TestBody");
+}
+
+#else
+
+TEST(PanicTest, CompactSourceLocation) {
+  static_assert(sizeof(stx::SourceLocation) == sizeof(uint32_t));
+
+  // clang-format off
+  auto location = stx::SourceLocation::current(); auto line = __LINE__;
+  // clang-format on
+
+  EXPECT_EQ(location.id(), stx::internal::call_site_id(__FILE__, line));
+  EXPECT_NE(location.id(), stx::SourceLocation::current().id());
+}
+
+namespace {
+
+std::string call_site_pattern(uint32_t id) {
+  char pattern[32];
+  std::snprintf(pattern, sizeof(pattern), "call site: '0x%08" PRIx32 "'", id);
+  return pattern;
+}
+
+}  // namespace
+
+// each `unwrap()` call site has its own ID, not the panic helper's
+TEST(PanicTest, CompactUnwrapCallSites) {
+  stx::Option<int> none = stx::None;
+
+  // clang-format off
+  auto first = [&] { (void)std::move(none).unwrap(); }; auto first_line = __LINE__;
+  auto second = [&] { (void)std::move(none).unwrap(); }; auto second_line = __LINE__;
+  // clang-format on
+
+  uint32_t const first_id = stx::internal::call_site_id(__FILE__, first_line);
+  uint32_t const second_id =
+      stx::internal::call_site_id(__FILE__, second_line);
+  EXPECT_NE(first_id, second_id);
+
+  EXPECT_DEATH_IF_SUPPORTED(first(), call_site_pattern(first_id));
+  EXPECT_DEATH_IF_SUPPORTED(second(), call_site_pattern(second_id));
+}
+
+#endif
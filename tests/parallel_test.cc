@@ -0,0 +1,168 @@
+/**
+ * @file parallel_test.cc
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-20
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+
+#include "stx/parallel.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace stx;
+
+namespace {
+
+enum class Error { Invalid, Overflow };
+
+}  // namespace
+
+TEST(ParallelTest, ThreadPoolRunsEveryJobOnce) {
+  par::ThreadPool pool{4};
+  EXPECT_EQ(pool.num_threads(), 4);
+
+  vector<atomic<int>> calls(1000);
+  for (int batch = 0; batch < 20; batch++) {
+    pool.run(
+        calls.size(),
+        [](void* context, size_t index) {
+          (*static_cast<vector<atomic<int>>*>(context))[index]++;
+        },
+        &calls);
+  }
+  for (auto const& count : calls) EXPECT_EQ(count.load(), 20);
+
+  // nested batches are executed on the calling thread
+  atomic<int> nested{0};
+  pool.run(
+      8,
+      [](void* context, size_t) {
+        auto& counter = *static_cast<atomic<int>*>(context);
+        par::default_thread_pool().run(
+            4, [](void* ctx, size_t) { (*static_cast<atomic<int>*>(ctx))++; },
+            &counter);
+      },
+      &nested);
+  EXPECT_EQ(nested.load(), 32);
+}
+
+TEST(ParallelTest, ThreadPoolBackToBackBatches) {
+  // short batches leave workers waking up for a batch that has already
+  // returned, they must not claim the jobs of the next one
+  par::ThreadPool pool{4};
+  for (int batch = 0; batch < 20'000; batch++) {
+    array<atomic<int>, 3> calls{};
+    pool.run(
+        calls.size(),
+        [](void* context, size_t index) {
+          (*static_cast<array<atomic<int>, 3>*>(context))[index]++;
+        },
+        &calls);
+    for (auto const& count : calls) ASSERT_EQ(count.load(), 1);
+  }
+}
+
+TEST(ParallelTest, TryTransform) {
+  par::ThreadPool pool{4};
+  vector<int> input(10'000);
+  for (size_t i = 0; i < input.size(); i++) input[i] = static_cast<int>(i);
+  vector<int64_t> output(input.size());
+
+  auto doubled = par::try_transform(
+      pool, Span<int const>(input), Span<int64_t>(output),
+      [](int x) -> Result<int64_t, Error> { return Ok(int64_t{x} * 2); });
+  ASSERT_TRUE(doubled.is_ok());
+  EXPECT_EQ(doubled.value().size(), input.size());
+  for (size_t i = 0; i < input.size(); i++) {
+    EXPECT_EQ(output[i], static_cast<int64_t>(i * 2));
+  }
+
+  EXPECT_TRUE(par::try_transform(pool, Span<int const>(), Span<int64_t>(),
+                                 [](int) -> Result<int64_t, Error> {
+                                   return Ok(int64_t{0});
+                                 })
+                  .is_ok());
+
+  vector<int64_t> small(2);
+  EXPECT_DEATH_IF_SUPPORTED(
+      (void)par::try_transform(
+          pool, Span<int const>(input), Span<int64_t>(small),
+          [](int x) -> Result<int64_t, Error> { return Ok(int64_t{x}); }),
+      ".*");
+}
+
+TEST(ParallelTest, TryTransformReturnsLowestError) {
+  par::ThreadPool pool{4};
+  vector<int> input(10'000);
+  for (size_t i = 0; i < input.size(); i++) input[i] = static_cast<int>(i);
+
+  for (int run = 0; run < 50; run++) {
+    vector<int> output(input.size(), -1);
+    auto result = par::try_transform(
+        pool, Span<int const>(input), Span<int>(output),
+        [](int x) -> Result<int, string> {
+          if (x == 9000 || x == 4321 || x == 7000) {
+            return Err("failed at " + to_string(x));
+          }
+          return Ok(int{x});
+        });
+    EXPECT_EQ(result, Err("failed at 4321"s));
+    // the elements preceding the error are always processed
+    for (int i = 0; i < 4321; i++) EXPECT_EQ(output[i], i);
+  }
+}
+
+TEST(ParallelTest, TryForEach) {
+  par::ThreadPool pool{3};
+  vector<uint8_t> input(5'000, 1);
+  atomic<size_t> sum{0};
+
+  EXPECT_EQ(par::try_for_each(pool, Span<uint8_t const>(input),
+                              [&](uint8_t x) -> Result<void, Error> {
+                                sum += x;
+                                return Ok();
+                              }),
+            Ok());
+  EXPECT_EQ(sum.load(), input.size());
+
+  input[100] = 0;
+  input[3000] = 2;
+  EXPECT_EQ(par::try_for_each(Span<uint8_t const>(input),
+                              [](uint8_t x) -> Result<void, Error> {
+                                if (x == 0) return Err(Error::Invalid);
+                                if (x == 2) return Err(Error::Overflow);
+                                return Ok();
+                              }),
+            Err(Error::Invalid));
+}
@@ -0,0 +1,145 @@
+/**
+ * @file pipe_test.cc
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-16
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#include "stx/pipe.h"
+
+#include <string>
+#include <utility>
+
+#include "gtest/gtest.h"
+#include "stx/option.h"
+#include "stx/result.h"
+
+using namespace std;
+using namespace stx;
+
+namespace {
+
+enum class Error { Empty, NotANumber };
+
+Result<int, Error> parse(string s) {
+  if (s.empty()) return Err(Error::Empty);
+  int value = 0;
+  for (char c : s) {
+    if (c < '0' || c > '9') return Err(Error::NotANumber);
+    value = value * 10 + (c - '0');
+  }
+  return Ok(move(value));
+}
+
+// counts the moves of the payload through a pipeline
+struct Counted {
+  explicit Counted(int value) : value{value} {}
+  Counted(Counted&& other) noexcept : value{other.value}, moves{other.moves} {
+    moves++;
+  }
+  Counted& operator=(Counted&& other) noexcept {
+    value = other.value;
+    moves = other.moves + 1;
+    return *this;
+  }
+
+  int value;
+  int moves = 0;
+};
+
+}  // namespace
+
+TEST(PipeTest, Option) {
+  auto twice = [](int x) { return x * 2; };
+  auto is_even = [](int x) { return x % 2 == 0; };
+  auto half = [](int x) -> Option<int> {
+    if (x % 2 != 0) return None;
+    return Some(x / 2);
+  };
+
+  EXPECT_EQ(pipe(make_some(3)) | lazy::map(twice) | lazy::unwrap_or(0), 6);
+  EXPECT_EQ(pipe(make_none<int>()) | lazy::map(twice) | lazy::unwrap_or(0), 0);
+  EXPECT_EQ(pipe(make_some(6)) | lazy::and_then(half) | lazy::and_then(half) |
+                lazy::unwrap_or(-1),
+            -1);
+  EXPECT_EQ(pipe(make_some(3)) | lazy::filter(is_even) | lazy::unwrap_or(-1),
+            -1);
+  EXPECT_EQ(pipe(make_some(4)) | lazy::filter(is_even) | lazy::collect(),
+            Some(4));
+  EXPECT_EQ(pipe(make_some(3)) | lazy::filter(is_even) | lazy::collect(),
+            None);
+  EXPECT_EQ(pipe(make_none<int>()) | lazy::unwrap_or_else([] { return 7; }),
+            7);
+
+  Option name = Some("stx"s);
+  auto size = [](string const& s) { return s.size(); };
+  EXPECT_EQ(pipe(move(name)) | lazy::map(size) | lazy::collect(),
+            Some<size_t>(3));
+}
+
+TEST(PipeTest, Result) {
+  auto twice = [](int x) { return x * 2; };
+
+  EXPECT_EQ(pipe(make_ok<string, Error>("21"s)) | lazy::and_then(parse) |
+                lazy::map(twice) | lazy::unwrap_or(0),
+            42);
+  EXPECT_EQ(pipe(make_ok<string, Error>("4x"s)) | lazy::and_then(parse) |
+                lazy::map(twice) | lazy::collect(),
+            Err(Error::NotANumber));
+  EXPECT_EQ(pipe(make_err<string, Error>(Error::Empty)) |
+                lazy::and_then(parse) | lazy::collect(),
+            Err(Error::Empty));
+
+  auto describe = [](Error error) {
+    return error == Error::Empty ? "empty"s : "not a number"s;
+  };
+  EXPECT_EQ(pipe(make_ok<string, Error>(""s)) | lazy::and_then(parse) |
+                lazy::map_err(describe) | lazy::collect(),
+            Err("empty"s));
+  EXPECT_EQ(pipe(make_ok<string, Error>("5"s)) | lazy::and_then(parse) |
+                lazy::map_err(describe) | lazy::collect(),
+            Ok(5));
+}
+
+TEST(PipeTest, NoIntermediateMoves) {
+  auto identity = [](Counted&& c) -> Counted&& { return move(c); };
+  auto keep = [](Counted const&) { return true; };
+
+  // the value is only moved out of the source by the terminal stage
+  Option source = Some(Counted{1});
+  int const moves = source.value().moves;
+  Counted c = pipe(move(source)) | lazy::filter(keep) | lazy::filter(keep) |
+              lazy::map(identity) | lazy::unwrap_or(Counted{0});
+  EXPECT_EQ(c.value, 1);
+  EXPECT_EQ(c.moves, moves + 1);
+
+  // the alternative is only moved from when the pipeline fails
+  Counted alt{2};
+  Counted d = pipe(make_none<Counted>()) | lazy::filter(keep) |
+              lazy::unwrap_or(move(alt));
+  EXPECT_EQ(d.value, 2);
+  EXPECT_EQ(d.moves, 1);
+}
@@ -0,0 +1,130 @@
+/**
+ * @file relocation_test.cc
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-12
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#include "stx/relocation.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "stx/error_set.h"
+#include "stx/option.h"
+#include "stx/result.h"
+
+using namespace std;
+using namespace stx;
+
+namespace {
+
+enum class Error { Invalid };
+
+// points to itself, moving it requires fixing up the pointer
+struct SelfReferential {
+  explicit SelfReferential(int value) noexcept : value{value}, self{this} {}
+  SelfReferential(SelfReferential&& other) noexcept
+      : value{other.value}, self{this} {}
+  SelfReferential& operator=(SelfReferential&& other) noexcept {
+    value = other.value;
+    return *this;
+  }
+  ~SelfReferential() noexcept { EXPECT_EQ(self, this); }
+
+  int value;
+  SelfReferential* self;
+};
+
+struct Handle {
+  explicit Handle(int value) noexcept : value{new int(value)} {}
+  Handle(Handle&& other) noexcept : value{exchange(other.value, nullptr)} {}
+  ~Handle() noexcept { delete value; }
+
+  int* value;
+};
+
+}  // namespace
+
+template <>
+struct stx::is_trivially_relocatable<Handle> : std::true_type {};
+
+TEST(RelocationTest, Trait) {
+  EXPECT_TRUE(trivially_relocatable<int>);
+  EXPECT_TRUE(trivially_relocatable<unique_ptr<int>>);
+  EXPECT_TRUE(trivially_relocatable<shared_ptr<int>>);
+  EXPECT_EQ(trivially_relocatable<vector<int>>, !STX_STD_DEBUG_CONTAINERS);
+  EXPECT_TRUE(trivially_relocatable<Handle>);
+  EXPECT_FALSE(trivially_relocatable<SelfReferential>);
+
+  EXPECT_TRUE(trivially_relocatable<Option<unique_ptr<int>>>);
+  EXPECT_EQ((trivially_relocatable<Result<vector<int>, Error>>),
+            !STX_STD_DEBUG_CONTAINERS);
+  EXPECT_TRUE((trivially_relocatable<Result<void, Handle>>));
+  EXPECT_TRUE((trivially_relocatable<ErrorSet<Error, unique_ptr<int>>>));
+  EXPECT_FALSE(trivially_relocatable<Option<SelfReferential>>);
+  EXPECT_FALSE((trivially_relocatable<Result<int, SelfReferential>>));
+  EXPECT_FALSE((trivially_relocatable<Result<SelfReferential, Error>>));
+}
+
+TEST(RelocationTest, TriviallyRelocatable) {
+  using Element = Option<unique_ptr<int>>;
+  alignas(Element) unsigned char source[3 * sizeof(Element)];
+  alignas(Element) unsigned char dest[3 * sizeof(Element)];
+  auto* first = reinterpret_cast<Element*>(source);
+  auto* d_first = reinterpret_cast<Element*>(dest);
+
+  new (first) Element(Some(make_unique<int>(1)));
+  new (first + 1) Element(None);
+  new (first + 2) Element(Some(make_unique<int>(3)));
+
+  EXPECT_EQ(uninitialized_relocate(first, first + 3, d_first), d_first + 3);
+  EXPECT_EQ(*d_first[0].value().get(), 1);
+  EXPECT_TRUE(d_first[1].is_none());
+  EXPECT_EQ(*d_first[2].value().get(), 3);
+
+  for (Element* it = d_first; it != d_first + 3; it++) it->~Element();
+}
+
+TEST(RelocationTest, NonTriviallyRelocatable) {
+  using Element = Result<SelfReferential, Error>;
+  alignas(Element) unsigned char source[2 * sizeof(Element)];
+  alignas(Element) unsigned char dest[2 * sizeof(Element)];
+  auto* first = reinterpret_cast<Element*>(source);
+  auto* d_first = reinterpret_cast<Element*>(dest);
+
+  new (first) Element(make_ok_in_place<SelfReferential, Error>(7));
+  new (first + 1) Element(Err(Error::Invalid));
+
+  EXPECT_EQ(uninitialized_relocate(first, first + 2, d_first), d_first + 2);
+  EXPECT_EQ(d_first[0].value().value, 7);
+  EXPECT_EQ(d_first[0].value().self, &d_first[0].value());
+  EXPECT_EQ(d_first[1].err_value(), Error::Invalid);
+
+  for (Element* it = d_first; it != d_first + 2; it++) it->~Element();
+}
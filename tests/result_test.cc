@@ -518,6 +518,25 @@ TEST(ResultTest, UnwrapOr) {
   EXPECT_EQ((make_err<string, int>(-20).unwrap_or("Unknown"s)), "Unknown"s);
 }
 
+// trivially copyable values of up to two words are selected without branching
+TEST(ResultTest, UnwrapOrSelect) {
+  int values[] = {1, 2, 3, 4};
+  int fallback = 0;
+  int sum = 0;
+  for (int i = 0; i < 4; i++) {
+    Result<int*, int> value =
+        i % 2 == 0 ? make_ok<int*, int>(&values[i]) : make_err<int*, int>(i);
+    sum += *move(value).unwrap_or(&fallback);
+  }
+  EXPECT_EQ(sum, 4);
+
+  EXPECT_EQ((make_ok<double, int>(0.5).unwrap_or(2.0)), 0.5);
+  EXPECT_EQ((make_err<double, int>(1).unwrap_or(2.0)), 2.0);
+  EXPECT_EQ((make_err<double, int>(1).unwrap_or_default()), 0.0);
+  EXPECT_EQ((make_ok<int, string>(5).unwrap_or_default()), 5);
+  EXPECT_EQ((make_err<int, string>("error"s).unwrap_or_default()), 0);
+}
+
 TEST(ResultTest, Unwrap) {
   EXPECT_EQ((make_ok<int, int>(89).unwrap()), 89);
   EXPECT_TRUE((make_err<int, int>(89).is_err()));
@@ -530,6 +549,21 @@ TEST(ResultTest, Unwrap) {
   EXPECT_TRUE((make_err<vector<int>, int>(-1)).is_err());
 }
 
+TEST(ResultTest, UnwrapUnchecked) {
+  EXPECT_EQ((make_ok<int, int>(89).unwrap_unchecked()), 89);
+  EXPECT_EQ((make_ok<vector<int>, int>(vector{1, 2, 3}).unwrap_unchecked()),
+            (vector{1, 2, 3}));
+  EXPECT_EQ((make_err<int, string>("oops"s).unwrap_err_unchecked()), "oops"s);
+
+#if defined(STX_ENABLE_DEBUG_ASSERTIONS)
+  EXPECT_DEATH_IF_SUPPORTED((make_err<int, int>(89).unwrap_unchecked()), ".*");
+  EXPECT_DEATH_IF_SUPPORTED((make_ok<int, int>(89).unwrap_err_unchecked()),
+                            ".*");
+  EXPECT_DEATH_IF_SUPPORTED(
+      (Result<void, int>(Ok()).unwrap_err_unchecked()), ".*");
+#endif
+}
+
 TEST(ResultTest, UnwrapOrElse) {
   auto a = [](int&& err) { return err + 20; };
   EXPECT_EQ((make_ok<int, int>(10).unwrap_or_else(a)), 10);
@@ -708,4 +742,296 @@ TEST(ResultTest, TryOk) {
   EXPECT_EQ(ok_try_a(-10), Err(-1));
 }
 
+auto ok_try_ref_vec(int x) -> Result<vector<int>, int> {
+  if (x > 0) return Ok(vector<int>(static_cast<size_t>(x), x));
+  return Err(-1);
+}
+
+auto ok_try_ref(int m) -> Result<size_t, int> {
+  auto result = ok_try_ref_vec(m);
+  TRY_OK_REF(x, std::move(result));
+  // binds into `result`, no move
+  EXPECT_EQ(&x, &result.value());
+  // the temporary outlives the statement
+  TRY_OK_REF(y, ok_try_ref_vec(m));
+  y.push_back(m);
+  TRY_OK_REF(z, ok_try_ref_vec(m));
+  return Ok(x.size() + y.size() + z.size());
+}
+
+TEST(ResultTest, TryOkRef) {
+  EXPECT_EQ(ok_try_ref(2), Ok(7UL));
+  EXPECT_EQ(ok_try_ref(-1), Err(-1));
+}
+
+#if CFG(COMPILER, GNUC)
+auto ok_try_expr(int a, int b) -> Result<int, int> {
+  int c = TRY_OK_EXPR(ok_try_b(a)) + TRY_OK_EXPR(ok_try_b(b));
+  return Ok(c + static_cast<int>(TRY_OK_EXPR(ok_try_ref_vec(a)).size()));
+}
+
+TEST(ResultTest, TryOkExpr) {
+  EXPECT_EQ(ok_try_expr(1, 2), Ok(4));
+  EXPECT_EQ(ok_try_expr(-1, 2), Err(-1));
+  EXPECT_EQ(ok_try_expr(1, -2), Err(-1));
+}
+#endif
+
+struct NotFound {
+  bool operator==(NotFound const&) const { return true; }
+  bool operator!=(NotFound const&) const { return false; }
+};
+
+TEST(ResultTest, NicheLayout) {
+  static_assert(sizeof(Result<int*, NotFound>) == sizeof(int*));
+  static_assert(sizeof(Result<Ref<int>, NotFound>) == sizeof(int*));
+  static_assert(sizeof(Result<NotFound, int const*>) == sizeof(int*));
+  static_assert(sizeof(Result<bool, NotFound>) == sizeof(bool));
+  static_assert(sizeof(Result<int*, uint64_t>) > sizeof(int*));
+
+  int x = 8;
+
+  Result<int*, NotFound> a = Ok(&x);
+  EXPECT_TRUE(a.is_ok());
+  EXPECT_EQ(a, Ok(&x));
+  a = Err(NotFound{});
+  EXPECT_TRUE(a.is_err());
+  EXPECT_EQ(a, Err(NotFound{}));
+  a = Ok(&x);
+  EXPECT_EQ(move(a).map([](int* v) { return *v; }).unwrap_or(0), 8);
+
+  // the null pointer represents `Err`
+  EXPECT_TRUE((make_ok<int*, NotFound>(nullptr).is_err()));
+
+  Result<NotFound, int const*> b = Err(static_cast<int const*>(&x));
+  EXPECT_TRUE(b.is_err());
+  Result<NotFound, int const*> c = Ok(NotFound{});
+  EXPECT_TRUE(c.is_ok());
+  b = move(c);
+  EXPECT_TRUE(b.is_ok());
+  EXPECT_EQ(move(b).err(), None);
+}
+
+enum class LookupError : uint8_t { Missing, Expired };
+
+struct Node {
+  int value;
+  Node* next;
+};
+
+TEST(ResultTest, PointerTagLayout) {
+#if CFG(ENDIAN, LITTLE)
+  static_assert(sizeof(Result<Node*, LookupError>) == sizeof(Node*));
+  static_assert(sizeof(Result<int const*, LookupError>) == sizeof(int*));
+  static_assert(sizeof(void*) != 8 || sizeof(Result<int*, int>) == 8);
+#endif
+  // the lowest bit of these pointers can be set, a discriminant is needed
+  static_assert(sizeof(Result<char*, LookupError>) > sizeof(char*));
+  static_assert(sizeof(Result<void*, LookupError>) > sizeof(void*));
+  static_assert(is_trivially_copyable_v<Result<Node*, LookupError>>);
+
+  Node node{8, nullptr};
+
+  Result<Node*, LookupError> a = Ok(&node);
+  EXPECT_TRUE(a.is_ok());
+  EXPECT_EQ(a, Ok(&node));
+  EXPECT_EQ(a.value()->value, 8);
+  a = Err(LookupError::Expired);
+  EXPECT_TRUE(a.is_err());
+  EXPECT_EQ(a, Err(LookupError::Expired));
+  EXPECT_EQ(a.err_value(), LookupError::Expired);
+  a = Ok(&node);
+  EXPECT_EQ(move(a).map([](Node* n) { return n->value; }).unwrap_or(0), 8);
+
+  // unlike the niche layout, the null pointer is a valid value
+  Result<Node*, LookupError> b = make_ok<Node*, LookupError>(nullptr);
+  EXPECT_TRUE(b.is_ok());
+  EXPECT_EQ(b, Ok(static_cast<Node*>(nullptr)));
+
+  Result<int*, int> c = Err(-1);
+  EXPECT_EQ(c, Err(-1));
+  c = Err(0);
+  EXPECT_TRUE(c.is_err());
+  EXPECT_EQ(move(c).unwrap_err(), 0);
+
+  Result<Node*, LookupError> d = Err(LookupError::Missing);
+  Result<Node*, LookupError> e = move(d);
+  EXPECT_EQ(e, Err(LookupError::Missing));
+  EXPECT_EQ(move(e).or_else([](LookupError) -> Result<Node*, LookupError> {
+                     return Ok(static_cast<Node*>(nullptr));
+                   }),
+            Ok(static_cast<Node*>(nullptr)));
+}
+
+TEST(ResultTest, Triviality) {
+  static_assert(is_trivially_copyable_v<Result<double, int>>);
+  static_assert(is_trivially_move_constructible_v<Result<double, int>>);
+  static_assert(is_trivially_move_assignable_v<Result<double, int>>);
+  static_assert(is_trivially_destructible_v<Result<double, int>>);
+  static_assert(is_trivially_copyable_v<Result<int*, NotFound>>);
+  static_assert(is_trivially_copyable_v<Result<NotFound, int const*>>);
+
+  static_assert(!is_trivially_copyable_v<Result<vector<int>, int>>);
+  static_assert(!is_trivially_destructible_v<Result<int, string>>);
+  static_assert(!is_copy_constructible_v<Result<double, int>>);
+
+  // move-assignment no longer swaps, the moved-from result keeps its state
+  Result<vector<int>, int> a = Ok(vector{1, 2, 3});
+  Result<vector<int>, int> b = Ok(vector{4, 5});
+  a = move(b);
+  EXPECT_EQ(a, Ok(vector{4, 5}));
+  EXPECT_TRUE(b.is_ok());
+
+  Result<vector<int>, int> c = Err(-1);
+  a = move(c);
+  EXPECT_EQ(a, Err(-1));
+  a = make_ok<vector<int>, int>(vector{6});
+  EXPECT_EQ(a, Ok(vector{6}));
+}
+
+#if (defined(__x86_64__) || defined(__aarch64__)) && !defined(_WIN32)
+
+struct CResult {
+  uint64_t payload;
+  bool is_ok;
+};
+
+[[gnu::noinline]] Result<uint64_t, uint64_t> abi_lookup(uint64_t key) {
+  if (key == 0) return Err(uint64_t{404});
+  return Ok(key * 2);
+}
+
+// a trivially copyable, register-sized `Result` must be returned in the same
+// registers as an equivalent C struct (`rax:rdx` / `x0:x1`) and not through a
+// hidden return-slot pointer
+TEST(ResultTest, RegisterABI) {
+  static_assert(sizeof(Result<uint64_t, uint64_t>) == sizeof(CResult));
+
+  auto c_lookup = reinterpret_cast<CResult (*)(uint64_t)>(
+      reinterpret_cast<void (*)()>(&abi_lookup));
+
+  CResult ok = c_lookup(21);
+  EXPECT_TRUE(ok.is_ok);
+  EXPECT_EQ(ok.payload, 42);
+
+  CResult err = c_lookup(0);
+  EXPECT_FALSE(err.is_ok);
+  EXPECT_EQ(err.payload, 404);
+}
+
+#endif
+
+auto void_check(int fd) -> Result<void, int> {
+  if (fd < 0) return Err(move(fd));
+  return Ok();
+}
+
+auto void_try(int a, int b) -> Result<void, int> {
+  TRY_OK(void_check(a));
+  TRY_OK(x, (make_ok<int, int>(move(b))));
+  TRY_OK(void_check(x));
+  return Ok();
+}
+
+auto void_try_value(int a) -> Result<int, int> {
+  TRY_OK(void_check(a));
+  return Ok(a * 2);
+}
+
+TEST(ResultTest, Void) {
+  static_assert(sizeof(Result<void, int>) == 2 * sizeof(int));
+  static_assert(sizeof(Result<void, int*>) == sizeof(int*));
+  static_assert(is_trivially_copyable_v<Result<void, int>>);
+  static_assert(!is_trivially_copyable_v<Result<void, string>>);
+
+  EXPECT_EQ(void_check(2), Ok());
+  EXPECT_EQ(void_check(-2), Err(-2));
+  EXPECT_NE(void_check(-2), Ok());
+  EXPECT_EQ(Ok(), void_check(0));
+  EXPECT_EQ((make_ok<void, int>()), Ok());
+  EXPECT_TRUE(void_check(2).is_ok());
+  EXPECT_TRUE(void_check(-2).is_err());
+  EXPECT_TRUE(void_check(-2).contains_err(-2));
+  EXPECT_EQ(void_check(-2).err(), Some(-2));
+  EXPECT_EQ(void_check(2).err(), None);
+
+  EXPECT_EQ(void_try(1, 2), Ok());
+  EXPECT_EQ(void_try(-1, 2), Err(-1));
+  EXPECT_EQ(void_try(1, -2), Err(-2));
+  EXPECT_EQ(void_try_value(4), Ok(8));
+  EXPECT_EQ(void_try_value(-4), Err(-4));
+
+  EXPECT_EQ(void_check(1).map([]() { return 5; }), Ok(5));
+  EXPECT_EQ(void_check(-1).map([]() { return 5; }), Err(-1));
+  EXPECT_EQ(void_check(1).and_then([]() {}), Ok());
+  EXPECT_EQ(void_check(1).and_then([]() { return "a"s; }), Ok("a"s));
+  EXPECT_EQ(void_check(-1).and_then([]() { return "a"s; }), Err(-1));
+  EXPECT_EQ(void_check(-1).map_err([](int e) { return to_string(e); }),
+            Err("-1"s));
+  EXPECT_EQ(void_check(1).map_err([](int e) { return to_string(e); }), Ok());
+  EXPECT_EQ(void_check(-1).or_else([](int) { return void_check(1); }), Ok());
+  EXPECT_EQ(void_check(-1).AND(make_ok<int, int>(6)), Err(-1));
+  EXPECT_EQ(void_check(1).AND(make_ok<int, int>(6)), Ok(6));
+
+  EXPECT_EQ(void_check(1).match([]() { return 200; }, [](int) { return 404; }),
+            200);
+  EXPECT_EQ(void_check(-1).match([]() { return 200; }, [](int) { return 404; }),
+            404);
+  auto a = void_check(-3);
+  EXPECT_EQ(a.match([]() { return 0; }, [](int& e) { return e; }), -3);
+  EXPECT_EQ(a.clone(), Err(-3));
+  a = void_check(3);
+  EXPECT_EQ(a, Ok());
+
+  void_check(1).unwrap();
+  void_check(1).expect("must be valid");
+  EXPECT_EQ(void_check(-1).unwrap_err(), -1);
+  EXPECT_EQ(void_check(-1).expect_err("must be invalid"), -1);
+  EXPECT_DEATH_IF_SUPPORTED(void_check(-1).unwrap(), ".*");
+  EXPECT_DEATH_IF_SUPPORTED(void_check(-1).expect("must be valid"), ".*");
+  EXPECT_DEATH_IF_SUPPORTED((void)void_check(1).unwrap_err(), ".*");
+}
+
+// neither copyable nor movable, i.e. holds a mutex
+struct Pinned {
+  explicit Pinned(int v, int w) noexcept : value{v + w} {}
+  Pinned(Pinned&&) = delete;
+  Pinned& operator=(Pinned&&) = delete;
+  int value;
+};
+
+TEST(ResultTest, InPlace) {
+  Result<vector<int>, string> a{std::in_place, 3, 7};
+  EXPECT_EQ(a, Ok(vector{7, 7, 7}));
+
+  Result<int, string> b{err_in_place, 3, 'x'};
+  EXPECT_EQ(b, Err("xxx"s));
+
+  EXPECT_EQ((make_ok_in_place<string, int>(2, 'y')), Ok("yy"s));
+  EXPECT_EQ((make_err_in_place<int, string>(2, 'z')), Err("zz"s));
+
+  EXPECT_EQ(a.emplace_err(2, 'e'), "ee"s);
+  EXPECT_EQ(a, Err("ee"s));
+  a.emplace(1, 9).push_back(10);
+  EXPECT_EQ(a, Ok(vector{9, 10}));
+
+  auto c = make_ok_in_place<Pinned, int>(2, 3);
+  EXPECT_EQ(c.value().value, 5);
+  c.emplace(4, 4);
+  EXPECT_EQ(c.value().value, 8);
+  c.emplace_err(-1);
+  EXPECT_EQ(c.err_value(), -1);
+
+  auto d = make_err_in_place<int, Pinned>(1, 1);
+  EXPECT_EQ(d.err_value().value, 2);
+
+  Result<void, string> e = Ok();
+  e.emplace_err(2, 'v');
+  EXPECT_EQ(e, Err("vv"s));
+  e.emplace();
+  EXPECT_EQ(e, Ok());
+  Result<void, Pinned> f{err_in_place, 2, 2};
+  EXPECT_TRUE(f.is_err());
+}
+
 TEST(ResultTest, Docs) {}
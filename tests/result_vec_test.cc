@@ -0,0 +1,165 @@
+/**
+ * @file result_vec_test.cc
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-18
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#include "stx/result_vec.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace stx;
+
+namespace {
+
+enum class Error { Invalid, Overflow };
+
+}  // namespace
+
+TEST(ResultVecTest, Push) {
+  ResultVec<int, Error> vec;
+  EXPECT_TRUE(vec.empty());
+
+  vec.push(Ok(1));
+  vec.push(Err(Error::Invalid));
+  vec.push_ok(3);
+  vec.push_err(Error::Overflow);
+
+  EXPECT_EQ(vec.size(), 4);
+  EXPECT_TRUE(vec.is_ok(0));
+  EXPECT_TRUE(vec.is_err(1));
+  EXPECT_EQ(vec[0].unwrap().get(), 1);
+  EXPECT_EQ(vec[1].unwrap_err().get(), Error::Invalid);
+  EXPECT_EQ(vec[2].unwrap().get(), 3);
+  EXPECT_EQ(vec[3].unwrap_err().get(), Error::Overflow);
+  EXPECT_TRUE(vec.at(3).is_some());
+  EXPECT_TRUE(vec.at(4).is_none());
+
+  vec[0].unwrap().get() = 10;
+  EXPECT_EQ(std::as_const(vec)[0].unwrap().get(), 10);
+}
+
+TEST(ResultVecTest, PushAliasing) {
+  ResultVec<string, string> vec;
+  vec.push_ok("a value past the small buffer"s);
+  vec.push_err("an error past the small buffer"s);
+  while (vec.size() != vec.capacity()) vec.push_ok("filler"s);
+
+  // the columns are relocated by the push, the argument refers to the old ones
+  size_t const ok_index = vec.size();
+  vec.push_ok(vec[0].unwrap().get());
+  while (vec.size() != vec.capacity()) vec.push_ok("filler"s);
+  size_t const err_index = vec.size();
+  vec.push_err(vec[1].unwrap_err().get());
+
+  EXPECT_EQ(vec[ok_index].unwrap().get(), "a value past the small buffer");
+  EXPECT_EQ(vec[err_index].unwrap_err().get(),
+            "an error past the small buffer");
+  EXPECT_EQ(vec[0].unwrap().get(), "a value past the small buffer");
+  EXPECT_EQ(vec[1].unwrap_err().get(), "an error past the small buffer");
+}
+
+TEST(ResultVecTest, Scan) {
+  ResultVec<int, Error> vec;
+  EXPECT_EQ(vec.count_ok(), 0);
+  EXPECT_EQ(vec.first_err(), None);
+
+  // spans several bitmask words and capacity doublings
+  for (int i = 0; i < 1000; i++) {
+    if (i % 7 == 6) {
+      vec.push_err(Error::Invalid);
+    } else {
+      vec.push_ok(i);
+    }
+  }
+
+  EXPECT_EQ(vec.size(), 1000);
+  EXPECT_EQ(vec.count_err(), 142);
+  EXPECT_EQ(vec.count_ok(), 858);
+  EXPECT_EQ(vec.first_err(), Some<size_t>(6));
+
+  int sum = 0;
+  size_t oks = 0;
+  vec.for_each_ok([&](size_t index, int& value) {
+    EXPECT_EQ(static_cast<int>(index), value);
+    sum += value;
+    oks++;
+  });
+  EXPECT_EQ(oks, 858);
+
+  size_t errs = 0;
+  std::as_const(vec).for_each_err([&](size_t index, Error const& error) {
+    EXPECT_EQ(index % 7, 6);
+    EXPECT_EQ(error, Error::Invalid);
+    errs++;
+  });
+  EXPECT_EQ(errs, 142);
+
+  size_t index = 0;
+  for (auto element : vec) {
+    EXPECT_EQ(element.is_ok(), index % 7 != 6);
+    index++;
+  }
+  EXPECT_EQ(index, 1000);
+
+  ResultVec<int, Error> all_ok;
+  for (int i = 0; i < 64; i++) all_ok.push_ok(i);
+  EXPECT_EQ(all_ok.first_err(), None);
+  all_ok.push_err(Error::Overflow);
+  EXPECT_EQ(all_ok.first_err(), Some<size_t>(64));
+}
+
+TEST(ResultVecTest, Lifetime) {
+  auto shared = make_shared<int>(5);
+  {
+    ResultVec<shared_ptr<int>, string> vec;
+    for (int i = 0; i < 100; i++) {
+      if (i % 2 == 0) {
+        vec.push_ok(shared);
+      } else {
+        vec.push_err("error "s + to_string(i) + " past the small buffer");
+      }
+    }
+    EXPECT_EQ(shared.use_count(), 51);
+    EXPECT_EQ(vec[99].unwrap_err().get(), "error 99 past the small buffer");
+
+    ResultVec<shared_ptr<int>, string> moved = move(vec);
+    EXPECT_TRUE(vec.empty());
+    EXPECT_EQ(moved.count_ok(), 50);
+
+    moved.clear();
+    EXPECT_EQ(shared.use_count(), 1);
+    moved.push_ok(shared);
+    EXPECT_EQ(shared.use_count(), 2);
+  }
+  EXPECT_EQ(shared.use_count(), 1);
+}
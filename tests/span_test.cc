@@ -457,3 +457,20 @@ TEST(SpanTest, ConstexprSubspanWithLength) {
     EXPECT_EQ(a.size, 4);
   }
 }
+
+TEST(SpanTest, AuditContract) {
+  int tmp[] = {1, 2, 3, 4};
+  Span<int> a = tmp;
+  Span<int, 4> b = tmp;
+
+  EXPECT_EQ(a.subspan(4).size(), 0);
+  EXPECT_EQ(a.subspan(1, 3).size(), 3);
+
+#if STX_CONTRACT_LEVEL == STX_CONTRACT_LEVEL_AUDIT
+  EXPECT_DEATH_IF_SUPPORTED((void)a[4], ".*");
+  EXPECT_DEATH_IF_SUPPORTED((void)b[4], ".*");
+  EXPECT_DEATH_IF_SUPPORTED((void)a.subspan(5), ".*");
+  EXPECT_DEATH_IF_SUPPORTED((void)a.subspan(2, 3), ".*");
+  EXPECT_DEATH_IF_SUPPORTED((void)b.subspan(1, 4), ".*");
+#endif
+}
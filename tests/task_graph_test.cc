@@ -0,0 +1,203 @@
+/**
+ * @file task_graph_test.cc
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-20
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+
+#include "stx/task_graph.h"
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace stx;
+
+namespace {
+
+enum class Error { Invalid, Timeout };
+
+}  // namespace
+
+TEST(TaskGraphTest, Diamond) {
+  Executor executor{4};
+  TaskGraph<Error> graph;
+
+  auto source = graph.add("source", [] { return Result<int, Error>(Ok(6)); });
+  auto twice = graph.add(
+      "twice", [](int const& x) { return Result<int, Error>(Ok(x * 2)); },
+      source);
+  auto text = graph.add(
+      "text",
+      [](int const& x) { return Result<string, Error>(Ok(to_string(x))); },
+      source);
+  auto sink = graph.add(
+      "sink",
+      [](int const& x, string const& s) {
+        return Result<string, Error>(Ok(s + ":" + to_string(x)));
+      },
+      twice, text);
+  EXPECT_EQ(graph.size(), 4);
+
+  GraphReport const report = graph.run(executor);
+  EXPECT_EQ(report.succeeded, 4);
+  EXPECT_EQ(report.failed, 0);
+  EXPECT_EQ(report.cancelled, 0);
+
+  EXPECT_EQ(graph.status(sink), NodeStatus::Succeeded);
+  EXPECT_EQ(graph.value(twice), 12);
+  EXPECT_EQ(graph.value(sink), "6:12");
+}
+
+TEST(TaskGraphTest, ErrCancelsDescendants) {
+  Executor executor{4};
+  TaskGraph<Error> graph;
+  atomic<int> runs{0};
+
+  auto ok = [&runs](int const& x) {
+    runs++;
+    return Result<int, Error>(Ok(x + 1));
+  };
+
+  auto root = graph.add("root", [] { return Result<int, Error>(Ok(0)); });
+  auto failing = graph.add(
+      "failing",
+      [](int const&) { return Result<int, Error>(Err(Error::Timeout)); },
+      root);
+  auto child = graph.add("child", ok, failing);
+  auto grandchild = graph.add("grandchild", ok, child);
+  auto independent = graph.add("independent", ok, root);
+  auto independent_child = graph.add("independent_child", ok, independent);
+  // depends on both branches
+  auto join = graph.add(
+      "join",
+      [&runs](int const&, int const&) {
+        runs++;
+        return Result<int, Error>(Ok(0));
+      },
+      independent_child, grandchild);
+
+  GraphReport const report = graph.run(executor);
+  EXPECT_EQ(report.succeeded, 3);
+  EXPECT_EQ(report.failed, 1);
+  EXPECT_EQ(report.cancelled, 3);
+
+  EXPECT_EQ(graph.status(failing), NodeStatus::Failed);
+  EXPECT_EQ(graph.err(failing), Error::Timeout);
+  EXPECT_EQ(graph.status(child), NodeStatus::Cancelled);
+  EXPECT_EQ(graph.status(grandchild), NodeStatus::Cancelled);
+  EXPECT_EQ(graph.status(join), NodeStatus::Cancelled);
+  EXPECT_EQ(graph.status(independent_child), NodeStatus::Succeeded);
+  EXPECT_EQ(graph.value(independent_child), 2);
+  // only the independent branch ran
+  EXPECT_EQ(runs.load(), 2);
+}
+
+TEST(TaskGraphTest, DeepChain) {
+  Executor executor{2};
+  TaskGraph<Error> graph;
+
+  auto node = graph.add("first", [] { return Result<int, Error>(Ok(0)); });
+  for (int i = 0; i < 10'000; i++) {
+    node = graph.add(
+        "next", [](int const& x) { return Result<int, Error>(Ok(x + 1)); },
+        node);
+  }
+
+  GraphReport const report = graph.run(executor);
+  EXPECT_EQ(report.succeeded, 10'001);
+  EXPECT_EQ(graph.value(node), 10'000);
+}
+
+TEST(TaskGraphTest, DeepCancellation) {
+  Executor executor{2};
+  TaskGraph<Error> graph;
+
+  auto node = graph.add(
+      "first", [] { return Result<int, Error>(Err(Error::Invalid)); });
+  for (int i = 0; i < 10'000; i++) {
+    node = graph.add(
+        "next", [](int const& x) { return Result<int, Error>(Ok(x + 1)); },
+        node);
+  }
+
+  GraphReport const report = graph.run(executor);
+  EXPECT_EQ(report.failed, 1);
+  EXPECT_EQ(report.cancelled, 10'000);
+  EXPECT_EQ(graph.status(node), NodeStatus::Cancelled);
+}
+
+TEST(TaskGraphTest, WideFanOut) {
+  // a small queue, most of the ready nodes run on the thread that made them
+  // ready
+  Executor executor{3, 16};
+  TaskGraph<Error> graph;
+
+  auto root = graph.add("root", [] { return Result<int, Error>(Ok(1)); });
+  vector<GraphNode<int, Error>> leaves;
+  for (int i = 0; i < 5'000; i++) {
+    leaves.push_back(graph.add(
+        "leaf",
+        [i](int const& x) {
+          if (i % 100 == 0) return Result<int, Error>(Err(Error::Invalid));
+          return Result<int, Error>(Ok(x + i));
+        },
+        root));
+  }
+
+  GraphReport const report = graph.run(executor);
+  EXPECT_EQ(report.succeeded, 1 + 5'000 - 50);
+  EXPECT_EQ(report.failed, 50);
+  EXPECT_EQ(report.cancelled, 0);
+  EXPECT_EQ(graph.value(leaves[7]), 8);
+  EXPECT_EQ(graph.err(leaves[200]), Error::Invalid);
+}
+
+TEST(TaskGraphTest, Empty) {
+  Executor executor{1};
+  TaskGraph<Error> graph;
+  GraphReport const report = graph.run(executor);
+  EXPECT_EQ(report.succeeded, 0);
+}
+
+TEST(TaskGraphDeathTest, Misuse) {
+  Executor executor{1};
+  TaskGraph<Error> graph;
+  TaskGraph<Error> other;
+  auto node = graph.add("node", [] { return Result<int, Error>(Ok(1)); });
+  auto foreign = other.add("node", [] { return Result<int, Error>(Ok(1)); });
+
+  EXPECT_DEATH((void)graph.status(foreign), ".*");
+  EXPECT_DEATH((void)graph.value(node), ".*");
+
+  (void)graph.run(executor);
+  EXPECT_DEATH((void)graph.run(executor), ".*");
+  EXPECT_DEATH((void)graph.err(node), ".*");
+}
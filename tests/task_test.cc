@@ -0,0 +1,173 @@
+/**
+ * @file task_test.cc
+ * @author Basit Ayantunde <rlamarrr@gmail.com>
+ * @date 2020-06-20
+ *
+ * @copyright MIT License
+ *
+ * Copyright (c) 2020 Basit Ayantunde
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#include "stx/task.h"
+
+#if STX_HAS_COROUTINES
+
+#include <coroutine>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace string_literals;
+using namespace stx;
+
+namespace {
+
+enum class Error { Negative, Odd };
+
+enum class WideError { Negative, Odd, Other };
+
+struct Widen {
+  WideError error;
+  Widen(Error e) : error{e == Error::Negative ? WideError::Negative
+                                             : WideError::Odd} {}
+  bool operator==(Widen const& cmp) const { return error == cmp.error; }
+};
+
+auto parse(int x) -> Task<string, Error> {
+  if (x < 0) co_return Err(Error::Negative);
+  co_return to_string(x);
+}
+
+auto check_even(int x) -> Result<void, Error> {
+  if (x % 2 != 0) return Err(Error::Odd);
+  return Ok();
+}
+
+auto parse_even(int x) -> Task<string, Widen> {
+  co_await check_even(x);
+  co_return co_await parse(x);
+}
+
+auto destroyed = 0;
+
+struct Tracker {
+  ~Tracker() { destroyed++; }
+};
+
+auto parse_sum(int a, int b) -> Task<int, Widen> {
+  Tracker tracker;
+  string x = co_await parse_even(a);
+  string y = co_await parse_even(b);
+  co_return stoi(x) + stoi(y);
+}
+
+auto depth(int n) -> Task<int, Error> {
+  if (n == 0) co_return Err(Error::Odd);
+  co_return co_await depth(n - 1) + 1;
+}
+
+auto count(int n) -> Task<int, Error> {
+  if (n == 0) co_return 0;
+  co_return co_await count(n - 1) + 1;
+}
+
+// resumed by the test, as an I/O completion would
+struct Event {
+  coroutine_handle<> waiter;
+
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(coroutine_handle<> handle) noexcept { waiter = handle; }
+  int await_resume() const noexcept { return 7; }
+};
+
+auto wait_event(Event& event) -> Task<int, Error> {
+  int x = co_await event;
+  co_return x * 6;
+}
+
+auto parent_of_event(Event& event) -> Task<int, Error> {
+  co_return co_await wait_event(event) + 0;
+}
+
+}  // namespace
+
+TEST(TaskTest, Run) {
+  EXPECT_EQ(parse(12).run(), Ok("12"s));
+  EXPECT_EQ(parse(-1).run(), Err(Error::Negative));
+
+  Task<string, Error> task = parse(5);
+  EXPECT_FALSE(task.is_done());
+  task.start();
+  EXPECT_TRUE(task.is_done());
+  EXPECT_EQ(std::move(task).result(), Ok("5"s));
+}
+
+TEST(TaskTest, PropagatesErr) {
+  EXPECT_EQ(parse_sum(2, 4).run(), Ok(6));
+
+  destroyed = 0;
+  EXPECT_EQ(parse_sum(2, 3).run(), Err(Widen{Error::Odd}));
+  EXPECT_EQ(destroyed, 1);
+
+  EXPECT_EQ(parse_sum(-2, 4).run(), Err(Widen{Error::Negative}));
+  EXPECT_EQ(destroyed, 2);
+}
+
+TEST(TaskTest, LongChains) {
+  EXPECT_EQ(count(2'000).run(), Ok(2'000));
+  EXPECT_EQ(depth(2'000).run(), Err(Error::Odd));
+}
+
+TEST(TaskTest, ExternalAwaitable) {
+  Event event;
+  Task<int, Error> task = parent_of_event(event);
+  task.start();
+  EXPECT_FALSE(task.is_done());
+  ASSERT_TRUE(event.waiter);
+
+  event.waiter.resume();
+  EXPECT_TRUE(task.is_done());
+  EXPECT_EQ(std::move(task).result(), Ok(42));
+
+  Event never;
+  EXPECT_DEATH_IF_SUPPORTED((void)wait_event(never).run(), ".*");
+}
+
+TEST(TaskTest, FramePool) {
+  EXPECT_EQ(internal::coroutine::pool_class(1), 0);
+  EXPECT_EQ(internal::coroutine::pool_class(64), 0);
+  EXPECT_EQ(internal::coroutine::pool_class(65), 1);
+  EXPECT_EQ(internal::coroutine::pool_class(4096), 6);
+  EXPECT_EQ(internal::coroutine::pool_class(4097), 7);
+
+  // released frames are reused by the next allocations of the same size class
+  void* frame = pool_coroutine_frame_allocator.allocate(100);
+  pool_coroutine_frame_allocator.deallocate(frame, 100);
+  EXPECT_EQ(pool_coroutine_frame_allocator.allocate(120), frame);
+  pool_coroutine_frame_allocator.deallocate(frame, 120);
+}
+
+#endif